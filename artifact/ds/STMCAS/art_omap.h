@@ -0,0 +1,607 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <x86intrin.h>
+
+/// An ordered map for integer keys, implemented as an adaptive radix tree
+/// (Leis et al., ICDE 2013).  This map supports get(), insert(), and remove()
+/// operations.
+///
+/// Each inner node consumes one byte of the key, most significant byte first,
+/// so the depth of the tree is bounded by sizeof(K), no matter how many
+/// elements it holds.  Inner nodes come in four sizes (4, 16, 48, and 256
+/// children), and a node is replaced by the next size up when it is full, or
+/// by the next size down when it gets sparse.  As in the paper, a leaf is
+/// stored at the shallowest depth where its key is unique ("lazy expansion"),
+/// and is pushed down when another key with the same prefix is inserted.
+/// There is no path compression.  The root is a 256-child node that never
+/// changes size.
+///
+/// Every inner node has its own orec.  Leaves are immutable, so their orecs
+/// are never used.  Searches are RSTEPs, which validate each node after
+/// reading it, and record a snapshot of each level's node, so that a search
+/// that fails validation can resume from the deepest level that is still
+/// unchanged.  An insert or remove is a WSTEP that acquires only the node that
+/// holds the key's slot, unless the node must grow or shrink, in which case
+/// the step also acquires the node's parent, and swaps the parent's pointer to
+/// a new node.
+///
+/// NB: The keys of 4- and 16-child nodes are not kept sorted.  Node16 keys are
+///     packed into two words, and are searched with SSE2.
+///
+/// @param K      The type of the keys stored in this map (must be integral)
+/// @param V      The type of the values stored in this map
+/// @param STMCAS The STMCAS implementation (PO or PS)
+template <typename K, typename V, class STMCAS> class art_omap {
+  using WSTEP = typename STMCAS::WSTEP;
+  using RSTEP = typename STMCAS::RSTEP;
+  using STEP = typename STMCAS::STEP;
+  using snapshot_t = typename STMCAS::snapshot_t;
+  using ownable_t = typename STMCAS::ownable_t;
+  template <typename T> using FIELD = typename STMCAS::template sField<T>;
+
+  static_assert(std::is_integral_v<K>, "art_omap requires integer keys");
+
+  /// The number of bytes in a key, which is the most inner nodes on a path
+  static const int DEPTH = sizeof(K);
+
+  /// The kinds of objects in the tree
+  enum type_t : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+  /// The most children each kind of inner node can have
+  static constexpr int CAPACITY[] = {0, 4, 16, 48, 256};
+
+  /// An inner node is replaced by the next smaller kind when it has no more
+  /// than this many children.  (A NODE4 is replaced when it has one child, if
+  /// that child is a leaf.)
+  static constexpr int SHRINK_AT[] = {0, 0, 3, 12, 37};
+
+  /// The parts common to leaves and inner nodes
+  struct item_t : ownable_t {
+    const type_t type; // The kind of object
+
+    /// Construct an item
+    ///
+    /// @param type The kind of object
+    item_t(type_t type) : ownable_t(), type(type) {}
+
+    /// Destructor is a no-op, but it needs to be virtual because of inheritance
+    virtual ~item_t() {}
+  };
+
+  /// A leaf, which holds one key/value pair.  Leaves never change.
+  struct leaf_t : item_t {
+    const K key; // The key
+    const V val; // The value
+
+    /// Construct a leaf
+    ///
+    /// @param key The key
+    /// @param val The value
+    leaf_t(const K &key, const V &val) : item_t(LEAF), key(key), val(val) {}
+  };
+
+  /// The parts common to all inner nodes
+  struct inner_t : item_t {
+    const int depth;  // The index of the key byte that this node consumes
+    FIELD<int> count; // The number of children
+
+    /// Construct an empty inner node
+    ///
+    /// @param type  The kind of node
+    /// @param depth The index of the key byte that this node consumes
+    inner_t(type_t type, int depth) : item_t(type), depth(depth), count(0) {}
+  };
+
+  /// An inner node with up to 4 children.  children[i] is for byte keys[i].
+  struct node4_t : inner_t {
+    FIELD<uint8_t> keys[4];      // The key bytes
+    FIELD<item_t *> children[4]; // The children
+
+    /// Construct an empty node
+    ///
+    /// @param depth The index of the key byte that this node consumes
+    node4_t(int depth) : inner_t(NODE4, depth) {}
+  };
+
+  /// An inner node with up to 16 children.  children[i] is for the ith byte of
+  /// `keys`, where byte i is in keys[i / 8], at bit 8 * (i % 8).
+  struct node16_t : inner_t {
+    FIELD<uint64_t> keys[2];      // The key bytes
+    FIELD<item_t *> children[16]; // The children
+
+    /// Construct an empty node
+    ///
+    /// @param depth The index of the key byte that this node consumes
+    node16_t(int depth) : inner_t(NODE16, depth) {}
+  };
+
+  /// An inner node with up to 48 children.  index[b] is 0 if there is no
+  /// child for byte b, or one more than the child's position in `children`.
+  struct node48_t : inner_t {
+    FIELD<uint8_t> index[256];    // Positions of the children, plus one
+    FIELD<item_t *> children[48]; // The children
+
+    /// Construct an empty node
+    ///
+    /// @param depth The index of the key byte that this node consumes
+    node48_t(int depth) : inner_t(NODE48, depth) {}
+  };
+
+  /// An inner node with a slot for every byte
+  struct node256_t : inner_t {
+    FIELD<item_t *> children[256]; // The children
+
+    /// Construct an empty node
+    ///
+    /// @param depth The index of the key byte that this node consumes
+    node256_t(int depth) : inner_t(NODE256, depth) {}
+  };
+
+  node256_t *const root; // The root, which never changes
+
+public:
+  /// Construct an empty tree
+  ///
+  /// @param me  The operation that is constructing the tree (unused)
+  /// @param cfg A configuration object (unused)
+  art_omap(STMCAS *, auto *) : root(new node256_t(0)) {}
+
+private:
+  /// Extract one byte of a key
+  ///
+  /// @param key   The key
+  /// @param depth The index of the byte, where 0 is the most significant
+  ///
+  /// @return The byte
+  static uint8_t byte_of(const K &key, int depth) {
+    auto bits = static_cast<std::make_unsigned_t<K>>(key);
+    return (bits >> (8 * (DEPTH - 1 - depth))) & 0xFF;
+  }
+
+  /// Read an inner node's child count, without trusting it to be consistent
+  ///
+  /// @param tx The enclosing step
+  /// @param n  The node
+  ///
+  /// @return The count, clamped to the node's capacity
+  static int count_of(STEP &tx, inner_t *n) {
+    return std::clamp(n->count.get(tx), 0, CAPACITY[n->type]);
+  }
+
+  /// Find the position of a byte in a NODE4 or NODE16
+  ///
+  /// @param tx The enclosing step
+  /// @param n  The node
+  /// @param b  The byte
+  ///
+  /// @return The position, or -1 if `b` is not in the node
+  static int position_of(STEP &tx, inner_t *n, uint8_t b) {
+    int count = count_of(tx, n);
+    if (n->type == NODE4) {
+      auto n4 = static_cast<node4_t *>(n);
+      for (int i = 0; i < count; ++i)
+        if (n4->keys[i].get(tx) == b)
+          return i;
+      return -1;
+    }
+    auto n16 = static_cast<node16_t *>(n);
+    __m128i keys = _mm_set_epi64x(n16->keys[1].get(tx), n16->keys[0].get(tx));
+    __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(b), keys);
+    int mask = _mm_movemask_epi8(cmp) & ((1 << count) - 1);
+    return mask ? __builtin_ctz(mask) : -1;
+  }
+
+  /// Get the child slot of an inner node for a byte
+  ///
+  /// @param tx The enclosing step
+  /// @param n  The node
+  /// @param b  The byte
+  ///
+  /// @return The slot, or null if there is no child for `b`.  For a NODE256,
+  ///         the slot is returned even if it is empty.
+  static FIELD<item_t *> *slot_of(STEP &tx, inner_t *n, uint8_t b) {
+    switch (n->type) {
+    case NODE4: {
+      int i = position_of(tx, n, b);
+      return i < 0 ? nullptr : &static_cast<node4_t *>(n)->children[i];
+    }
+    case NODE16: {
+      int i = position_of(tx, n, b);
+      return i < 0 ? nullptr : &static_cast<node16_t *>(n)->children[i];
+    }
+    case NODE48: {
+      auto n48 = static_cast<node48_t *>(n);
+      int i = n48->index[b].get(tx);
+      return (i == 0 || i > 48) ? nullptr : &n48->children[i - 1];
+    }
+    default:
+      return &static_cast<node256_t *>(n)->children[b];
+    }
+  }
+
+  /// Get the child of an inner node for a byte
+  ///
+  /// @param tx The enclosing step
+  /// @param n  The node
+  /// @param b  The byte
+  ///
+  /// @return The child, or null if there is none
+  static item_t *child_of(STEP &tx, inner_t *n, uint8_t b) {
+    auto slot = slot_of(tx, n, b);
+    return slot ? slot->get(tx) : nullptr;
+  }
+
+  /// Add a child to a NODE4 that is not full, and has no child for `b`
+  ///
+  /// @param tx    The enclosing step, which owns `n` (or `n` is not shared)
+  /// @param n     The node
+  /// @param b     The byte
+  /// @param child The new child
+  static void add(WSTEP &tx, node4_t *n, uint8_t b, item_t *child) {
+    int count = n->count.get(tx);
+    n->keys[count].set(b, tx);
+    n->children[count].set(child, tx);
+    n->count.set(count + 1, tx);
+  }
+
+  /// Add a child to a NODE16 that is not full, and has no child for `b`
+  ///
+  /// @param tx    The enclosing step, which owns `n` (or `n` is not shared)
+  /// @param n     The node
+  /// @param b     The byte
+  /// @param child The new child
+  static void add(WSTEP &tx, node16_t *n, uint8_t b, item_t *child) {
+    int count = n->count.get(tx);
+    int shift = 8 * (count % 8);
+    uint64_t word = n->keys[count / 8].get(tx);
+    word = (word & ~(0xFFULL << shift)) | ((uint64_t)b << shift);
+    n->keys[count / 8].set(word, tx);
+    n->children[count].set(child, tx);
+    n->count.set(count + 1, tx);
+  }
+
+  /// Add a child to a NODE48 that is not full, and has no child for `b`
+  ///
+  /// @param tx    The enclosing step, which owns `n` (or `n` is not shared)
+  /// @param n     The node
+  /// @param b     The byte
+  /// @param child The new child
+  static void add(WSTEP &tx, node48_t *n, uint8_t b, item_t *child) {
+    int i = 0;
+    while (n->children[i].get(tx) != nullptr)
+      ++i;
+    n->children[i].set(child, tx);
+    n->index[b].set(i + 1, tx);
+    n->count.set(n->count.get(tx) + 1, tx);
+  }
+
+  /// Add a child to a NODE256 that has no child for `b`
+  ///
+  /// @param tx    The enclosing step, which owns `n` (or `n` is not shared)
+  /// @param n     The node
+  /// @param b     The byte
+  /// @param child The new child
+  static void add(WSTEP &tx, node256_t *n, uint8_t b, item_t *child) {
+    n->children[b].set(child, tx);
+    n->count.set(n->count.get(tx) + 1, tx);
+  }
+
+  /// Add a child to an inner node of any kind that is not full, and has no
+  /// child for `b`
+  ///
+  /// @param tx    The enclosing step, which owns `n`
+  /// @param n     The node
+  /// @param b     The byte
+  /// @param child The new child
+  static void add_child(WSTEP &tx, inner_t *n, uint8_t b, item_t *child) {
+    switch (n->type) {
+    case NODE4:
+      return add(tx, static_cast<node4_t *>(n), b, child);
+    case NODE16:
+      return add(tx, static_cast<node16_t *>(n), b, child);
+    case NODE48:
+      return add(tx, static_cast<node48_t *>(n), b, child);
+    default:
+      return add(tx, static_cast<node256_t *>(n), b, child);
+    }
+  }
+
+  /// Remove the child of an inner node for byte `b`, which must exist
+  ///
+  /// @param tx The enclosing step, which owns `n`
+  /// @param n  The node
+  /// @param b  The byte
+  static void remove_child(WSTEP &tx, inner_t *n, uint8_t b) {
+    int count = n->count.get(tx);
+    switch (n->type) {
+    case NODE4: {
+      // Move the last child into the hole
+      auto n4 = static_cast<node4_t *>(n);
+      int i = position_of(tx, n, b);
+      n4->keys[i].set(n4->keys[count - 1].get(tx), tx);
+      n4->children[i].set(n4->children[count - 1].get(tx), tx);
+      break;
+    }
+    case NODE16: {
+      auto n16 = static_cast<node16_t *>(n);
+      int i = position_of(tx, n, b);
+      int last = count - 1;
+      uint8_t lb = n16->keys[last / 8].get(tx) >> (8 * (last % 8));
+      int shift = 8 * (i % 8);
+      uint64_t word = n16->keys[i / 8].get(tx);
+      word = (word & ~(0xFFULL << shift)) | ((uint64_t)lb << shift);
+      n16->keys[i / 8].set(word, tx);
+      n16->children[i].set(n16->children[count - 1].get(tx), tx);
+      break;
+    }
+    case NODE48: {
+      auto n48 = static_cast<node48_t *>(n);
+      n48->children[n48->index[b].get(tx) - 1].set(nullptr, tx);
+      n48->index[b].set(0, tx);
+      break;
+    }
+    default:
+      static_cast<node256_t *>(n)->children[b].set(nullptr, tx);
+    }
+    n->count.set(count - 1, tx);
+  }
+
+  /// Make a new, unshared inner node that has the children of `n`
+  ///
+  /// @param tx   The enclosing step, which owns `n`
+  /// @param n    The node to copy
+  /// @param type The kind of node to make
+  /// @param skip A byte whose child should not be copied, or -1
+  ///
+  /// @return The new node
+  static inner_t *copy(WSTEP &tx, inner_t *n, type_t type, int skip = -1) {
+    switch (type) {
+    case NODE4:
+      return fill(tx, new node4_t(n->depth), n, skip);
+    case NODE16:
+      return fill(tx, new node16_t(n->depth), n, skip);
+    case NODE48:
+      return fill(tx, new node48_t(n->depth), n, skip);
+    default:
+      return fill(tx, new node256_t(n->depth), n, skip);
+    }
+  }
+
+  /// Add the children of `n` to a new, unshared node
+  ///
+  /// @param tx   The enclosing step, which owns `n`
+  /// @param res  The new node
+  /// @param n    The node to copy
+  /// @param skip A byte whose child should not be copied, or -1
+  ///
+  /// @return `res`
+  template <class NODE>
+  static inner_t *fill(WSTEP &tx, NODE *res, inner_t *n, int skip) {
+    for (int b = 0; b < 256; ++b)
+      if (auto child = child_of(tx, n, b); child && b != skip)
+        add(tx, res, b, child);
+    return res;
+  }
+
+  /// Make a chain of new, unshared NODE4s that hold two leaves whose keys
+  /// have the same bytes before `depth`
+  ///
+  /// @param tx    The enclosing step
+  /// @param a     One leaf
+  /// @param b     The other leaf
+  /// @param depth The depth of the first node in the chain
+  ///
+  /// @return The first node in the chain
+  static inner_t *expand(WSTEP &tx, leaf_t *a, leaf_t *b, int depth) {
+    node4_t *top = new node4_t(depth);
+    node4_t *curr = top;
+    while (byte_of(a->key, curr->depth) == byte_of(b->key, curr->depth)) {
+      node4_t *next = new node4_t(curr->depth + 1);
+      add(tx, curr, byte_of(a->key, curr->depth), next);
+      curr = next;
+    }
+    add(tx, curr, byte_of(a->key, curr->depth), a);
+    add(tx, curr, byte_of(b->key, curr->depth), b);
+    return top;
+  }
+
+  /// Find the deepest inner node on the path for `key`.  Its child for `key`
+  /// is either null or a leaf.  The path to it is left in `me->snapshots`:
+  /// one node per level, with the returned node on top.
+  ///
+  /// There is no atomicity between find and its caller.  The caller needs to
+  /// validate the returned node's version before using it.  If validation
+  /// fails, calling find again resumes the search from the deepest snapshot
+  /// that is still valid.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to find
+  ///
+  /// @return The node that was found, and its orec value
+  snapshot_t find(STMCAS *me, const K &key) {
+    while (true) {
+      RSTEP tx(me);
+
+      // Start from the deepest snapshot, or from the root
+      bool resumed = !me->snapshots.empty();
+      inner_t *curr =
+          resumed ? static_cast<inner_t *>(me->snapshots.top()._obj) : root;
+      while (true) {
+        item_t *child = child_of(tx, curr, byte_of(key, curr->depth));
+
+        // Validate what we read.  A snapshot only needs to be unchanged.
+        if (resumed) {
+          if (!tx.check_continuation(curr, me->snapshots.top()._ver)) {
+            me->snapshots.drop();
+            break;
+          }
+          resumed = false;
+        } else {
+          uint64_t ver = tx.check_orec(curr);
+          if (ver == STMCAS::END_OF_TIME)
+            break;
+          me->snapshots.push_back({curr, ver});
+        }
+        if (!child || child->type == LEAF)
+          return me->snapshots.top();
+        curr = static_cast<inner_t *>(child);
+      }
+    }
+  }
+
+public:
+  /// Search the data structure for a node with key `key`.  If not found, return
+  /// false.  If found, return true, and set `val` to the value associated with
+  /// `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(STMCAS *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key);
+      inner_t *n = static_cast<inner_t *>(s._obj);
+
+      // Read the slot, and then make sure the node did not change since find()
+      // NB: Leaves are immutable, so the leaf needs no validation
+      RSTEP tx(me);
+      item_t *child = child_of(tx, n, byte_of(key, n->depth));
+      if (!tx.check_continuation(n, s._ver))
+        continue;
+      auto leaf = static_cast<leaf_t *>(child);
+      if (!leaf || leaf->key != key)
+        return false;
+      val = leaf->val;
+      return true;
+    }
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(STMCAS *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key);
+      inner_t *n = static_cast<inner_t *>(s._obj);
+      uint8_t b = byte_of(key, n->depth);
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(n, s._ver)) {
+        tx.unwind();
+        continue;
+      }
+
+      // If the slot has a leaf, push both leaves down into new nodes
+      auto slot = slot_of(tx, n, b);
+      if (slot && slot->get(tx)) {
+        auto leaf = static_cast<leaf_t *>(slot->get(tx));
+        if (leaf->key == key) {
+          tx.unwind();
+          return false;
+        }
+        slot->set(expand(tx, leaf, new leaf_t(key, val), n->depth + 1), tx);
+        return true;
+      }
+
+      // Add to the node, if it has room
+      if (n->count.get(tx) < CAPACITY[n->type]) {
+        add_child(tx, n, b, new leaf_t(key, val));
+        return true;
+      }
+
+      // Otherwise replace it with a bigger node.  The root never fills, so
+      // `n` has a parent, which must not have changed since find().
+      auto &ps = me->snapshots.begin()[me->snapshots.size() - 2];
+      inner_t *p = static_cast<inner_t *>(ps._obj);
+      if (!tx.acquire_continuation(p, ps._ver)) {
+        tx.unwind();
+        continue;
+      }
+      inner_t *big = copy(tx, n, (type_t)(n->type + 1));
+      add_child(tx, big, b, new leaf_t(key, val));
+      slot_of(tx, p, byte_of(key, p->depth))->set(big, tx);
+      tx.reclaim(n);
+      return true;
+    }
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(STMCAS *me, const K &key) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key);
+      inner_t *n = static_cast<inner_t *>(s._obj);
+      uint8_t b = byte_of(key, n->depth);
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(n, s._ver)) {
+        tx.unwind();
+        continue;
+      }
+      auto leaf = static_cast<leaf_t *>(child_of(tx, n, b));
+      if (!leaf || leaf->key != key) {
+        tx.unwind();
+        return false;
+      }
+
+      // Decide if `n` should be replaced by a smaller node, by its only other
+      // child (if that is a leaf), or by nothing.  The root is never replaced.
+      int count = n->count.get(tx) - 1;
+      bool replace = false;
+      item_t *repl = nullptr;
+      if (n->type == NODE4) {
+        auto n4 = static_cast<node4_t *>(n);
+        if (count == 1) {
+          repl = n4->children[n4->keys[0].get(tx) == b ? 1 : 0].get(tx);
+          replace = repl->type == LEAF;
+        } else {
+          replace = count == 0;
+        }
+      } else if (n != root) {
+        replace = count <= SHRINK_AT[n->type];
+      }
+      if (!replace) {
+        remove_child(tx, n, b);
+        tx.reclaim(leaf);
+        return true;
+      }
+
+      // Swap the parent's pointer, if the parent did not change since find().
+      // NB: STMCAS writes in place, so nothing can be written until all orecs
+      //     are acquired.
+      auto &ps = me->snapshots.begin()[me->snapshots.size() - 2];
+      inner_t *p = static_cast<inner_t *>(ps._obj);
+      if (!tx.acquire_continuation(p, ps._ver)) {
+        tx.unwind();
+        continue;
+      }
+      uint8_t pb = byte_of(key, p->depth);
+      if (n->type != NODE4)
+        repl = copy(tx, n, (type_t)(n->type - 1), b);
+      if (repl)
+        slot_of(tx, p, pb)->set(repl, tx);
+      else
+        remove_child(tx, p, pb);
+      tx.reclaim(leaf);
+      tx.reclaim(n);
+      return true;
+    }
+  }
+};
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <algorithm>
+
+/// An ordered map, implemented as a B+-tree in the style of Lehman and Yao's
+/// B-link tree.  This map supports get(), insert(), and remove() operations.
+///
+/// Every node has one orec, a high key, and a pointer to its right sibling at
+/// the same level.  A node holds the keys in [low, high), where `low` is the
+/// high key of its left sibling, and the rightmost node at each level has no
+/// high key.  When a search reaches a node whose high key is <= the key it is
+/// looking for, it moves right.  That lets a split happen in two small
+/// WSTEPs: the first acquires only the full node, and moves its upper half to
+/// a new right sibling; the second acquires only the parent, and adds the new
+/// sibling to it.  Between the two steps, the new node is reachable through
+/// its left sibling's right pointer.
+///
+/// Searches descend in RSTEPs, and record a snapshot of each level's node, so
+/// that a search that fails validation can resume from the deepest level that
+/// is still unchanged, instead of from the root.
+///
+/// A node that drops below a quarter full is merged into its left sibling (or
+/// its right sibling into it), by a WSTEP that acquires the parent and the two
+/// siblings.  Merges are opportunistic: if any of the nodes changed, or the
+/// siblings would not fit in three quarters of a node, the merge is skipped,
+/// since an underfull node is still a valid node.  When the root is an
+/// internal node with only one child, the child becomes the root.
+///
+/// NB: Keys and values are stored in sFields, so K and V must be trivially
+///     copyable, and K must be default constructable.
+///
+/// @param K      The type of the keys stored in this map
+/// @param V      The type of the values stored in this map
+/// @param STMCAS The STMCAS implementation (PO or PS)
+/// @param B      The most keys that a node can hold
+template <typename K, typename V, class STMCAS, int B> class bplustree_omap {
+  using WSTEP = typename STMCAS::WSTEP;
+  using RSTEP = typename STMCAS::RSTEP;
+  using STEP = typename STMCAS::STEP;
+  using snapshot_t = typename STMCAS::snapshot_t;
+  using ownable_t = typename STMCAS::ownable_t;
+  template <typename T> using FIELD = typename STMCAS::template sField<T>;
+
+  static_assert(B >= 4, "B+-tree nodes must hold at least four keys");
+
+  /// A node is merged with a sibling when it has fewer keys than this
+  static const int MIN_KEYS = B / 4;
+
+  /// The most keys that a node can have as the result of a merge
+  static const int MAX_MERGED = 3 * B / 4;
+
+  /// The parts common to leaves and internal nodes
+  struct node_t : ownable_t {
+    const int level;       // The node's distance from the leaves
+    FIELD<int> count;      // The number of keys in the node
+    FIELD<K> high;         // All keys in this node are < high (if `right`)
+    FIELD<node_t *> right; // The right sibling, or null if rightmost
+    FIELD<K> keys[B];      // The keys, in sorted order
+
+    /// Construct an empty node
+    ///
+    /// @param level The node's distance from the leaves
+    node_t(int level)
+        : ownable_t(), level(level), count(0), high(), right(nullptr) {}
+
+    /// Destructor is a no-op, but it needs to be virtual because of inheritance
+    virtual ~node_t() {}
+  };
+
+  /// A leaf.  vals[i] is the value associated with keys[i].
+  struct leaf_t : node_t {
+    FIELD<V> vals[B]; // The values
+
+    /// Construct an empty leaf
+    leaf_t() : node_t(0) {}
+  };
+
+  /// An internal node.  children[i] holds the keys in [keys[i-1], keys[i]).
+  struct inner_t : node_t {
+    FIELD<node_t *> children[B + 1]; // The children
+
+    /// Construct an empty internal node
+    ///
+    /// @param level The node's distance from the leaves
+    inner_t(int level) : node_t(level) {}
+  };
+
+  /// The object that points to the root.  It has its own orec, so that the
+  /// tree can grow and shrink in height.
+  struct anchor_t : ownable_t {
+    FIELD<node_t *> root; // The root node
+
+    /// Construct an anchor with no root
+    anchor_t() : ownable_t(), root(nullptr) {}
+  };
+
+  /// The ways that a search can leave a node
+  enum move_t { STAY, RIGHT, DOWN };
+
+  anchor_t anchor; // The pointer to the root
+
+public:
+  /// Construct an empty tree, whose root is an empty leaf
+  ///
+  /// @param me  The operation that is constructing the tree
+  /// @param cfg A configuration object (unused)
+  bplustree_omap(STMCAS *me, auto *) {
+    // NB: As in the lists, we need a WSTEP to set fields, but nothing is
+    //     shared yet, so there is no need to acquire orecs.
+    WSTEP tx(me);
+    anchor.root.set(new leaf_t(), tx);
+  }
+
+private:
+  /// Read a node's key count, without trusting it to be consistent
+  ///
+  /// @param tx The enclosing step
+  /// @param n  The node
+  ///
+  /// @return The count, clamped to [0, B]
+  static int count_of(STEP &tx, node_t *n) {
+    return std::clamp(n->count.get(tx), 0, B);
+  }
+
+  /// Find the position of the first key in a node that is >= `key`
+  ///
+  /// @param tx    The enclosing step
+  /// @param n     The node to search
+  /// @param count The number of keys in `n`
+  /// @param key   The key to look for
+  ///
+  /// @return The position, which is `count` if all keys are < `key`
+  static int lower_bound(STEP &tx, node_t *n, int count, const K &key) {
+    int i = 0;
+    while (i < count && n->keys[i].get(tx) < key)
+      ++i;
+    return i;
+  }
+
+  /// Find the position of the child of an internal node that holds `key`
+  ///
+  /// @param tx    The enclosing step
+  /// @param n     The node to search
+  /// @param count The number of keys in `n`
+  /// @param key   The key to look for
+  ///
+  /// @return The position of the child
+  static int child_of(STEP &tx, node_t *n, int count, const K &key) {
+    int i = 0;
+    while (i < count && !(key < n->keys[i].get(tx)))
+      ++i;
+    return i;
+  }
+
+  /// Read the fields of an object on a search path, to decide where a search
+  /// for `key` should go next.  Nothing is validated: the caller must validate
+  /// `obj` before following `next`.
+  ///
+  /// @param tx    The enclosing step
+  /// @param obj   The anchor or a node
+  /// @param key   The key being searched for
+  /// @param level The level where the search ends
+  /// @param next  A ref param for returning the next object to visit
+  ///
+  /// @return STAY if the search ends at `obj`, otherwise how to reach `next`
+  move_t route(RSTEP &tx, ownable_t *obj, const K &key, int level,
+               ownable_t *&next) {
+    if (obj == &anchor) {
+      node_t *root = anchor.root.get(tx);
+      next = root;
+      return (root->level < level) ? STAY : DOWN;
+    }
+    node_t *n = static_cast<node_t *>(obj);
+    node_t *r = n->right.get(tx);
+    if (r && !(key < n->high.get(tx))) {
+      next = r;
+      return RIGHT;
+    }
+    if (n->level <= level)
+      return STAY;
+    int i = child_of(tx, n, count_of(tx, n), key);
+    next = static_cast<inner_t *>(n)->children[i].get(tx);
+    return DOWN;
+  }
+
+  /// Find the node at `level` whose range includes `key`.  The path to it is
+  /// left in `me->snapshots`: the anchor, then one node per level, with the
+  /// returned node on top.  If the tree is too short to have a node at
+  /// `level`, then the anchor is returned.
+  ///
+  /// There is no atomicity between find and its caller.  The caller needs to
+  /// validate the returned object's version before using it.  If validation
+  /// fails, calling find again resumes the search from the deepest snapshot
+  /// that is still valid.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param key   The key to find
+  /// @param level The level of the node to find
+  ///
+  /// @return The object that was found, and its orec value
+  snapshot_t find(STMCAS *me, const K &key, int level) {
+    while (true) {
+      RSTEP tx(me);
+
+      // Start from the deepest snapshot, or from the anchor
+      bool resumed = !me->snapshots.empty();
+      ownable_t *curr = resumed ? me->snapshots.top()._obj : &anchor;
+      bool sideways = false;
+      while (true) {
+        ownable_t *next = nullptr;
+        move_t m = route(tx, curr, key, level, next);
+
+        // Validate what route() read.  A snapshot only needs to be unchanged.
+        // A new node gets a snapshot, which replaces its left sibling's.
+        if (resumed) {
+          if (!tx.check_continuation(curr, me->snapshots.top()._ver)) {
+            me->snapshots.drop();
+            break;
+          }
+          resumed = false;
+        } else {
+          uint64_t ver = tx.check_orec(curr);
+          if (ver == STMCAS::END_OF_TIME)
+            break;
+          if (sideways)
+            me->snapshots.drop();
+          me->snapshots.push_back({curr, ver});
+        }
+        if (m == STAY)
+          return me->snapshots.top();
+        sideways = m == RIGHT;
+        curr = next;
+      }
+    }
+  }
+
+public:
+  /// Search the data structure for a node with key `key`.  If not found, return
+  /// false.  If found, return true, and set `val` to the value associated with
+  /// `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(STMCAS *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key, 0);
+      leaf_t *leaf = static_cast<leaf_t *>(s._obj);
+
+      // Read the leaf, and then make sure it did not change since find()
+      RSTEP tx(me);
+      int count = count_of(tx, leaf);
+      int i = lower_bound(tx, leaf, count, key);
+      bool found = i < count && leaf->keys[i].get(tx) == key;
+      V v = found ? leaf->vals[i].get(tx) : V();
+      if (!tx.check_continuation(leaf, s._ver))
+        continue;
+      if (found)
+        val = v;
+      return found;
+    }
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(STMCAS *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key, 0);
+      leaf_t *leaf = static_cast<leaf_t *>(s._obj);
+      leaf_t *sib = nullptr;
+      K sep = K();
+      {
+        WSTEP tx(me);
+        if (!tx.acquire_continuation(leaf, s._ver)) {
+          tx.unwind();
+          continue;
+        }
+        int count = leaf->count.get(tx);
+        int i = lower_bound(tx, leaf, count, key);
+        if (i < count && leaf->keys[i].get(tx) == key) {
+          tx.unwind();
+          return false;
+        }
+
+        // If the leaf is full, move its upper half to a new right sibling
+        leaf_t *dest = leaf;
+        if (count == B) {
+          int half = B / 2;
+          sib = new leaf_t();
+          for (int j = half; j < B; ++j) {
+            sib->keys[j - half].set(leaf->keys[j].get(tx), tx);
+            sib->vals[j - half].set(leaf->vals[j].get(tx), tx);
+          }
+          sib->count.set(B - half, tx);
+          sib->high.set(leaf->high.get(tx), tx);
+          sib->right.set(leaf->right.get(tx), tx);
+          sep = sib->keys[0].get(tx);
+          leaf->count.set(half, tx);
+          leaf->high.set(sep, tx);
+          leaf->right.set(sib, tx);
+          if (i > half) {
+            dest = sib;
+            i -= half;
+          }
+          count = dest->count.get(tx);
+        }
+
+        // Insert into `dest`, at position i
+        for (int j = count; j > i; --j) {
+          dest->keys[j].set(dest->keys[j - 1].get(tx), tx);
+          dest->vals[j].set(dest->vals[j - 1].get(tx), tx);
+        }
+        dest->keys[i].set(key, tx);
+        dest->vals[i].set(val, tx);
+        dest->count.set(count + 1, tx);
+      }
+      if (sib)
+        insert_parent(me, 1, sep, sib);
+      return true;
+    }
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(STMCAS *me, const K &key) {
+    me->snapshots.clear();
+    while (true) {
+      auto s = find(me, key, 0);
+      leaf_t *leaf = static_cast<leaf_t *>(s._obj);
+      int count;
+      {
+        WSTEP tx(me);
+        if (!tx.acquire_continuation(leaf, s._ver)) {
+          tx.unwind();
+          continue;
+        }
+        count = leaf->count.get(tx);
+        int i = lower_bound(tx, leaf, count, key);
+        if (i == count || leaf->keys[i].get(tx) != key) {
+          tx.unwind();
+          return false;
+        }
+        for (int j = i + 1; j < count; ++j) {
+          leaf->keys[j - 1].set(leaf->keys[j].get(tx), tx);
+          leaf->vals[j - 1].set(leaf->vals[j].get(tx), tx);
+        }
+        leaf->count.set(--count, tx);
+      }
+      if (count < MIN_KEYS)
+        merge(me);
+      return true;
+    }
+  }
+
+private:
+  /// Add a new node, which was split from its left sibling, to the parent
+  /// level.  If the parent is full, it splits too, and so on up the tree.  If
+  /// the split node was the root, the tree gets a new root.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param level The level of the parent
+  /// @param sep   The smallest key that `sib` can hold
+  /// @param sib   The new node
+  void insert_parent(STMCAS *me, int level, K sep, node_t *sib) {
+    while (sib) {
+      // NB: The snapshots are for a different key, so start from the root
+      me->snapshots.clear();
+      auto s = find(me, sep, level);
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(s._obj, s._ver)) {
+        tx.unwind();
+        continue;
+      }
+
+      // If the split node was the root, grow the tree.  The root is always the
+      // leftmost node at its level, so `sib` is in its right chain.
+      if (s._obj == &anchor) {
+        inner_t *root = new inner_t(level);
+        root->keys[0].set(sep, tx);
+        root->children[0].set(anchor.root.get(tx), tx);
+        root->children[1].set(sib, tx);
+        root->count.set(1, tx);
+        anchor.root.set(root, tx);
+        return;
+      }
+
+      // Gather the parent's keys and children, with `sep` and `sib` added
+      inner_t *p = static_cast<inner_t *>(s._obj);
+      int count = p->count.get(tx);
+      int i = lower_bound(tx, p, count, sep);
+      K keys[B + 1];
+      node_t *kids[B + 2];
+      for (int j = 0; j < count; ++j)
+        keys[j < i ? j : j + 1] = p->keys[j].get(tx);
+      for (int j = 0; j <= count; ++j)
+        kids[j <= i ? j : j + 1] = p->children[j].get(tx);
+      keys[i] = sep;
+      kids[i + 1] = sib;
+      ++count;
+
+      // If they fit, write them back.  Otherwise, the parent keeps the lower
+      // half, a new right sibling gets the upper half, and the middle key
+      // moves up a level.
+      int keep = count;
+      inner_t *right = nullptr;
+      if (count > B) {
+        keep = count / 2;
+        right = new inner_t(level);
+        int moved = count - keep - 1;
+        for (int j = 0; j < moved; ++j)
+          right->keys[j].set(keys[keep + 1 + j], tx);
+        for (int j = 0; j <= moved; ++j)
+          right->children[j].set(kids[keep + 1 + j], tx);
+        right->count.set(moved, tx);
+        right->high.set(p->high.get(tx), tx);
+        right->right.set(p->right.get(tx), tx);
+        p->high.set(keys[keep], tx);
+        p->right.set(right, tx);
+      }
+      for (int j = i; j < keep; ++j)
+        p->keys[j].set(keys[j], tx);
+      for (int j = i + 1; j <= keep; ++j)
+        p->children[j].set(kids[j], tx);
+      p->count.set(keep, tx);
+
+      // Continue at the next level up, if the parent split
+      sep = keys[keep];
+      sib = right;
+      ++level;
+    }
+  }
+
+  /// Merge the node on top of `me->snapshots`, which has too few keys, with a
+  /// sibling, and repeat up the tree while the parent has too few keys.  If
+  /// the root has a single child, the child becomes the root.
+  ///
+  /// Each merge is one WSTEP, which acquires the parent (only if it has not
+  /// changed since the search that produced `me->snapshots`) and the two
+  /// siblings.  A merge that cannot happen is skipped.
+  ///
+  /// @param me The calling thread's descriptor
+  void merge(STMCAS *me) {
+    auto *path = me->snapshots.begin();
+    for (int pos = me->snapshots.size() - 1; pos > 0; --pos) {
+      node_t *c = static_cast<node_t *>(path[pos]._obj);
+      auto &s = path[pos - 1];
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(s._obj, s._ver)) {
+        tx.unwind();
+        return;
+      }
+
+      // If `c` is the root, and has only one child, shrink the tree
+      if (s._obj == &anchor) {
+        if (c->level == 0 || anchor.root.get(tx) != c ||
+            !tx.acquire_aggressive(c) || c->count.get(tx) != 0 ||
+            c->right.get(tx) != nullptr) {
+          tx.unwind();
+          return;
+        }
+        anchor.root.set(static_cast<inner_t *>(c)->children[0].get(tx), tx);
+        tx.reclaim(c);
+        return;
+      }
+
+      // Find `c` in the parent, and choose the sibling to merge it with
+      inner_t *p = static_cast<inner_t *>(s._obj);
+      int pcount = p->count.get(tx);
+      int i = 0;
+      while (i <= pcount && p->children[i].get(tx) != c)
+        ++i;
+      if (i > pcount || pcount == 0) {
+        tx.unwind();
+        return;
+      }
+      int j = (i < pcount) ? i : i - 1;
+      node_t *left = p->children[j].get(tx);
+      node_t *right = p->children[j + 1].get(tx);
+      if (!tx.acquire_aggressive(left) || !tx.acquire_aggressive(right) ||
+          left->right.get(tx) != right) {
+        tx.unwind();
+        return;
+      }
+
+      // Move everything from `right` into `left`.  For internal nodes, the
+      // parent's separator moves down between them.
+      int lcount = left->count.get(tx), rcount = right->count.get(tx);
+      int total = lcount + rcount + (left->level ? 1 : 0);
+      if (total > MAX_MERGED) {
+        tx.unwind();
+        return;
+      }
+      if (left->level == 0) {
+        auto l = static_cast<leaf_t *>(left), r = static_cast<leaf_t *>(right);
+        for (int k = 0; k < rcount; ++k) {
+          l->keys[lcount + k].set(r->keys[k].get(tx), tx);
+          l->vals[lcount + k].set(r->vals[k].get(tx), tx);
+        }
+      } else {
+        auto l = static_cast<inner_t *>(left);
+        auto r = static_cast<inner_t *>(right);
+        l->keys[lcount].set(p->keys[j].get(tx), tx);
+        for (int k = 0; k < rcount; ++k)
+          l->keys[lcount + 1 + k].set(r->keys[k].get(tx), tx);
+        for (int k = 0; k <= rcount; ++k)
+          l->children[lcount + 1 + k].set(r->children[k].get(tx), tx);
+      }
+      left->count.set(total, tx);
+      left->high.set(right->high.get(tx), tx);
+      left->right.set(right->right.get(tx), tx);
+
+      // Remove `right` and its separator from the parent
+      for (int k = j + 1; k < pcount; ++k) {
+        p->keys[k - 1].set(p->keys[k].get(tx), tx);
+        p->children[k].set(p->children[k + 1].get(tx), tx);
+      }
+      p->count.set(--pcount, tx);
+      tx.reclaim(right);
+
+      // Continue up the tree if the parent is now too small.  If the parent
+      // is the root, it is only too small when it has a single child.
+      if (pos == 2 ? pcount > 0 : pcount >= MIN_KEYS)
+        return;
+    }
+  }
+};
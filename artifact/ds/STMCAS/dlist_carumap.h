@@ -4,6 +4,9 @@
 #include <bit>
 #include <functional>
 
+#include "../include/flat_combiner.h"
+#include "../include/multi_key.h"
+
 /// An unordered map, implemented as a resizable array of lists (closed
 /// addressing, resizable).  This map supports get(), insert() and remove()
 /// operations.
@@ -12,12 +15,23 @@
 /// table from PODC 2014.  At the current time, we do not support the heuristic
 /// for contracting the list, but we do support expanding the list.
 ///
+/// Optionally, updates that repeatedly fail to acquire their orecs (e.g., on a
+/// hot bucket) fall back to flat combining: they are published to a
+/// flat_combiner_t, and one combiner applies a batch of them per WSTEP.
+///
+/// multi_update() applies several inserts, removes, and value CASes atomically.
+/// It searches for each key in its own RSTEP, and then acquires every orec
+/// those searches depended on in one WSTEP (see mk_lockset_t).
+///
 /// @param K      The type of the keys stored in this map
 /// @param V      The type of the values stored in this map
 /// @param STMCAS The STMCAS implementation (PO or PS)
-template <typename K, typename V, class STMCAS> class dlist_carumap {
+/// @param FC     Should contended updates fall back to flat combining?
+template <typename K, typename V, class STMCAS, bool FC = false>
+class dlist_carumap {
   using WSTEP = typename STMCAS::WSTEP;
   using RSTEP = typename STMCAS::RSTEP;
+  using STEP = typename STMCAS::STEP;
   using snapshot_t = typename STMCAS::snapshot_t;
   using ownable_t = typename STMCAS::ownable_t;
   template <typename T> using FIELD = typename STMCAS::template sField<T>;
@@ -110,6 +124,30 @@ template <typename K, typename V, class STMCAS> class dlist_carumap {
   std::hash<K> _pre_hash; // A weak hash function for converting keys to ints
   const uint64_t RESIZE_THRESHOLD; // Max bucket size before resizing
 
+  /// The number of failed attempts after which an update is combined
+  static const int FC_ATTEMPTS = 2;
+
+  /// The number of flat combining publication lists
+  static const int FC_SHARDS = 64;
+
+  using fc_req_t = fc_request_t<K, V>;
+  using fc_t = flat_combiner_t<fc_req_t, FC_SHARDS>;
+  fc_t fc; // The flat combiner, which is only used when FC is true
+
+  using mk_t = mk_op_t<K, V>;            // A multi-key operation's update
+  using lockset_t = mk_lockset_t<STMCAS>; // A multi-key operation's orecs
+
+  /// The most orecs that one update of a multi-key operation depends on
+  static const int MK_LOCKS = 3;
+
+  /// The result of a multi-key operation's search for one of its keys
+  struct mk_plan_t {
+    sentinel_t *bucket; // The head of the key's bucket
+    data_t *found;      // The node whose key is the update's key, or nullptr
+    uint64_t count;     // The number of nodes in the bucket
+    uint64_t a_ver;     // The version of `active` when the bucket was found
+  };
+
   /// A pair consisting of a pointer and an orec version.
   struct node_ver_t {
     node_t *_obj = nullptr; // The start of a bucket
@@ -437,13 +475,13 @@ private:
   ///
   /// @param key  The key for which we are searching
   /// @param head The start of the list to search
-  /// @param tx   An active WSTEP transaction
+  /// @param tx   An active RSTEP or WSTEP transaction
   ///
   /// @return {nullptr, 0}  if the transaction discovered an inconsistency
   ///         {head, count} if the key was not found
   ///         {node, 0}     if the key was found at `node`
   std::pair<node_t *, uint64_t> list_get_or_head(const K &key, sentinel_t *head,
-                                                 WSTEP &tx) {
+                                                 STEP &tx) {
     // Get the head's successor; on any inconsistency, return.
     auto curr = head->next.get(tx);
     uint64_t head_orec = tx.check_orec(head);
@@ -546,101 +584,358 @@ public:
     // and then resize in a new transaction before returning.  Tracking
     // `active`'s version prevents double-resizing under concurrency.
     uint64_t a_ver = 0;
-    while (true) {
+    bool grow = false, res = false;
+    for (int attempts = 0;; ++attempts) {
+      if (FC && attempts == FC_ATTEMPTS) {
+        fc_req_t req(fc_req_t::INSERT, key, val);
+        return combine(me, req);
+      }
       WSTEP tx(me);
-      auto [bucket, a_version] = get_bucket(me, key, tx);
-      if (!bucket)
-        continue;
-      a_ver = a_version;
-
-      // Find the node in `bucket` that matches `key`.  If it can't be found,
-      // we'll get the head node.
-      auto [node, count] =
-          list_get_or_head(key, static_cast<sentinel_t *>(bucket), tx);
+      auto step = insert_step(me, key, val, tx, a_ver, grow, res);
+      if (step == STEP_ABORT || (step == STEP_DONE && !res))
+        tx.unwind(); // because we didn't update shared memory
+      if (step == STEP_DONE)
+        break;
+    }
+    if (grow) {
+      EXO_TRACE(tracer_t::RESIZE_BEGIN);
+      resize(me, a_ver);
+      EXO_TRACE(tracer_t::RESIZE_END);
+    }
+    return res;
+  }
 
-      // If we got back null, there was an inconsistency, so retry
-      if (!node) {
-        tx.unwind();
-        continue;
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(STMCAS *me, const K &key) {
+    bool res = false;
+    for (int attempts = 0;; ++attempts) {
+      if (FC && attempts == FC_ATTEMPTS) {
+        fc_req_t req(fc_req_t::REMOVE, key, V());
+        return combine(me, req);
       }
+      WSTEP tx(me);
+      auto step = remove_step(me, key, tx, res);
+      if (step == STEP_ABORT || (step == STEP_DONE && !res))
+        tx.unwind(); // because we didn't update shared memory
+      if (step == STEP_DONE)
+        return res;
+    }
+  }
 
-      // If we didn't get the head, the key already exists, so return false
-      if (node != bucket) {
-        tx.unwind();
-        return false;
+  /// Apply a set of single-key updates atomically.  If any update's
+  /// precondition does not hold (an INSERT's key is present, a REMOVE's key
+  /// is absent, or a CAS's key is absent or has an unexpected value), then
+  /// nothing is changed.
+  ///
+  /// NB: The keys of `ops` must be distinct, and there may be at most
+  ///     MK_MAX_KEYS of them.  This calls std::terminate otherwise.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param ops The updates to apply
+  /// @param num The number of updates
+  ///
+  /// @return True if every update was applied, false if none were
+  bool multi_update(STMCAS *me, mk_t *ops, int num) {
+    if (num > MK_MAX_KEYS)
+      std::terminate();
+    mk_plan_t plans[MK_MAX_KEYS];
+    typename lockset_t::entry_t lock_buf[MK_MAX_KEYS * MK_LOCKS];
+    lockset_t locks(lock_buf);
+    while (true) {
+      locks.clear();
+      for (int i = 0; i < num; ++i)
+        mk_plan(me, ops[i], plans[i], locks);
+
+      // Acquiring everything at its observed version means that every search
+      // result still holds, so the preconditions can be checked directly
+      uint64_t a_ver = 0;
+      bool grow = false;
+      {
+        WSTEP tx(me);
+        if (!locks.acquire_all(tx)) {
+          tx.unwind();
+          continue;
+        }
+        for (int i = 0; i < num; ++i) {
+          data_t *f = plans[i].found;
+          bool ok = ops[i].kind == mk_t::INSERT
+                        ? f == nullptr
+                        : f != nullptr && (ops[i].kind == mk_t::REMOVE ||
+                                           f->val == ops[i].expected);
+          if (!ok) {
+            tx.unwind();
+            return false;
+          }
+        }
+        for (int i = 0; i < num; ++i) {
+          mk_apply(tx, ops[i], plans[i]);
+          if (ops[i].kind == mk_t::INSERT &&
+              plans[i].count >= RESIZE_THRESHOLD) {
+            grow = true;
+            a_ver = plans[i].a_ver;
+          }
+        }
       }
-
-      // Lock the node and its successor
-      if (!tx.acquire_consistent(node)) {
-        tx.unwind();
-        continue;
+      if (grow) {
+        EXO_TRACE(tracer_t::RESIZE_BEGIN);
+        resize(me, a_ver);
+        EXO_TRACE(tracer_t::RESIZE_END);
       }
-      auto next = node->next.get(tx);
-      if (!tx.acquire_aggressive(next)) {
-        tx.unwind();
-        continue;
+      return true;
+    }
+  }
+
+private:
+  /// Search for one key of a multi-key operation, and add the orecs that its
+  /// update depends on to `locks`
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param op    The update
+  /// @param plan  A ref parameter for the search's results
+  /// @param locks The lock set of the multi-key operation
+  void mk_plan(STMCAS *me, const mk_t &op, mk_plan_t &plan, lockset_t &locks) {
+    while (true) {
+      {
+        RSTEP tx(me);
+        auto a_tbl = active.get(tx);
+        uint64_t a_ver = tx.check_orec(tbl_orec);
+        if (a_ver == STMCAS::END_OF_TIME)
+          continue;
+        auto bucket = a_tbl->tbl[table_hash(me, op.key, a_tbl->size)].get(tx);
+        if (bucket) {
+          auto [node, count] = list_get_or_head(op.key, bucket, tx);
+          if (!node)
+            continue;
+          data_t *found =
+              node == bucket ? nullptr : static_cast<data_t *>(node);
+
+          // The head's orec covers the key's absence (inserts and rehashes
+          // acquire it), and `found`'s orec covers its presence and value.
+          // Stitching and unstitching also depend on the neighbors.
+          node_t *deps[MK_LOCKS];
+          int num_deps = 0;
+          if (!found) {
+            deps[num_deps++] = bucket;
+            if (op.kind == mk_t::INSERT)
+              deps[num_deps++] = bucket->next.get(tx);
+          } else {
+            deps[num_deps++] = found;
+            if (op.kind == mk_t::REMOVE) {
+              deps[num_deps++] = found->prev.get(tx);
+              deps[num_deps++] = found->next.get(tx);
+            }
+          }
+          uint64_t vers[MK_LOCKS];
+          bool ok = true;
+          for (int i = 0; ok && i < num_deps; ++i) {
+            vers[i] = tx.check_orec(deps[i]);
+            ok = vers[i] != STMCAS::END_OF_TIME;
+          }
+          if (!ok)
+            continue;
+          for (int i = 0; i < num_deps; ++i)
+            locks.add(deps[i], vers[i]);
+          plan = {bucket, found, count, a_ver};
+          return;
+        }
       }
+      // The bucket has not been rehashed into `active` yet.  get_bucket will
+      // do it, and as for insert() and remove(), its WSTEP can just commit.
+      WSTEP tx(me);
+      get_bucket(me, op.key, tx);
+    }
+  }
 
-      // Stitch in a new node
-      data_t *new_dn = new data_t(key, val);
+  /// Apply one update of a multi-key operation, once all of the operation's
+  /// orecs are held and all of its preconditions hold.
+  ///
+  /// Earlier updates in the same bucket may have changed `found`'s neighbors,
+  /// so they are re-read rather than taken from the plan.  Every neighbor is
+  /// either held by this WSTEP, or a node that an earlier update created.
+  ///
+  /// @param tx   The WSTEP that holds the orecs
+  /// @param op   The update
+  /// @param plan The update's search results
+  void mk_apply(WSTEP &tx, const mk_t &op, const mk_plan_t &plan) {
+    if (op.kind == mk_t::INSERT) {
+      auto next = plan.bucket->next.get(tx);
+      data_t *new_dn = new data_t(op.key, op.val);
       new_dn->next.set(next, tx);
-      new_dn->prev.set(node, tx);
-      node->next.set(new_dn, tx);
+      new_dn->prev.set(plan.bucket, tx);
+      plan.bucket->next.set(new_dn, tx);
       next->prev.set(new_dn, tx);
-      if (count >= RESIZE_THRESHOLD)
-        break; // need to resize!
-      return true;
+    } else if (op.kind == mk_t::REMOVE) {
+      auto pred = plan.found->prev.get(tx), succ = plan.found->next.get(tx);
+      pred->next.set(succ, tx);
+      succ->prev.set(pred, tx);
+      tx.reclaim(plan.found);
+    } else {
+      // NB: get() may read scalar values without holding the orec
+      if constexpr (std::is_scalar<V>::value)
+        reinterpret_cast<std::atomic<V> *>(&plan.found->val)
+            ->store(op.val, std::memory_order_release);
+      else
+        plan.found->val = op.val;
     }
+  }
 
-    resize(me, a_ver);
-    return true;
+  /// The outcome of trying to do one insert or remove within a WSTEP
+  enum step_result_t {
+    STEP_DONE,    // The operation linearized (its result is in `res`)
+    STEP_ABORT,   // Inconsistency: nothing was written, so the step can unwind
+    STEP_RESTART, // get_bucket rehashed or failed: commit, then try again
+  };
+
+  /// The body of one insert() attempt, within a caller's WSTEP
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param key   The key for the mapping to create
+  /// @param val   The value for the mapping to create
+  /// @param tx    An active WSTEP transaction
+  /// @param a_ver A ref parameter for `active`'s version, for resizing
+  /// @param grow  A ref parameter that is set if the table needs to grow
+  /// @param res   A ref parameter for insert()'s return value
+  ///
+  /// @return The outcome of the attempt
+  step_result_t insert_step(STMCAS *me, const K &key, const V &val, WSTEP &tx,
+                            uint64_t &a_ver, bool &grow, bool &res) {
+    auto [bucket, a_version] = get_bucket(me, key, tx);
+    if (!bucket)
+      return STEP_RESTART;
+    a_ver = a_version;
+
+    // Find the node in `bucket` that matches `key`.  If it can't be found,
+    // we'll get the head node.
+    auto [node, count] =
+        list_get_or_head(key, static_cast<sentinel_t *>(bucket), tx);
+
+    // If we got back null, there was an inconsistency, so retry
+    if (!node)
+      return STEP_ABORT;
+
+    // If we didn't get the head, the key already exists, so return false
+    if (node != bucket) {
+      res = false;
+      return STEP_DONE;
+    }
+
+    // Lock the node and its successor
+    if (!tx.acquire_consistent(node))
+      return STEP_ABORT;
+    auto next = node->next.get(tx);
+    if (!tx.acquire_aggressive(next))
+      return STEP_ABORT;
+
+    // Stitch in a new node
+    data_t *new_dn = new data_t(key, val);
+    new_dn->next.set(next, tx);
+    new_dn->prev.set(node, tx);
+    node->next.set(new_dn, tx);
+    next->prev.set(new_dn, tx);
+    grow = grow || count >= RESIZE_THRESHOLD; // need to resize!
+    res = true;
+    return STEP_DONE;
   }
 
-  /// Clear the mapping involving the provided `key`.
+  /// The body of one remove() attempt, within a caller's WSTEP
   ///
   /// @param me  The calling thread's descriptor
   /// @param key The key for the mapping to eliminate
+  /// @param tx  An active WSTEP transaction
+  /// @param res A ref parameter for remove()'s return value
   ///
-  /// @return True if the key was found and removed, false otherwise
-  bool remove(STMCAS *me, const K &key) {
-    while (true) {
-      WSTEP tx(me);
-      // Get the bucket in `active` where `key` should be.  Abort and retry on
-      // any inconsistency; commit and retry if `get_bucket` resized
-      auto [bucket, _] = get_bucket(me, key, tx);
-      if (!bucket)
-        continue;
+  /// @return The outcome of the attempt
+  step_result_t remove_step(STMCAS *me, const K &key, WSTEP &tx, bool &res) {
+    // Get the bucket in `active` where `key` should be.  Abort and retry on
+    // any inconsistency; commit and retry if `get_bucket` resized
+    auto [bucket, _] = get_bucket(me, key, tx);
+    if (!bucket)
+      return STEP_RESTART;
+
+    // Find the node in `bucket` that matches `key`.  If it can't be found,
+    // we'll get the head node.
+    //
+    // NB: While `bucket` has not been reclaimed, `active.tbl` may have
+    //     changed.  Fortunately, list_get_or_head will validate it.
+    auto [node, __] =
+        list_get_or_head(key, static_cast<sentinel_t *>(bucket), tx);
+
+    // If we got back the head, return false
+    if (node == bucket) {
+      res = false;
+      return STEP_DONE;
+    }
 
-      // Find the node in `bucket` that matches `key`.  If it can't be found,
-      // we'll get the head node.
-      //
-      // NB: While `bucket` has not been reclaimed, `active.tbl` may have
-      //     changed.  Fortunately, list_get_or_head will validate it.
-      auto [node, __] =
-          list_get_or_head(key, static_cast<sentinel_t *>(bucket), tx);
+    // If the `node` is null, list_get_or_head failed and we need to retry
+    // Otherwise, it's unowned and the keys match, so lock `node` and its
+    // neighbors, else retry
+    if (!node || !tx.acquire_consistent(node) ||
+        !tx.acquire_aggressive(node->prev.get(tx)) ||
+        !tx.acquire_aggressive(node->next.get(tx)))
+      return STEP_ABORT;
+
+    // unstitch it
+    auto pred = node->prev.get(tx), succ = node->next.get(tx);
+    pred->next.set(succ, tx);
+    succ->prev.set(pred, tx);
+    tx.reclaim(node);
+    res = true;
+    return STEP_DONE;
+  }
 
-      // If we got back the head, return false
-      if (node == bucket) {
-        tx.unwind(); // because we didn't update shared memory
-        return false;
-      }
+  /// Hand a request to the flat combiner, and apply batches of requests if this
+  /// thread becomes the combiner for the request's shard
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param req The request to publish
+  ///
+  /// @return The request's result
+  bool combine(STMCAS *me, fc_req_t &req) {
+    return fc.combine(me->hash(_pre_hash(req.key)), req,
+                      [&](fc_req_t *batch) { apply_batch(me, batch); });
+  }
 
-      // If the `node` is null, list_get_or_head failed and we need to retry
-      // Otherwise, it's unowned and the keys match, so lock `node` and its
-      // neighbors, else retry
-      if (!node || !tx.acquire_consistent(node) ||
-          !tx.acquire_aggressive(node->prev.get(tx)) ||
-          !tx.acquire_aggressive(node->next.get(tx))) {
-        tx.unwind();
-        continue;
+  /// As the combiner, apply a list of requests.  Each WSTEP applies as many
+  /// requests as it can, so that a hot bucket is written once per batch instead
+  /// of once per request.  When a request can't be applied, the requests before
+  /// it are committed, and a new WSTEP picks up where the old one stopped.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param batch The requests to apply, in order
+  void apply_batch(STMCAS *me, fc_req_t *batch) {
+    while (batch) {
+      fc_req_t *first = batch;
+      uint64_t a_ver = 0;
+      bool grow = false;
+      {
+        WSTEP tx(me);
+        while (batch) {
+          auto step = batch->kind == fc_req_t::INSERT
+                          ? insert_step(me, batch->key, batch->val, tx, a_ver,
+                                        grow, batch->result)
+                          : remove_step(me, batch->key, tx, batch->result);
+          if (step != STEP_DONE) {
+            // NB: Requests before `batch` have written, so we can only unwind
+            //     if there aren't any
+            if (step == STEP_ABORT && batch == first)
+              tx.unwind();
+            break;
+          }
+          batch = batch->next;
+        }
+      }
+      // The WSTEP committed, so the applied requests can be completed
+      fc_t::finish(first, batch);
+      if (grow) {
+        EXO_TRACE(tracer_t::RESIZE_BEGIN);
+        resize(me, a_ver);
+        EXO_TRACE(tracer_t::RESIZE_END);
       }
-
-      // unstitch it
-      auto pred = node->prev.get(tx), succ = node->next.get(tx);
-      pred->next.set(succ, tx);
-      succ->prev.set(pred, tx);
-      tx.reclaim(node);
-      return true;
     }
   }
 };
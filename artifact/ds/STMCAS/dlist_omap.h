@@ -3,6 +3,8 @@
 #include <atomic>
 #include <type_traits>
 
+#include "../include/cold_part.h"
+
 /// An ordered map, implemented as a doubly-linked list.  This map supports
 /// get(), insert(), and remove() operations.
 ///
@@ -16,7 +18,11 @@
 /// @param AVOID_OREC_CHECKS A flag to enable an optimization that avoids
 ///                          checking orecs when get_leq is doing its read-only
 ///                          traversal
-template <typename K, typename V, class STMCAS, bool AVOID_OREC_CHECKS>
+/// @param HOT_COLD          A flag to move values out of list nodes, into a
+///                          separate allocation, and to cache-align the
+///                          search-path part of each node
+template <typename K, typename V, class STMCAS, bool AVOID_OREC_CHECKS,
+          bool HOT_COLD = false>
 class dlist_omap {
   using WSTEP = typename STMCAS::WSTEP;
   using RSTEP = typename STMCAS::RSTEP;
@@ -31,7 +37,7 @@ class dlist_omap {
   /// NB: we do not need a `valid` bit, because any operation that would clear
   ///     it would also acquire this node's orec, and thus any node that would
   ///     encounter a cleared valid bit would also detect an orec inconsistency.
-  struct node_t : ownable_t {
+  struct alignas(hot_align_v<ownable_t, HOT_COLD>) node_t : ownable_t {
     FIELD<node_t *> prev; // Pointer to predecessor
     FIELD<node_t *> next; // Pointer to successor
 
@@ -42,18 +48,28 @@ class dlist_omap {
     virtual ~node_t() {}
   };
 
+  /// The fields of a data_t that searches do not need
+  struct cold_t {
+    V val; // The value of this key/value pair
+
+    /// Construct the cold part of a data_t
+    ///
+    /// @param _val The value that is stored in this node
+    cold_t(const V &_val) : val(_val) {}
+  };
+
   /// A list node that also has a key and value.  Note that keys are const, and
   /// values are only accessed while the node is locked, so neither is a
   /// tm_field.
   struct data_t : public node_t {
-    const K key; // The key of this key/value pair
-    V val;       // The value of this key/value pair
+    const K key;                        // The key of this key/value pair
+    cold_part_t<cold_t, HOT_COLD> cold; // The value of this key/value pair
 
     /// Construct a data_t
     ///
     /// @param _key The key that is stored in this node
     /// @param _val The value that is stored in this node
-    data_t(const K &_key, const V &_val) : node_t(), key(_key), val(_val) {}
+    data_t(const K &_key, const V &_val) : node_t(), key(_key), cold(_val) {}
 
     /// Destructor is a no-op, but it needs to be virtual because of inheritance
     virtual ~data_t() {}
@@ -65,6 +81,11 @@ class dlist_omap {
     uint64_t _ver = 0;      // The observed version of the object
   };
 
+  // The sentinels are stored inline, so that a list has no separate
+  // allocations until it holds data.  This lets hash tables keep their buckets
+  // (and the head sentinels' orecs) in one contiguous array.
+  node_t head_node;   // The head sentinel
+  node_t tail_node;   // The tail sentinel
   node_t *const head; // The list head pointer
   node_t *const tail; // The list tail pointer
 
@@ -80,7 +101,7 @@ public:
   /// @param me  The operation that is constructing the list
   /// @param cfg A configuration object that has a `snapshot_freq` field
   dlist_omap(STMCAS *me, auto *cfg)
-      : head(new node_t()), tail(new node_t()),
+      : head(&head_node), tail(&tail_node),
         SNAPSHOT_FREQUENCY(cfg->snapshot_freq) {
     // NB: Even though this code can't abort and doesn't acquire orecs, we still
     //     need to use a transaction (WSTEP), because we can't set fields of a
@@ -245,7 +266,7 @@ public:
         // NB: given EBR, we don't need to worry about n._obj being deleted, so
         //     we don't need to validate before looking at the value
         data_t *dn = static_cast<data_t *>(n._obj);
-        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->val)->load(
+        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->cold->val)->load(
             std::memory_order_acquire);
         if (!tx.check_continuation(n._obj, n._ver))
           continue;
@@ -262,7 +283,7 @@ public:
         }
 
         // NB: we aren't changing val, so we can unwind when we're done with it
-        val = static_cast<data_t *>(n._obj)->val;
+        val = static_cast<data_t *>(n._obj)->cold->val;
         tx.unwind();
         return true;
       }
@@ -4,13 +4,19 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "../include/cold_part.h"
+
 /// An ordered map, implemented as an unbalanced, internal binary search tree.
-/// This map supports get(), insert(), and remove() operations.
+/// This map supports get(), get_geq(), insert(), and remove() operations.
 ///
-/// @param K      The type of the keys stored in this map
-/// @param V      The type of the values stored in this map
-/// @param STMCAS The STMCAS implementation (PO or PS)
-template <typename K, typename V, class STMCAS> class ibst_omap {
+/// @param K        The type of the keys stored in this map
+/// @param V        The type of the values stored in this map
+/// @param STMCAS   The STMCAS implementation (PO or PS)
+/// @param HOT_COLD A flag to move values out of tree nodes, into a separate
+///                 allocation, and to cache-align the search-path part of each
+///                 node
+template <typename K, typename V, class STMCAS, bool HOT_COLD = false>
+class ibst_omap {
   using WSTEP = typename STMCAS::WSTEP;
   using RSTEP = typename STMCAS::RSTEP;
   using snapshot_t = typename STMCAS::snapshot_t;
@@ -22,7 +28,7 @@ template <typename K, typename V, class STMCAS> class ibst_omap {
 
   /// node_t is the base type for all tree nodes.  It doesn't have key/value
   /// fields.
-  struct node_t : public ownable_t {
+  struct alignas(hot_align_v<ownable_t, HOT_COLD>) node_t : public ownable_t {
     /// The node's children.  Be sure to use LEFT and RIGHT to index it
     FIELD<node_t *> children[2];
 
@@ -56,14 +62,24 @@ template <typename K, typename V, class STMCAS> class ibst_omap {
   /// root of the tree.  That is, logically sentinel has the value "TOP".
   node_t *sentinel;
 
+  /// The fields of a data_t that searches do not need
+  struct cold_t {
+    V val; // The value stored in this node
+
+    /// Construct the cold part of a node
+    ///
+    /// @param _val the value of the node
+    cold_t(V &_val) : val(_val) {}
+  };
+
   /// data_t is the type for all internal and leaf nodes in the data structure.
   /// It extends the base type with a key and value.
   ///
   /// NB: keys are *not* const, because we want to overwrite nodes instead of
   ///     swapping them
   struct data_t : public node_t {
-    FIELD<K> key; // The key stored in this node
-    V val;        // The value stored in this node
+    FIELD<K> key;                       // The key stored in this node
+    cold_part_t<cold_t, HOT_COLD> cold; // The value stored in this node
 
     /// Construct a node
     ///
@@ -73,7 +89,7 @@ template <typename K, typename V, class STMCAS> class ibst_omap {
     /// @param _key the key of the node
     /// @param _val the value of the node
     data_t(WSTEP &tx, node_t *_left, node_t *_right, const K &_key, V &_val)
-        : node_t(tx, _left, _right), key(_key), val(_val) {}
+        : node_t(tx, _left, _right), key(_key), cold(_val) {}
   };
 
 public:
@@ -253,7 +269,7 @@ public:
       if (std::is_scalar<V>::value) {
         RSTEP tx(me);
         auto *dn = static_cast<data_t *>(curr._obj);
-        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->val)->load(
+        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->cold->val)->load(
             std::memory_order_acquire);
         if (!tx.check_continuation(curr._obj, curr._ver))
           continue;
@@ -266,13 +282,59 @@ public:
           continue;
         }
         auto dn = static_cast<data_t *>(curr._obj);
-        val = dn->val;
+        val = dn->cold->val;
         tx.unwind(); // because this WSTEP_TM didn't write anything
         return true;
       }
     }
   }
 
+  /// Find the mapping with the smallest key that is not less than `key`.  The
+  /// search is a single read-only step, so the result is linearizable.
+  ///
+  /// NB: V must be scalar, so that the step can read values
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param key   The key to search from
+  /// @param found A ref parameter for returning the key that was found
+  /// @param val   A ref parameter for returning the value of `found`
+  ///
+  /// @return True if there is such a key, false otherwise.  The reference
+  ///         parameters are only valid when the return value is true.
+  bool get_geq(STMCAS *me, const K &key, K &found, V &val) const {
+    static_assert(std::is_scalar<V>::value, "get_geq() requires a scalar V");
+    while (true) {
+      RSTEP tx(me);
+      node_t *curr = sentinel->children[LEFT].get(tx);
+      if (tx.check_orec(sentinel) == STMCAS::END_OF_TIME)
+        continue;
+      // Every node on the path is validated before we use what we read from
+      // it, so the path is consistent with the step's start time
+      bool res = false, valid = true;
+      while (curr != nullptr) {
+        auto *dn = static_cast<data_t *>(curr);
+        auto dn_key = dn->key.get(tx);
+        V dn_val = std::atomic_ref<V>(dn->cold->val).load(
+            std::memory_order_acquire);
+        auto next = dn->children[(dn_key < key) ? RIGHT : LEFT].get(tx);
+        if (tx.check_orec(dn) == STMCAS::END_OF_TIME) {
+          valid = false;
+          break;
+        }
+        if (!(dn_key < key)) {
+          res = true;
+          found = dn_key;
+          val = dn_val;
+          if (dn_key == key)
+            break;
+        }
+        curr = next;
+      }
+      if (valid)
+        return res;
+    }
+  }
+
   /// Create a mapping from the provided `key` to the provided `val`, but only
   /// if no such mapping already exists.  This method does *not* have upsert
   /// behavior for keys already present.
@@ -377,8 +439,8 @@ public:
         // Copy `succ`'s key/value into `target`
         static_cast<data_t *>(target._obj)
             ->key.set(static_cast<data_t *>(succ._obj)->key.get(tx), tx);
-        static_cast<data_t *>(target._obj)->val =
-            static_cast<data_t *>(succ._obj)->val;
+        static_cast<data_t *>(target._obj)->cold->val =
+            static_cast<data_t *>(succ._obj)->cold->val;
 
         // Unstitch `succ` by setting its parent's left to its right
         // Case 1: there are intermediate nodes between target and successor
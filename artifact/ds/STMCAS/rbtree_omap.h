@@ -6,13 +6,25 @@
 #include <iostream>
 #include <type_traits>
 
+#include "../include/cold_part.h"
+#include "../include/hot_node_cache.h"
+
 /// An ordered map, implemented as an unbalanced, internal binary search tree.
-/// This map supports get(), insert(), and remove() operations.
+/// This map supports get(), get_geq(), insert(), update(), and remove()
+/// operations.
 ///
-/// @param K      The type of the keys stored in this map
-/// @param V      The type of the values stored in this map
-/// @param STMCAS The STMCAS implementation (PO or PS)
-template <typename K, typename V, class STMCAS> class rbtree_omap {
+/// @param K        The type of the keys stored in this map
+/// @param V        The type of the values stored in this map
+/// @param STMCAS   The STMCAS implementation (PO or PS)
+/// @param HOT_COLD A flag to move values out of tree nodes, into a separate
+///                 allocation, and to cache-align the rest of each node
+/// @param HOT_CACHE A flag to have get() consult a per-thread cache of recently
+///                  found nodes (hot_node_cache_t) before traversing the tree.
+///                  The cache is only used when V is scalar and HOT_COLD is
+///                  false, so that a cached node's value is inline.
+template <typename K, typename V, class STMCAS, bool HOT_COLD = false,
+          bool HOT_CACHE = false>
+class rbtree_omap {
   using WSTEP = typename STMCAS::WSTEP;
   using RSTEP = typename STMCAS::RSTEP;
   using snapshot_t = typename STMCAS::snapshot_t;
@@ -27,7 +39,7 @@ template <typename K, typename V, class STMCAS> class rbtree_omap {
 
   /// node_t is the base type for all tree nodes.  It doesn't have key/value
   /// fields.
-  struct node_t : public ownable_t {
+  struct alignas(hot_align_v<ownable_t, HOT_COLD>) node_t : public ownable_t {
     FIELD<node_t *> children[2]; // The node's children; index with LEFT/RIGHT
     FIELD<COLOR> color;          // The node's color
 
@@ -58,15 +70,31 @@ template <typename K, typename V, class STMCAS> class rbtree_omap {
   /// root of the tree.  That is, logically sentinel has the value "TOP".
   node_t *sentinel;
 
+  /// Should get() use a hot_node_cache_t?  Not when values are in a separate
+  /// allocation: the cached node may be reclaimed at any point during
+  /// cached_get(), so it must not follow the node's `cold` pointer.
+  static const bool USE_CACHE =
+      HOT_CACHE && !HOT_COLD && std::is_scalar<V>::value;
+
+  /// The fields of a data_t that searches do not need
+  struct cold_t {
+    V val; // The value stored in this node
+
+    /// Construct the cold part of a node
+    ///
+    /// @param _val The node's value
+    cold_t(V &_val) : val(_val) {}
+  };
+
   /// data_t is the type for all internal and leaf nodes in the data structure.
   /// It extends the base type with a key and value.
   ///
   /// NB: keys are *not* const, because we want to overwrite nodes instead of
   ///     swapping them
   struct data_t : public node_t {
-    FIELD<K> key;           // The key stored in this node
-    V val;                  // The value stored in this node
-    FIELD<node_t *> parent; // The node's parent
+    FIELD<K> key;                       // The key stored in this node
+    FIELD<node_t *> parent;             // The node's parent
+    cold_part_t<cold_t, HOT_COLD> cold; // The node's value
 
     /// Construct a node
     ///
@@ -79,10 +107,12 @@ template <typename K, typename V, class STMCAS> class rbtree_omap {
     /// @param _color  The color of this node
     data_t(WSTEP &tx, node_t *_parent, node_t *_left, node_t *_right,
            const K &_key, V &_val, COLOR _color)
-        : node_t(tx, _color, _left, _right), key(_key), val(_val),
-          parent(_parent) {}
+        : node_t(tx, _color, _left, _right), key(_key), parent(_parent),
+          cold(_val) {}
   };
 
+  using cache_t = hot_node_cache_t<K, data_t>; // Per-thread cache type
+
 public:
   /// Default construct an empty tree
   ///
@@ -244,6 +274,8 @@ public:
   /// @return True if the key is found, false otherwise.  The reference
   ///         parameter `val` is only valid when the return value is true.
   bool get(STMCAS *me, const K &key, V &val) const {
+    if (USE_CACHE && cached_get(me, key, val))
+      return true;
     me->snapshots.clear();
     while (true) {
       // Get the node that holds `key`, if it is present. If it isn't present,
@@ -258,13 +290,16 @@ public:
         RSTEP tx(me);
         auto *dn = static_cast<data_t *>(curr._obj);
         auto dn_key = dn->key.get(tx);
-        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->val)->load(
+        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->cold->val)->load(
             std::memory_order_acquire);
         if (!tx.check_continuation(curr._obj, curr._ver))
           continue;
         if (dn_key != key)
           return false;
         val = val_copy;
+        if (USE_CACHE)
+          cache_t::get(this).put(me->hash(key), key, dn, curr._ver,
+                                 me->get_op_start_time());
         return true;
       } else {
         WSTEP tx(me);
@@ -277,7 +312,7 @@ public:
           tx.unwind();
           return false;
         }
-        val = dn->val;
+        val = dn->cold->val;
         tx.unwind(); // because this WSTEP_TM didn't write anything
         return true;
       }
@@ -340,6 +375,84 @@ public:
     }
   }
 
+  /// Find the mapping with the smallest key that is not less than `key`.  The
+  /// search is a single read-only step, so the result is linearizable.
+  ///
+  /// NB: V must be scalar, so that the step can read values
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param key   The key to search from
+  /// @param found A ref parameter for returning the key that was found
+  /// @param val   A ref parameter for returning the value of `found`
+  ///
+  /// @return True if there is such a key, false otherwise.  The reference
+  ///         parameters are only valid when the return value is true.
+  bool get_geq(STMCAS *me, const K &key, K &found, V &val) const {
+    static_assert(std::is_scalar<V>::value, "get_geq() requires a scalar V");
+    while (true) {
+      RSTEP tx(me);
+      node_t *curr = sentinel->children[LEFT].get(tx);
+      if (tx.check_orec(sentinel) == STMCAS::END_OF_TIME)
+        continue;
+      // Every node on the path is validated before we use what we read from
+      // it, so the path is consistent with the step's start time
+      bool res = false, valid = true;
+      while (curr != nullptr) {
+        auto *dn = static_cast<data_t *>(curr);
+        auto dn_key = dn->key.get(tx);
+        V dn_val = std::atomic_ref<V>(dn->cold->val).load(
+            std::memory_order_acquire);
+        auto next = dn->children[(dn_key < key) ? RIGHT : LEFT].get(tx);
+        if (tx.check_orec(dn) == STMCAS::END_OF_TIME) {
+          valid = false;
+          break;
+        }
+        if (!(dn_key < key)) {
+          res = true;
+          found = dn_key;
+          val = dn_val;
+          if (dn_key == key)
+            break;
+        }
+        curr = next;
+      }
+      if (valid)
+        return res;
+    }
+  }
+
+  /// Replace the value associated with `key`, if `key` is present
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key whose value should change
+  /// @param val The new value
+  ///
+  /// @return True if the key was found and its value replaced
+  bool update(STMCAS *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      // Get the node that holds `key`, if it is present
+      auto curr = get_node(me, key);
+      if (curr._obj == sentinel)
+        return false;
+
+      // Lock the node, and make sure it still holds `key`
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(curr._obj, curr._ver)) {
+        tx.unwind();
+        continue;
+      }
+      auto dn = static_cast<data_t *>(curr._obj);
+      if (dn->key.get(tx) != key) {
+        tx.unwind();
+        return false;
+      }
+      tx.commit_begin();
+      dn->cold->val = val;
+      return true;
+    }
+  }
+
   /// Clear the mapping involving the provided `key`.
   ///
   /// @param me  The calling thread's descriptor
@@ -462,7 +575,7 @@ public:
         auto s_p = static_cast<data_t *>(succ._obj)->parent.get(tx);
         auto dn = static_cast<data_t *>(target._obj);
         dn->key.set(static_cast<data_t *>(succ._obj)->key.get(tx), tx);
-        dn->val = static_cast<data_t *>(succ._obj)->val;
+        dn->cold->val = static_cast<data_t *>(succ._obj)->cold->val;
 
         // Unstitch `succ` by setting its parent's left to its right (i.e.,
         // child)
@@ -493,6 +606,38 @@ public:
   }
 
 private:
+  /// Try to serve get() from the calling thread's hot_node_cache_t
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the cache had a valid node for `key`, false otherwise
+  bool cached_get(STMCAS *me, const K &key, V &val) const {
+    auto &cache = cache_t::get(this);
+    auto e = cache.find(me->hash(key), key);
+    if (e == nullptr)
+      return false;
+    // The node must not have been reclaimed, before or after we read it, and
+    // its orec must not have changed.  Since removal can move a successor's
+    // key into a node, we also check the key.  USE_CACHE implies !HOT_COLD,
+    // so we only read fields that are inline in the node, and never
+    // dereference a pointer that we read from it.
+    if (!me->reclaimed_since(e->time)) {
+      RSTEP tx(me);
+      auto dn_key = e->node->key.get(tx);
+      V val_copy = reinterpret_cast<std::atomic<V> *>(&e->node->cold->val)
+                       ->load(std::memory_order_acquire);
+      if (tx.check_continuation(e->node, e->ver) &&
+          !me->reclaimed_since(e->time) && dn_key == key) {
+        val = val_copy;
+        return true;
+      }
+    }
+    cache.drop(e);
+    return false;
+  }
+
   /// Acquire all of the nodes that will need to change if `z_p` is to receive a
   /// new child in position `CID_z`.
   ///
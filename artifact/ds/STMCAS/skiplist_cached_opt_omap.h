@@ -1,10 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
 #include <type_traits>
+#include <vector>
+
+#include "../include/flat_combiner.h"
+#include "../include/hot_node_cache.h"
+#include "../include/multi_key.h"
 
 /// An ordered map, implemented as a doubly-linked skip list.  This map supports
 /// get(), insert(), and remove() operations.
@@ -14,12 +20,26 @@
 /// trying to stitch as many layers as possible (and to do so via recording old
 /// values).
 ///
+/// Optionally, updates that repeatedly fail to acquire their orecs (e.g., on a
+/// hot key's predecessor) fall back to flat combining: they are published to a
+/// flat_combiner_t, and one combiner applies a batch of them per WSTEP.
+///
+/// Optionally, get() first consults a per-thread hot_node_cache_t, so that
+/// repeated lookups of the same keys can skip the traversal.
+///
+/// multi_update() applies several inserts, removes, and value CASes atomically.
+/// It searches for each key in its own RSTEP, and then acquires every orec
+/// those searches depended on in one WSTEP (see mk_lockset_t).
+///
 /// @param K         The type of the keys stored in this map
 /// @param V         The type of the values stored in this map
 /// @param STMCAS    The STMCAS implementation (PO or PS)
 /// @param dummy_key A fake key, to use in sentinel nodes
 /// @param dummy_val A fake value, to use in sentinel nodes
-template <typename K, typename V, class STMCAS, K dummy_key, V dummy_val>
+/// @param FC        Should contended updates fall back to flat combining?
+/// @param HOT_CACHE Should lookups use a per-thread cache of hot nodes?
+template <typename K, typename V, class STMCAS, K dummy_key, V dummy_val,
+          bool FC = false, bool HOT_CACHE = false>
 class skiplist_cached_opt_omap {
   using WSTEP = typename STMCAS::WSTEP;
   using RSTEP = typename STMCAS::RSTEP;
@@ -83,6 +103,42 @@ class skiplist_cached_opt_omap {
   data_t *const head;         // The head sentinel
   data_t *const tail;         // The tail sentinel
 
+  /// The number of failed attempts after which an update is combined
+  static const int FC_ATTEMPTS = 2;
+
+  /// The number of flat combining publication lists
+  static const int FC_SHARDS = 64;
+
+  using fc_req_t = fc_request_t<K, V>;
+  using fc_t = flat_combiner_t<fc_req_t, FC_SHARDS>;
+  fc_t fc; // The flat combiner, which is only used when FC is true
+
+  using cache_t = hot_node_cache_t<K, data_t>; // Per-thread cache type
+
+  using mk_t = mk_op_t<K, V>;            // A multi-key operation's update
+  using lockset_t = mk_lockset_t<STMCAS>; // A multi-key operation's orecs
+
+  /// The result of a multi-key operation's search for one of its keys
+  struct mk_plan_t {
+    data_t *n;      // The largest node whose key is < the update's key
+    data_t *found;  // The node whose key is the update's key, or nullptr
+    data_t **preds; // The update's predecessors at each index layer
+  };
+
+  /// A thread's buffers for multi-key operations, whose sizes depend on
+  /// NUM_INDEX_LAYERS.  They are reused by the thread's later operations.
+  struct mk_bufs_t {
+    std::vector<data_t *> preds;       // Every update's index predecessors
+    std::vector<uint64_t> pred_vers;   // One search's predecessors' versions
+    std::vector<typename lockset_t::entry_t> locks; // The lock set's storage
+  };
+
+  /// Get the calling thread's multi-key operation buffers
+  static mk_bufs_t &mk_bufs() {
+    static thread_local mk_bufs_t bufs;
+    return bufs;
+  }
+
 public:
   /// Default construct a skip list by stitching a head sentinel to a tail
   /// sentinel at each level
@@ -113,6 +169,8 @@ public:
   /// @return True if the key is found, false otherwise.  The reference
   ///         parameter `val` is only valid when the return value is true.
   bool get(STMCAS *me, const K &key, V &val) {
+    if (HOT_CACHE && cached_get(me, key, val))
+      return true;
     while (true) {
       RSTEP tx(me);
       // Do a leq... if head, we fail.  n will never be null or tail
@@ -129,9 +187,13 @@ public:
       //     the skiplist
       V val_copy = n->val.load(std::memory_order_acquire);
       // Check after reading value
-      if (tx.check_orec(n) == STMCAS::END_OF_TIME)
+      uint64_t ver = tx.check_orec(n);
+      if (ver == STMCAS::END_OF_TIME)
         continue;
       val = val_copy;
+      if (HOT_CACHE)
+        cache_t::get(this).put(me->hash(key), key, n, ver,
+                               me->get_op_start_time());
       return true;
     }
   }
@@ -146,45 +208,16 @@ public:
   ///
   /// @return True if the value was inserted, false otherwise.
   bool insert(STMCAS *me, const K &key, V &val) {
-    data_t *preds[NUM_INDEX_LAYERS];
     int target_height = randomLevel(me); // The target index height of new_dn
-
-    while (true) {
-      WSTEP tx(me);
-      // Get the insertion point, lock it or retry
-      auto n = get_leq(tx, key, preds, target_height);
-
-      if (n == nullptr)
-        continue;
-
-      // Since we have EBR, we can look at n->key without validation.  If
-      // it matches `key`, return false.
-      if (n != head && n->key == key)
-        return false;
-
-      // Acquire the pred of the to-be-inserted node
-      if (!tx.acquire_consistent(n)) {
-        tx.unwind();
-        continue;
-      }
-      auto next = n->tower[0].next.get(tx);
-
-      // If this is a "short" insert, we can finish quickly
-      if (target_height == 0) {
-        auto new_dn = data_t::make_data(target_height, key, val);
-        new_dn->tower[0].key.set(next->key, tx);
-        new_dn->tower[0].next.set(next, tx);
-        // NB: we don't need to acquire new_dn in this case, because anyone who
-        // finds their way to it will find it fully stitched in.
-        n->tower[0].key.set(key, tx);
-        n->tower[0].next.set(new_dn, tx);
-        return true;
+    bool res = false;
+    for (int attempts = 0;; ++attempts) {
+      if (FC && attempts == FC_ATTEMPTS) {
+        fc_req_t req(fc_req_t::INSERT, key, val, target_height);
+        return combine(me, req);
       }
-
-      // Slow path for when the node is tall, and we have a lot of acquiring to
-      // do
-      if (index_stitch(tx, me, n, next, preds, key, val, target_height))
-        return true;
+      WSTEP tx(me);
+      if (insert_step(tx, me, key, val, target_height, res))
+        return res;
       tx.unwind();
     }
   }
@@ -196,52 +229,370 @@ public:
   ///
   /// @return True if the key was found and removed, false otherwise
   bool remove(STMCAS *me, const K &key) {
-    data_t *preds[NUM_INDEX_LAYERS];
+    bool res = false;
+    for (int attempts = 0;; ++attempts) {
+      if (FC && attempts == FC_ATTEMPTS) {
+        fc_req_t req(fc_req_t::REMOVE, key, dummy_val);
+        return combine(me, req);
+      }
+      WSTEP tx(me);
+      if (remove_step(tx, me, key, res))
+        return res;
+      tx.unwind();
+    }
+  }
 
+  /// Apply a set of single-key updates atomically.  If any update's
+  /// precondition does not hold (an INSERT's key is present, a REMOVE's key
+  /// is absent, or a CAS's key is absent or has an unexpected value), then
+  /// nothing is changed.
+  ///
+  /// NB: The keys of `ops` must be distinct, and there may be at most
+  ///     MK_MAX_KEYS of them.  This calls std::terminate otherwise.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param ops The updates to apply
+  /// @param num The number of updates
+  ///
+  /// @return True if every update was applied, false if none were
+  bool multi_update(STMCAS *me, mk_t *ops, int num) {
+    if (num > MK_MAX_KEYS)
+      std::terminate();
+
+    // Choose new nodes' heights once, so that they don't change on retry
+    int heights[MK_MAX_KEYS];
+    for (int i = 0; i < num; ++i)
+      heights[i] = ops[i].kind == mk_t::INSERT ? randomLevel(me) : 0;
+
+    mk_plan_t plans[MK_MAX_KEYS];
+    auto &bufs = mk_bufs();
+    bufs.preds.resize(num * NUM_INDEX_LAYERS);
+    bufs.pred_vers.resize(NUM_INDEX_LAYERS);
+    bufs.locks.resize(num * (NUM_INDEX_LAYERS + 2));
+    lockset_t locks(bufs.locks.data());
     while (true) {
+      locks.clear();
+      for (int i = 0; i < num; ++i) {
+        plans[i].preds = &bufs.preds[i * NUM_INDEX_LAYERS];
+        mk_plan(me, ops[i], heights[i], plans[i], locks);
+      }
+
+      // Acquiring everything at its observed version means that every search
+      // result still holds, so the preconditions can be checked directly
       WSTEP tx(me);
-      // Get predecessor, find its next, if != key return false
-      data_t *n = get_le(tx, key, preds);
-      if (n == nullptr)
-        continue;
-      auto found = n->tower[0].next.get(tx);
-      if (found == nullptr) {
+      if (!locks.acquire_all(tx)) {
         tx.unwind();
         continue;
       }
-      if (found == tail || found->key != key)
-        return false;
+      for (int i = 0; i < num; ++i) {
+        data_t *f = plans[i].found;
+        bool ok = ops[i].kind == mk_t::INSERT
+                      ? f == nullptr
+                      : f != nullptr && (ops[i].kind == mk_t::REMOVE ||
+                                         f->val.load() == ops[i].expected);
+        if (!ok) {
+          tx.unwind();
+          return false;
+        }
+      }
+      mk_apply(tx, me, ops, plans, heights, num);
+      return true;
+    }
+  }
 
-      // Acquire the target, make sure it's not owned
-      if (!tx.acquire_consistent(found)) {
-        tx.unwind();
+private:
+  /// Search for one key of a multi-key operation, and add the orecs that its
+  /// update depends on to `locks`
+  ///
+  /// @param me     The calling thread's descriptor
+  /// @param op     The update
+  /// @param height The index height of the node that an INSERT would create
+  /// @param plan   A ref parameter for the search's results
+  /// @param locks  The lock set of the multi-key operation
+  void mk_plan(STMCAS *me, const mk_t &op, int height, mk_plan_t &plan,
+               lockset_t &locks) {
+    while (true) {
+      RSTEP tx(me);
+      data_t *n = get_le(tx, op.key, plan.preds);
+      if (n == nullptr)
+        continue;
+      data_t *next = n->tower[0].next.get(tx);
+      uint64_t n_ver = tx.check_orec(n);
+      if (next == nullptr || n_ver == STMCAS::END_OF_TIME)
         continue;
+      data_t *found = (next != tail && next->key == op.key) ? next : nullptr;
+
+      // `found`'s orec covers its presence and value.  `n`'s orec covers the
+      // key's absence, and with the index predecessors, it covers the
+      // stitching of an INSERT or REMOVE.
+      int levels = 0;
+      if (op.kind == mk_t::INSERT && !found)
+        levels = height;
+      else if (op.kind == mk_t::REMOVE && found)
+        levels = found->height;
+      bool need_n = !found || op.kind == mk_t::REMOVE;
+      uint64_t f_ver = found ? tx.check_orec(found) : 0;
+      uint64_t *p_ver = mk_bufs().pred_vers.data();
+      bool ok = f_ver != STMCAS::END_OF_TIME;
+      for (int l = 0; ok && l < levels; ++l) {
+        p_ver[l] = tx.check_orec(plan.preds[l]);
+        ok = p_ver[l] != STMCAS::END_OF_TIME;
       }
-      // Acquire the predecessor so we can edit its next pointer
-      if (!tx.acquire_consistent(n)) {
-        tx.unwind();
+      if (!ok)
         continue;
+
+      if (found)
+        locks.add(found, f_ver);
+      if (need_n)
+        locks.add(n, n_ver);
+      for (int l = 0; l < levels; ++l)
+        locks.add(plan.preds[l], p_ver[l]);
+      plan.n = n;
+      plan.found = found;
+      return;
+    }
+  }
+
+  /// Apply the updates of a multi-key operation, once all of their orecs are
+  /// held and all of their preconditions hold.
+  ///
+  /// The plans were made against the list as it was before any update, so the
+  /// order matters.  Removes go first, from the largest key to the smallest, so
+  /// that no remove's predecessors have been removed.  Then inserts go, from
+  /// the largest key to the smallest, so that no insert's predecessors have
+  /// been inserted, and any predecessor that was removed is replaced by the
+  /// removed node's own predecessor (which the remove's plan acquired).
+  ///
+  /// @param tx      The WSTEP that holds the orecs
+  /// @param me      The calling thread's descriptor
+  /// @param ops     The updates
+  /// @param plans   The updates' search results
+  /// @param heights The index heights of new nodes
+  /// @param num     The number of updates
+  void mk_apply(WSTEP &tx, STMCAS *me, mk_t *ops, mk_plan_t *plans,
+                int *heights, int num) {
+    int order[MK_MAX_KEYS];
+    for (int i = 0; i < num; ++i)
+      order[i] = i;
+    // Indexed by mk_t::kind_t: removes, then inserts, then CASes
+    static const int RANK[] = {1, 0, 2};
+    std::sort(order, order + num, [&](int a, int b) {
+      if (ops[a].kind != ops[b].kind)
+        return RANK[ops[a].kind] < RANK[ops[b].kind];
+      return ops[a].key > ops[b].key;
+    });
+
+    // NB: index_stitch and index_unstitch re-acquire orecs, but this thread
+    //     already holds all of them, so they cannot fail
+    for (int k = 0; k < num; ++k) {
+      int i = order[k];
+      mk_plan_t &p = plans[i];
+      if (ops[i].kind == mk_t::REMOVE) {
+        index_unstitch(tx, me, p.found, p.n, p.preds);
+      } else if (ops[i].kind == mk_t::INSERT) {
+        p.n = mk_live_pred(p.n, 0, ops, plans, num);
+        for (int l = 0; l < heights[i]; ++l)
+          p.preds[l] = mk_live_pred(p.preds[l], l + 1, ops, plans, num);
+        index_stitch(tx, me, p.n, p.n->tower[0].next.get(tx), p.preds,
+                     ops[i].key, ops[i].val, heights[i]);
+      } else {
+        p.found->val.store(ops[i].val, std::memory_order_relaxed);
       }
+    }
+  }
 
-      // Fast-path unstitch when it has height 0
-      if (found->height == 0) {
-        auto nxt = found->tower[0].next.get(tx);
-        n->tower[0].next.set(nxt, tx);
-        n->tower[0].key.set(nxt->key, tx);
-        // NB: don't forget to set `node`'s pointers to null!
-        found->tower[0].next.set(nullptr, tx);
-        tx.reclaim(found);
-        return true;
+  /// Find the node that replaced `pred` as a predecessor at `level`, if the
+  /// current multi-key operation removed `pred`
+  ///
+  /// @param pred  A predecessor from a plan
+  /// @param level The level at which `pred` was a predecessor
+  /// @param ops   The multi-key operation's updates
+  /// @param plans The updates' search results
+  /// @param num   The number of updates
+  ///
+  /// @return `pred`, or the closest predecessor of `pred` that was not removed
+  data_t *mk_live_pred(data_t *pred, int level, mk_t *ops, mk_plan_t *plans,
+                       int num) {
+    for (int j = 0; j < num; ++j) {
+      if (ops[j].kind == mk_t::REMOVE && plans[j].found == pred) {
+        pred = level == 0 ? plans[j].n : plans[j].preds[level - 1];
+        j = -1; // `pred` may have been removed, too
       }
+    }
+    return pred;
+  }
 
-      // Slow-path unstitch when it's tall
-      if (index_unstitch(tx, me, found, n, preds))
+  /// Try to serve get() from the calling thread's hot_node_cache_t
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the cache had a valid node for `key`, false otherwise
+  bool cached_get(STMCAS *me, const K &key, V &val) {
+    auto &cache = cache_t::get(this);
+    auto e = cache.find(me->hash(key), key);
+    if (e == nullptr)
+      return false;
+    // The node must not have been reclaimed, before or after we read it, and
+    // its orec must not have changed (e.g., due to removal).  `val` is inline
+    // in the node, so we never dereference a pointer that we read from it.
+    if (!me->reclaimed_since(e->time)) {
+      RSTEP tx(me);
+      V val_copy = e->node->val.load(std::memory_order_acquire);
+      if (tx.check_continuation(e->node, e->ver) &&
+          !me->reclaimed_since(e->time)) {
+        val = val_copy;
         return true;
-      tx.unwind();
+      }
+    }
+    cache.drop(e);
+    return false;
+  }
+
+  /// The body of one insert() attempt, within a caller's WSTEP
+  ///
+  /// @param tx            An active WSTEP transaction
+  /// @param me            The calling thread's descriptor
+  /// @param key           The key for the mapping to create
+  /// @param val           The value for the mapping to create
+  /// @param target_height The target index height of the new node
+  /// @param res           A ref parameter for insert()'s return value
+  ///
+  /// @return true if the insert linearized, false if it must be retried (in
+  ///         which case it did not write anything)
+  bool insert_step(WSTEP &tx, STMCAS *me, const K &key, const V &val,
+                   int target_height, bool &res) {
+    data_t *preds[NUM_INDEX_LAYERS];
+
+    // Get the insertion point, lock it or retry
+    auto n = get_leq(tx, key, preds, target_height);
+    if (n == nullptr)
+      return false;
+
+    // Since we have EBR, we can look at n->key without validation.  If
+    // it matches `key`, return false.
+    if (n != head && n->key == key) {
+      res = false;
+      return true;
+    }
+
+    // Acquire the pred of the to-be-inserted node
+    if (!tx.acquire_consistent(n))
+      return false;
+    auto next = n->tower[0].next.get(tx);
+
+    // If this is a "short" insert, we can finish quickly
+    if (target_height == 0) {
+      auto new_dn = data_t::make_data(target_height, key, val);
+      new_dn->tower[0].key.set(next->key, tx);
+      new_dn->tower[0].next.set(next, tx);
+      // NB: we don't need to acquire new_dn in this case, because anyone who
+      // finds their way to it will find it fully stitched in.
+      n->tower[0].key.set(key, tx);
+      n->tower[0].next.set(new_dn, tx);
+      res = true;
+      return true;
+    }
+
+    // Slow path for when the node is tall, and we have a lot of acquiring to
+    // do
+    res = index_stitch(tx, me, n, next, preds, key, val, target_height);
+    return res;
+  }
+
+  /// The body of one remove() attempt, within a caller's WSTEP
+  ///
+  /// @param tx  An active WSTEP transaction
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  /// @param res A ref parameter for remove()'s return value
+  ///
+  /// @return true if the remove linearized, false if it must be retried (in
+  ///         which case it did not write anything)
+  bool remove_step(WSTEP &tx, STMCAS *me, const K &key, bool &res) {
+    data_t *preds[NUM_INDEX_LAYERS];
+
+    // Get predecessor, find its next, if != key return false
+    data_t *n = get_le(tx, key, preds);
+    if (n == nullptr)
+      return false;
+    auto found = n->tower[0].next.get(tx);
+    if (found == nullptr)
+      return false;
+    if (found == tail || found->key != key) {
+      res = false;
+      return true;
+    }
+
+    // Acquire the target, make sure it's not owned
+    if (!tx.acquire_consistent(found))
+      return false;
+    // Acquire the predecessor so we can edit its next pointer
+    if (!tx.acquire_consistent(n))
+      return false;
+
+    // Fast-path unstitch when it has height 0
+    if (found->height == 0) {
+      auto nxt = found->tower[0].next.get(tx);
+      n->tower[0].next.set(nxt, tx);
+      n->tower[0].key.set(nxt->key, tx);
+      // NB: don't forget to set `node`'s pointers to null!
+      found->tower[0].next.set(nullptr, tx);
+      tx.reclaim(found);
+      res = true;
+      return true;
+    }
+
+    // Slow-path unstitch when it's tall
+    res = index_unstitch(tx, me, found, n, preds);
+    return res;
+  }
+
+  /// Hand a request to the flat combiner, and apply batches of requests if this
+  /// thread becomes the combiner for the request's shard
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param req The request to publish
+  ///
+  /// @return The request's result
+  bool combine(STMCAS *me, fc_req_t &req) {
+    return fc.combine(me->hash(req.key), req,
+                      [&](fc_req_t *batch) { apply_batch(me, batch); });
+  }
+
+  /// As the combiner, apply a list of requests.  Each WSTEP applies as many
+  /// requests as it can, so that hot nodes are written once per batch instead
+  /// of once per request.  When a request can't be applied, the requests before
+  /// it are committed, and a new WSTEP picks up where the old one stopped.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param batch The requests to apply, in order
+  void apply_batch(STMCAS *me, fc_req_t *batch) {
+    while (batch) {
+      fc_req_t *first = batch;
+      {
+        WSTEP tx(me);
+        while (batch) {
+          bool ok = batch->kind == fc_req_t::INSERT
+                        ? insert_step(tx, me, batch->key, batch->val,
+                                      batch->aux, batch->result)
+                        : remove_step(tx, me, batch->key, batch->result);
+          if (!ok) {
+            // NB: Requests before `batch` have written, so we can only unwind
+            //     if there aren't any
+            if (batch == first)
+              tx.unwind();
+            break;
+          }
+          batch = batch->next;
+        }
+      }
+      // The WSTEP committed, so the applied requests can be completed
+      fc_t::finish(first, batch);
     }
   }
 
-private:
   /// get_leq uses the towers to skip from the head sentinel to the node
   /// with the largest key <= the search key.  It can return the head data
   /// sentinel, but not the tail sentinel.
@@ -321,9 +672,9 @@ private:
     return data_leq(tx, key, curr);
   }
 
-  /// A version of get_le that is specialized for remove, where we need to get
-  /// the predecessors at all levels
-  __attribute__((noinline)) data_t *get_le(WSTEP &tx, const K &key,
+  /// A version of get_le that is specialized for remove (and multi-key
+  /// planning), where we need to get the predecessors at all levels
+  __attribute__((noinline)) data_t *get_le(STEP &tx, const K &key,
                                            data_t **preds) {
     // We always start at the head sentinel.  Scan its tower to find the
     // highest non-tail level
@@ -506,7 +857,7 @@ private:
   /// @param level   The level below where we're stitching
   /// @param release Should `node` be marked UNOWNED before returning?
   bool index_stitch(WSTEP &tx, STMCAS *me, data_t *n, data_t *s, data_t **preds,
-                    const K &key, V &val, int target_height) {
+                    const K &key, const V &val, int target_height) {
     // acquire all the levels or fail.  n and s are already acquired
     for (int level = 0; level < target_height; ++level) {
       // preds[level] is actually a /level + 1/ height node
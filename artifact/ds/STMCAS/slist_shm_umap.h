@@ -0,0 +1,254 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+#include "../../policies/include/shm_region.h"
+
+/// A non-resizable hash table of singly-linked lists that lives in a
+/// shm_region_t, so that independent processes can attach to it and run
+/// lookups and updates directly.  This map supports get(), insert(), and
+/// remove() operations.
+///
+/// All links are shm_ptr_t offsets, and the table itself is found through the
+/// region's root, so each process may map the region at a different address.
+/// An slist_shm_umap object is only a per-process handle: the first one that is
+/// constructed creates the table, and every later one (in any process) attaches
+/// to it.
+///
+/// The lists follow the same STMCAS protocol as slist_omap, without snapshots.
+/// Each bucket's head sentinel is stored inline in one contiguous array.
+///
+/// NB: Keys and values are stored directly in the region, so they must be
+///     trivially copyable, and values must be scalar.
+///
+/// @param K      The type of the keys stored in this map
+/// @param V      The type of the values stored in this map
+/// @param STMCAS The STMCAS implementation (must be shm_stmcas_t)
+template <typename K, typename V, class STMCAS> class slist_shm_umap {
+  static_assert(std::is_trivially_copyable<K>::value,
+                "slist_shm_umap requires trivially copyable keys");
+  static_assert(std::is_scalar<V>::value,
+                "slist_shm_umap requires scalar values");
+
+  using WSTEP = typename STMCAS::WSTEP;
+  using RSTEP = typename STMCAS::RSTEP;
+  using ownable_t = typename STMCAS::ownable_t;
+  template <typename T> using FIELD = typename STMCAS::template sField<T>;
+
+  /// A list node.  It has a next pointer, but no key or value.  It's useful for
+  /// sentinels, so that K and V don't have to be default constructable.
+  struct node_t : ownable_t {
+    FIELD<shm_ptr_t<node_t>> next; // Offset of successor, or null at the end
+
+    /// Construct a node
+    node_t() : ownable_t(), next(shm_ptr_t<node_t>()) {}
+  };
+
+  /// A list node that also has a key and value.  Keys are const.  Values are
+  /// read atomically and validated, and only written while the node is locked.
+  struct data_t : public node_t {
+    const K key; // The key of this key/value pair
+    V val;       // The value of this key/value pair
+
+    /// Construct a data_t
+    ///
+    /// @param _key The key that is stored in this node
+    /// @param _val The value that is stored in this node
+    data_t(const K &_key, const V &_val) : node_t(), key(_key), val(_val) {}
+  };
+  static_assert(std::is_trivially_destructible<data_t>::value,
+                "shm_smr_t does not run destructors");
+
+  /// The shared part of the map, which the region's root refers to
+  struct table_t {
+    uint64_t num_buckets;      // The number of buckets in the table
+    shm_ptr_t<node_t> buckets; // The buckets' head sentinels, contiguously
+  };
+
+  /// The pair returned by predecessor queries: a node and it's observed version
+  struct leq_t {
+    node_t *_obj = nullptr; // The object
+    uint64_t _ver = 0;      // The observed version of the object
+  };
+
+  table_t *table;       // The table, in this process's mapping of the region
+  node_t *buckets;      // The buckets, in this process's mapping of the region
+  uint64_t num_buckets; // The number of buckets in the table
+
+public:
+  /// Attach to the map in the process's region, or create it if the region
+  /// doesn't have one yet
+  ///
+  /// @param me  The operation that is constructing the map
+  /// @param cfg A configuration object with a `buckets` field
+  slist_shm_umap(STMCAS *me, auto *cfg) {
+    auto &root = shm_region_t::root();
+    uint64_t off = root.load();
+    if (off == 0) {
+      // Build a table in the region.  The sentinels are unshared until the
+      // root is published, so they can be initialized without a WSTEP.
+      table_t *t = new (shm_region_t::alloc(sizeof(table_t))) table_t();
+      t->num_buckets = cfg->buckets;
+      node_t *b = static_cast<node_t *>(
+          shm_region_t::alloc(cfg->buckets * sizeof(node_t)));
+      for (uint64_t i = 0; i < t->num_buckets; ++i)
+        ::new (&b[i]) node_t();
+      t->buckets = b;
+      // If another process published a table first, use that one instead
+      off = shm_region_t::to_offset(t);
+      uint64_t expected = 0;
+      if (!root.compare_exchange_strong(expected, off))
+        off = expected;
+    }
+    table = static_cast<table_t *>(shm_region_t::from_offset(off));
+    buckets = table->buckets.get();
+    num_buckets = table->num_buckets;
+  }
+
+private:
+  /// Get the head sentinel of the bucket for `key`
+  node_t *bucket(STMCAS *me, const K &key) {
+    return &buckets[me->hash(std::hash<K>()(key)) % num_buckets];
+  }
+
+  /// get_leq is an inclusive predecessor query that returns the largest node
+  /// in `head`'s list whose key is <= the provided key.  It can return the
+  /// head sentinel.
+  ///
+  /// There is no atomicity between get_leq and its caller.  It returns the node
+  /// it found, along with the value of the orec for that node at the time it
+  /// was accessed.  The caller needs to validate the orec before using the
+  /// returned node.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param head    The head sentinel of the list to search
+  /// @param key     The key for which we are doing a predecessor query.
+  /// @param lt_mode When `true`, this behaves as `get_lt`.  When `false`, it
+  ///                behaves as `get_leq`.
+  ///
+  /// @return The node that was found, and its orec value
+  leq_t get_leq(STMCAS *me, node_t *head, const K key, bool lt_mode = false) {
+    while (true) {
+      RSTEP tx(me);
+      leq_t curr{head, tx.check_orec(head)};
+      if (curr._ver == STMCAS::END_OF_TIME)
+        continue;
+      while (true) {
+        // Read the next node, fail if we can't do it consistently
+        node_t *next = curr._obj->next.get(tx).get();
+        if (next == nullptr)
+          return curr;
+        uint64_t next_ver = tx.check_orec(next);
+        if (next_ver == STMCAS::END_OF_TIME)
+          break;
+
+        // Stop if next's key is too big, or if it's the match we want
+        data_t *dn = static_cast<data_t *>(next);
+        if (lt_mode ? dn->key >= key : dn->key > key)
+          return curr;
+        if (dn->key == key)
+          return {next, next_ver};
+        curr = {next, next_ver};
+      }
+    }
+  }
+
+public:
+  /// Search the data structure for a node with key `key`.  If not found, return
+  /// false.  If found, return true, and set `val` to the value associated with
+  /// `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(STMCAS *me, const K &key, V &val) {
+    node_t *head = bucket(me, key);
+    while (true) {
+      auto n = get_leq(me, head, key);
+      if (n._obj == head || static_cast<data_t *>(n._obj)->key != key)
+        return false;
+
+      // Read the value atomically, then validate
+      RSTEP tx(me);
+      data_t *dn = static_cast<data_t *>(n._obj);
+      V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->val)->load(
+          std::memory_order_acquire);
+      if (!tx.check_continuation(n._obj, n._ver))
+        continue;
+      val = val_copy;
+      return true;
+    }
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(STMCAS *me, const K &key, V &val) {
+    node_t *head = bucket(me, key);
+    while (true) {
+      auto n = get_leq(me, head, key);
+      if (n._obj != head && static_cast<data_t *>(n._obj)->key == key)
+        return false;
+
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(n._obj, n._ver)) {
+        tx.unwind();
+        continue;
+      }
+
+      // stitch in a new node, allocated from the region
+      data_t *new_dn = new data_t(key, val);
+      new_dn->next.set(n._obj->next.get(tx), tx);
+      n._obj->next.set(new_dn, tx);
+      return true;
+    }
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(STMCAS *me, const K &key) {
+    node_t *head = bucket(me, key);
+    while (true) {
+      // NB: this will be a lt query, not a leq query
+      auto prev = get_leq(me, head, key, true);
+
+      WSTEP tx(me);
+      if (!tx.acquire_continuation(prev._obj, prev._ver)) {
+        tx.unwind();
+        continue;
+      }
+      node_t *curr = prev._obj->next.get(tx).get();
+
+      // if curr doesn't have a matching key, fail
+      if (curr == nullptr || static_cast<data_t *>(curr)->key != key) {
+        tx.unwind();
+        return false;
+      }
+
+      // lock the node to remove, then unstitch it
+      if (!tx.acquire_aggressive(curr)) {
+        tx.unwind();
+        continue;
+      }
+      prev._obj->next.set(curr->next.get(tx), tx);
+      tx.reclaim(curr);
+      return true;
+    }
+  }
+};
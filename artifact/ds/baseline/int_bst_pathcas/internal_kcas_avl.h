@@ -10,6 +10,7 @@
 #define MAX_KCAS 21
 #include "kcas.h"
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <immintrin.h>
@@ -19,7 +20,6 @@
 
 using namespace std;
 
-#define MAX_THREADS 200
 #define MAX_PATH_SIZE 16384
 #define PADDING_BYTES 128
 
@@ -44,8 +44,8 @@ enum RetCode : int {
   SUCCESS_WITH_HEIGHT_UPDATE = 2
 };
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 class InternalKCAS {
 private:
   /*
@@ -78,7 +78,9 @@ private:
   volatile char padding5[PADDING_BYTES];
   RecordManager *const recmgr;
   volatile char padding7[PADDING_BYTES];
-  PathContainer paths[MAX_THREADS];
+  // One path per thread, indexed by the descriptor's tid, and sized at
+  // construction time from the benchmark's thread counts
+  PathContainer *const paths;
   volatile char padding8[PADDING_BYTES];
 
 public:
@@ -167,10 +169,10 @@ private:
   int fixHeight(const int tid, ObservedNode &observedNode);
 };
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 Node<K, V, RecordManager> *
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::createNode(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::createNode(
     const int tid, Node<K, V, RecordManager> *parent, K key, V value) {
   Node<K, V, RecordManager> *node = new Node<K, V, RecordManager>();
   // No node, save for root, should have a NULL parent
@@ -185,54 +187,54 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::createNode(
   return node;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::InternalKCAS(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::InternalKCAS(
     RecordManager *_recmgr, auto *cfg)
-    : numThreads(_numThreads), minKey(_minKey), maxKey(_maxKey),
-      recmgr(_recmgr) {
-  assert(_numThreads < MAX_THREADS);
+    : numThreads(std::max(cfg->nthreads, cfg->wthreads)), minKey(_minKey),
+      maxKey(_maxKey), recmgr(_recmgr),
+      paths(new PathContainer[numThreads]) {
   int tid = 0;
   initThread(tid);
   root = createNode(0, NULL, maxKey, 0);
   init = true;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
-             _maxKey>::~InternalKCAS() {
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::~InternalKCAS() {
   int tid = 0;
   initThread(tid);
   freeSubtree(tid, root);
   deinitThread(tid);
+  delete[] paths;
   // delete recmgr;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline Node<K, V, RecordManager> *
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getRoot() {
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::getRoot() {
   return root->left;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::initThread(const int tid) {
   // recmgr->initThread(tid);
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::deinitThread(const int tid) {
   // recmgr->deinitThread(tid);
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getHeight(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::getHeight(
     Node<K, V, RecordManager> *node) {
   return node == NULL ? 0 : node->height;
 }
@@ -244,10 +246,10 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getHeight(
  * Returns an integer, 1 indicating the process was successful, 0 indicating a
  * retry
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline int
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getSuccessor(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::getSuccessor(
     const int tid, Node<K, V, RecordManager> *node, ObservedNode &oSucc,
     const K &key) {
   auto &path = paths[tid].path;
@@ -275,10 +277,10 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getSuccessor(
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline bool
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::contains(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::contains(
     const int tid, const K &key) {
   assert(key <= maxKey);
   int result;
@@ -299,15 +301,16 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::contains(
  * Where appropriate, the predecessor (predObserved), parent (parentObserved)
  * and node (nodeObserved) are provided to the caller.
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::search(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::search(
     const int tid, ObservedNode &oParent, ObservedNode &oNode, const K &key) {
   assert(key <= maxKey);
 
   K currKey;
   casword_t nodeVNumMark;
 
+  assert(tid >= 0 && tid < numThreads);
   ObservedNode *path = paths[tid].path;
   path[0].node = root;
   path[0].oVNumMark = root->vNumMark;
@@ -359,10 +362,10 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::search(
  * valid path Returns false for an invalid path (some node version number
  * changed)
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline bool
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::validatePath(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::validatePath(
     const int tid, const int &size, const K &key, ObservedNode path[]) {
   assert(size > 0 && size < MAX_PATH_SIZE);
 
@@ -375,9 +378,9 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::validatePath(
   return true;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-inline V InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+inline V InternalKCAS<RecordManager, K, V, _minKey,
                       _maxKey>::insertIfAbsent(const int tid, const K &key,
                                                const V &value) {
   ObservedNode oParent;
@@ -402,9 +405,9 @@ inline V InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::internalInsert(const int tid, ObservedNode &oParent,
                                           const K &key, const V &value) {
   /* INSERT KCAS (K = 2-3)
@@ -439,10 +442,10 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::RETRY;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline V
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::erase(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::erase(
     const int tid, const K &key) {
   ObservedNode oParent;
   ObservedNode oNode;
@@ -466,9 +469,9 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::erase(
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::internalErase(const int tid, ObservedNode &oParent,
                                          ObservedNode &oNode, const K &key) {
   Node<K, V, RecordManager> *parent = oParent.node;
@@ -637,9 +640,9 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::RETRY;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::
     fixHeightAndRebalance(const int tid, Node<K, V, RecordManager> *node) {
   ObservedNode oNode;
   ObservedNode oParent;
@@ -769,9 +772,9 @@ void InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::
   return;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::fixHeight(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::fixHeight(
     const int tid, ObservedNode &oNode) {
 
   Node<K, V, RecordManager> *node = oNode.node;
@@ -818,9 +821,9 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::fixHeight(
   return RetCode::FAILURE;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::rotateRight(const int tid, ObservedNode &oParent,
                                        ObservedNode &oNode,
                                        ObservedNode &oLeft) {
@@ -878,9 +881,9 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::FAILURE;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::rotateLeft(const int tid, ObservedNode &oParent,
                                       ObservedNode &oNode,
                                       ObservedNode &oRight) {
@@ -938,9 +941,9 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::FAILURE;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::rotateLeftRight(const int tid, ObservedNode &oParent,
                                            ObservedNode &oNode,
                                            ObservedNode &oLeft,
@@ -1014,9 +1017,9 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::FAILURE;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::rotateRightLeft(const int tid, ObservedNode &oParent,
                                            ObservedNode &oNode,
                                            ObservedNode &oRight,
@@ -1097,17 +1100,17 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::FAILURE;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline int
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::countChildren(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::countChildren(
     const int tid, Node<K, V, RecordManager> *node) {
   return (node->left == NULL ? 0 : 1) + (node->right == NULL ? 0 : 1);
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-long InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+long InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::validateSubtree(Node<K, V, RecordManager> *node,
                                             long smaller, long larger,
                                             std::unordered_set<casword_t> &keys,
@@ -1200,9 +1203,9 @@ long InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return ret;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-bool InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+bool InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::validate() {
   std::unordered_set<casword_t> keys = {};
   bool errorFound;
@@ -1233,14 +1236,14 @@ bool InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return !errorFound;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::printDebuggingDetails() {}
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::freeSubtree(const int tid,
                                         Node<K, V, RecordManager> *node) {
   if (node == NULL)
@@ -9,6 +9,7 @@
 #define MAX_KCAS 16
 #include "kcas.h"
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
@@ -17,7 +18,6 @@
 
 using namespace std;
 
-#define MAX_THREADS 200
 #define MAX_PATH_SIZE 16384
 #define PADDING_BYTES 128
 #define KCAS_MAX_K 16
@@ -41,8 +41,8 @@ enum RetCode : int {
   SUCCESS_WITH_HEIGHT_UPDATE = 2
 };
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 class InternalKCAS {
 private:
   /*
@@ -76,7 +76,9 @@ private:
   volatile char padding5[PADDING_BYTES];
   RecordManager *const recmgr;
   volatile char padding7[PADDING_BYTES];
-  PathContainer paths[MAX_THREADS];
+  // One path per thread, indexed by the descriptor's tid, and sized at
+  // construction time from the benchmark's thread counts
+  PathContainer *const paths;
   volatile char padding8[PADDING_BYTES];
 
 public:
@@ -144,10 +146,10 @@ private:
              const K &key);
 };
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 Node<K, V, RecordManager> *
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::createNode(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::createNode(
     const int tid, K key, V value) {
   Node<K, V, RecordManager> *node =
       new Node<K, V, RecordManager>(); // recmgr->template allocate<Node<K, V,
@@ -161,44 +163,45 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::createNode(
   return node;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::InternalKCAS(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::InternalKCAS(
     RecordManager *_recmgr, auto *cfg)
-    : numThreads(_numThreads), minKey(_minKey), maxKey(_maxKey),
-      recmgr(_recmgr) {
+    : numThreads(std::max(cfg->nthreads, cfg->wthreads)), minKey(_minKey),
+      maxKey(_maxKey), recmgr(_recmgr),
+      paths(new PathContainer[numThreads]) {
 
   // root = createNode(0, (maxKey + 1 & 0x00FFFFFFFFFFFFFF), NULL);
   root = createNode(0, maxKey, 0);
   init = true;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
-             _maxKey>::~InternalKCAS() {
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::~InternalKCAS() {
   // auto guard = recmgr->getGuard(tid);
   freeSubtree(0, root);
+  delete[] paths;
   // delete recmgr;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline Node<K, V, RecordManager> *
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getRoot() {
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::getRoot() {
   return root->left;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::initThread(const int tid) {
   // recmgr->initThread(tid);
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::deinitThread(const int tid) {
   // recmgr->deinitThread(tid);
 }
@@ -210,10 +213,10 @@ void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
  * Returns an integer, 1 indicating the process was successful, 0 indicating a
  * retry
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline int
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getSuccessor(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::getSuccessor(
     const int tid, Node<K, V, RecordManager> *node, ObservedNode &oSucc,
     ObservedNode &oSuccParent, const K &key) {
   ObservedNode path[MAX_PATH_SIZE];
@@ -246,10 +249,10 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::getSuccessor(
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline bool
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::contains(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::contains(
     const int tid, const K &key) {
   assert(key <= maxKey);
   int result;
@@ -270,9 +273,9 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::contains(
  * Where appropriate, the predecessor (predObserved), parent (parentObserved)
  * and node (nodeObserved) are provided to the caller.
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::search(
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::search(
     const int tid, ObservedNode &oPred, ObservedNode &oParent,
     ObservedNode &oNode, const K &key) {
   assert(key <= maxKey);
@@ -280,6 +283,7 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::search(
   K currKey;
   casword_t nodeVNumMark;
 
+  assert(tid >= 0 && tid < numThreads);
   ObservedNode *path = paths[tid].path;
   path[0].node = root;
   path[0].oVNumMark = root->vNumMark;
@@ -353,10 +357,10 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::search(
  * valid path Returns false for an invalid path (some node version number
  * changed)
  */
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline bool
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::validatePath(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::validatePath(
     const int tid, const int &size, const K &key, ObservedNode *path) {
   assert(size > 0);
 
@@ -369,9 +373,9 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::validatePath(
   return true;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-inline V InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+inline V InternalKCAS<RecordManager, K, V, _minKey,
                       _maxKey>::insertIfAbsent(const int tid, const K &key,
                                                const V &value) {
   ObservedNode oParent;
@@ -397,9 +401,9 @@ inline V InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::internalInsert(const int tid, ObservedNode &oPred,
                                           ObservedNode &oParent, const K &key,
                                           const V &value) {
@@ -443,10 +447,10 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::RETRY;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline V
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::erase(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::erase(
     const int tid, const K &key) {
   ObservedNode oPred;
   ObservedNode oParent;
@@ -470,9 +474,9 @@ InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::erase(
   }
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+int InternalKCAS<RecordManager, K, V, _minKey,
                  _maxKey>::internalErase(const int tid, ObservedNode &oParent,
                                          ObservedNode &oNode, const K &key) {
   Node<K, V, RecordManager> *parent = oParent.node;
@@ -645,17 +649,17 @@ int InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return RetCode::RETRY;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
 inline int
-InternalKCAS<RecordManager, K, V, _numThreads, _minKey, _maxKey>::countChildren(
+InternalKCAS<RecordManager, K, V, _minKey, _maxKey>::countChildren(
     const int tid, Node<K, V, RecordManager> *node) {
   return (node->left == NULL ? 0 : 1) + (node->right == NULL ? 0 : 1);
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-long InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+long InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::validateSubtree(Node<K, V, RecordManager> *node,
                                             long smaller, long larger,
                                             std::unordered_set<casword_t> &keys,
@@ -716,9 +720,9 @@ long InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return ret;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-bool InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+bool InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::validate() {
   std::unordered_set<casword_t> keys = {};
   bool errorFound = false;
@@ -749,14 +753,14 @@ bool InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
   return !errorFound;
 }
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::printDebuggingDetails() {}
 
-template <class RecordManager, typename K, typename V, int _numThreads,
-          int _minKey, std::int64_t _maxKey>
-void InternalKCAS<RecordManager, K, V, _numThreads, _minKey,
+template <class RecordManager, typename K, typename V, int _minKey,
+          std::int64_t _maxKey>
+void InternalKCAS<RecordManager, K, V, _minKey,
                   _maxKey>::freeSubtree(const int tid,
                                         Node<K, V, RecordManager> *node) {
   if (node == NULL)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <immintrin.h>
 #include <sstream>
@@ -182,7 +184,12 @@ typedef intptr_t seqbits_t;
 #define HTM_BAD_OLD_VAL 30
 #define MAX_RETRIES 5
 
-#define KCAS_MAX_THREADS 500
+// KCAS descriptors are indexed by TID, and a tagged pointer only has room for
+// TIDs up to LAST_TID.  LAST_TID is reserved for dummy descriptors, and the TID
+// below it for a static descriptor, so threads get the rest.
+#define KCAS_MAX_THREADS (LAST_TID - 1)
+static_assert(KCAS_MAX_THREADS > 0 && KCAS_MAX_THREADS < LAST_TID,
+              "thread TIDs must fit in the TID bits of a tagged pointer");
 
 void *volatile thread_ids[KCAS_MAX_THREADS] = {};
 
@@ -194,11 +201,14 @@ public:
     int i;
     while (true) {
       i = 0;
-      while (thread_ids[i]) {
+      while (i < KCAS_MAX_THREADS && thread_ids[i]) {
         ++i;
       }
 
-      assert(i < KCAS_MAX_THREADS);
+      if (i == KCAS_MAX_THREADS) {
+        fprintf(stderr, "KCAS supports at most %d threads\n", KCAS_MAX_THREADS);
+        exit(1);
+      }
       if (__sync_bool_compare_and_swap(&thread_ids[i], 0, this)) {
         myslot = i;
         break;
@@ -536,6 +536,31 @@ bool set_lookup(set_t *l, setkey_t k, setval_t &v) {
   return res;
 }
 
+/* Replace the value of key @k, if it is present.  Unlike set_update(), this
+ * never inserts. */
+bool set_replace(set_t *l, setkey_t k, setval_t v) {
+  ptst_t *ptst;
+  node_t *x;
+  setval_t ov;
+  bool res = false;
+
+  k = CALLER_TO_INTERNAL_KEY(k);
+
+  ptst = critical_enter();
+
+  x = weak_search_predecessors(l, k, NULL, NULL);
+  if (x->k == k) {
+    /* A NULL value means that the node is being deleted. */
+    ov = x->v;
+    while (ov != NULL && !x->v.compare_exchange_weak(ov, v)) {
+    }
+    res = ov != NULL;
+  }
+  critical_exit(ptst);
+
+  return res;
+}
+
 template <typename K, typename V, class DESCRIPTOR> class fraser_skiplist {
   set_t *sl;
 
@@ -554,6 +579,10 @@ public:
     return set_update(sl, k, v, 0);
   }
 
+  bool update(DESCRIPTOR *me, const K &k, V &v) {
+    return set_replace(sl, k, v);
+  }
+
   bool remove(DESCRIPTOR *me, const K &k) {
     V v;
     return set_remove(sl, k, v);
@@ -457,7 +457,9 @@ public:
       return true;
     }
 
+    EXO_TRACE(tracer_t::RESIZE_BEGIN);
     resize(me, a_tbl);
+    EXO_TRACE(tracer_t::RESIZE_END);
     return true;
   }
 
@@ -42,6 +42,11 @@ template <typename K, typename V, class HANDSTM> class dlist_omap {
     virtual ~data_t() {}
   };
 
+  // The sentinels are stored inline, so that a list has no separate
+  // allocations until it holds data.  This lets hash tables keep their buckets
+  // (and the head sentinels' orecs) in one contiguous array.
+  node_t head_node;   // The head sentinel
+  node_t tail_node;   // The tail sentinel
   node_t *const head; // The list head pointer
   node_t *const tail; // The list tail pointer
 
@@ -50,7 +55,7 @@ public:
   ///
   /// @param me  The operation that is constructing the list
   /// @param cfg A configuration object
-  dlist_omap(HANDSTM *me, auto *cfg) : head(new node_t()), tail(new node_t()) {
+  dlist_omap(HANDSTM *me, auto *cfg) : head(&head_node), tail(&tail_node) {
     BEGIN_WO(me);
     head->next.set(wo, head, tail);
     tail->prev.set(wo, tail, head);
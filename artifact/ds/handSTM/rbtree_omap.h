@@ -1,7 +1,7 @@
 #pragma once
 
 /// An ordered map, implemented as a balanced, internal binary search tree. This
-/// map supports get(), insert(), and remove() operations.
+/// map supports get(), get_geq(), insert(), update(), and remove() operations.
 ///
 /// @param K          The type of the keys stored in this map
 /// @param V          The type of the values stored in this map
@@ -59,6 +59,39 @@ public:
     return res;
   }
 
+  // find the smallest key that is not less than `key`, and its value
+  bool get_geq(HANDSTM *me, const K &key, K &found, V &val) const {
+    BEGIN_RO(me);
+    bool res = false;
+    node_t *curr = sentinel->child[0].get(ro, sentinel);
+    while (curr != nullptr) {
+      K ckey = curr->key.get(ro, curr);
+      if (ckey < key) {
+        curr = curr->child[1].get(ro, curr);
+        continue;
+      }
+      res = true;
+      found = ckey;
+      val = curr->val.get(ro, curr);
+      if (ckey == key)
+        break;
+      curr = curr->child[0].get(ro, curr);
+    }
+    return res;
+  }
+
+  // replace the value of the node with key `key`, if there is one
+  bool update(HANDSTM *me, const K &key, V &val) {
+    BEGIN_WO(me);
+    node_t *curr = sentinel->child[0].get(wo, sentinel);
+    while (curr != nullptr && curr->key.get(wo, curr) != key)
+      curr = curr->child[(key < curr->key.get(wo, curr)) ? 0 : 1].get(wo, curr);
+    if (curr == nullptr)
+      return false;
+    curr->val.set(wo, curr, val);
+    return true;
+  }
+
   // insert a node with k/v as its pair if no such key exists in the tree
   bool insert(HANDSTM *me, const K &key, V &val) {
     bool res = false;
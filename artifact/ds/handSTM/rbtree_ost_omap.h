@@ -0,0 +1,499 @@
+#pragma once
+
+/// An ordered map, implemented as a balanced, internal binary search tree,
+/// augmented with the size of each node's subtree.  In addition to get(),
+/// insert(), and remove(), this map supports the order-statistic queries
+/// rank(), select(), and count(), each in O(log n).
+///
+/// This is rbtree_omap.h, plus the code for maintaining sizes.  Inserts and
+/// removes adjust the size of every ancestor of the node they add or remove,
+/// and rotations recompute the sizes of the two nodes they move, all in the
+/// same transaction as the update.  The price is that every update writes the
+/// root, so updates no longer scale, and a long query can be aborted by any
+/// update.
+///
+/// @param K          The type of the keys stored in this map
+/// @param V          The type of the values stored in this map
+/// @param HANDSTM    A thread descriptor type, for safe memory reclamation
+/// @param dummy_key  A default key to use
+/// @param dummy_val  A default value to use
+template <typename K, typename V, class HANDSTM, K dummy_key, V dummy_val>
+class rbtree_ost_omap {
+  using WOSTM = typename HANDSTM::WOSTM;
+  using ROSTM = typename HANDSTM::ROSTM;
+  using STM = typename HANDSTM::STM;
+  using ownable_t = typename HANDSTM::ownable_t;
+  template <typename T> using FIELD = typename HANDSTM::template xField<T>;
+
+  static const int RED = 0;   // Enum for red
+  static const int BLACK = 1; // Enum for black
+
+  /// nodes in a red/black tree
+  struct node_t : ownable_t {
+    FIELD<K> key;             // Key stored at this node
+    FIELD<V> val;             // Value stored at this node
+    FIELD<int> color;         // color (RED or BLACK)
+    FIELD<node_t *> parent;   // pointer to parent
+    FIELD<int> ID;            // 0/1 for left/right child
+    FIELD<node_t *> child[2]; // L/R children
+    FIELD<uint64_t> size;     // # nodes in the subtree rooted here
+
+    /// basic constructor
+    node_t(WOSTM &wo, int color, K key, V val, node_t *parent, long ID,
+           node_t *child0, node_t *child1)
+        : key(key), val(val), color(color), parent(parent), ID(ID), size(1) {
+      child[0].set(wo, this, child0);
+      child[1].set(wo, this, child1);
+    }
+  };
+
+  node_t *sentinel; // The (sentinel) root node of the tree
+
+  /// Get the number of nodes in a subtree
+  ///
+  /// @param tx An active transaction
+  /// @param n  The root of the subtree, or nullptr
+  ///
+  /// @return The size of the subtree (0 if `n` is nullptr)
+  uint64_t size_of(STM &tx, node_t *n) const {
+    return n ? n->size.get(tx, n) : 0;
+  }
+
+  /// Recompute a node's size from its children's sizes.  Rotations call this
+  /// on the node that moved down, and then on the node that moved up.
+  ///
+  /// @param wo An active writing transaction
+  /// @param n  The node whose size should be fixed
+  void fix_size(WOSTM &wo, node_t *n) {
+    n->size.set(wo, n,
+                size_of(wo, n->child[0].get(wo, n)) +
+                    size_of(wo, n->child[1].get(wo, n)) + 1);
+  }
+
+  /// Add to the size of a node and each of its ancestors, up to the root
+  ///
+  /// @param wo    An active writing transaction
+  /// @param n     The deepest node to update
+  /// @param delta The amount to add to each size (1 or -1)
+  void add_to_path(WOSTM &wo, node_t *n, int delta) {
+    for (; n != sentinel; n = n->parent.get(wo, n))
+      n->size.set(wo, n, n->size.get(wo, n) + delta);
+  }
+
+  /// Count the keys that are less than `key`, or less than or equal to it if
+  /// `inclusive` is true
+  ///
+  /// @param tx        An active transaction
+  /// @param key       The key to compare to
+  /// @param inclusive Should a node whose key equals `key` be counted?
+  ///
+  /// @return The number of keys that were counted
+  uint64_t count_below(STM &tx, const K &key, bool inclusive) const {
+    uint64_t res = 0;
+    node_t *curr = sentinel->child[0].get(tx, sentinel);
+    while (curr != nullptr) {
+      K ckey = curr->key.get(tx, curr);
+      if (ckey < key || (inclusive && ckey == key)) {
+        res += size_of(tx, curr->child[0].get(tx, curr)) + 1;
+        curr = curr->child[1].get(tx, curr);
+      } else {
+        curr = curr->child[0].get(tx, curr);
+      }
+    }
+    return res;
+  }
+
+public:
+  /// Construct a list by creating a sentinel node at the head
+  rbtree_ost_omap(HANDSTM *me, auto *) {
+    BEGIN_WO(me);
+    sentinel = new node_t(wo, BLACK, dummy_key, dummy_val, nullptr, 0, nullptr,
+                          nullptr);
+  }
+
+  // binary search for the node that has v as its value
+  bool get(HANDSTM *me, const K &key, V &val) const {
+    BEGIN_RO(me);
+    node_t *curr = sentinel->child[0].get(ro, sentinel);
+    while (curr != nullptr && curr->key.get(ro, curr) != key)
+      curr = curr->child[(key < curr->key.get(ro, curr)) ? 0 : 1].get(ro, curr);
+    bool res = (curr != nullptr) && (curr->key.get(ro, curr) == key);
+    if (res)
+      val = curr->val.get(ro, curr);
+    return res;
+  }
+
+  // insert a node with k/v as its pair if no such key exists in the tree
+  bool insert(HANDSTM *me, const K &key, V &val) {
+    bool res = false;
+    {
+      BEGIN_WO(me);
+      // find insertion point
+      node_t *curr = sentinel;
+      int cID = 0;
+      node_t *child = curr->child[cID].get(wo, curr);
+      while (child != nullptr) {
+        long ckey = child->key.get(wo, child);
+        if (ckey == key)
+          return false;
+        cID = key < ckey ? 0 : 1;
+        curr = child;
+        child = curr->child[cID].get(wo, curr);
+      }
+
+      // make a red node and connect it to `curr`
+      res = true;
+      child = new node_t(wo, RED, key, val, curr, cID, nullptr, nullptr);
+      curr->child[cID].set(wo, curr, child);
+      add_to_path(wo, curr, 1);
+
+      // balance the tree
+      while (true) {
+        // Get the parent, grandparent, and their relationship
+        node_t *parent = child->parent.get(wo, child);
+        int pID = parent->ID.get(wo, parent);
+        node_t *gparent = parent->parent.get(wo, parent);
+
+        // Easy exit condition: no more propagation needed
+        if ((gparent == sentinel) || (BLACK == parent->color.get(wo, parent)))
+          break;
+
+        // If parent's sibling is also red, we push red up to grandparent
+        node_t *psib = gparent->child[1 - pID].get(wo, gparent);
+        if ((psib != nullptr) && (RED == psib->color.get(wo, psib))) {
+          parent->color.set(wo, parent, BLACK);
+          psib->color.set(wo, psib, BLACK);
+          gparent->color.set(wo, gparent, RED);
+          child = gparent;
+          continue; // restart loop at gparent level
+        }
+
+        int cID = child->ID.get(wo, child);
+        if (cID != pID) {
+          // set child's child to parent's cID'th child
+          node_t *baby = child->child[1 - cID].get(wo, child);
+          parent->child[cID].set(wo, parent, baby);
+          if (baby != nullptr) {
+            baby->parent.set(wo, baby, parent);
+            baby->ID.set(wo, baby, cID);
+          }
+          // move parent into baby's position as a child of child
+          child->child[1 - cID].set(wo, child, parent);
+          parent->parent.set(wo, parent, child);
+          parent->ID.set(wo, parent, 1 - cID);
+          // move child into parent's spot as pID'th child of gparent
+          gparent->child[pID].set(wo, gparent, child);
+          child->parent.set(wo, child, gparent);
+          child->ID.set(wo, child, pID);
+          fix_size(wo, parent);
+          fix_size(wo, child);
+          // now swap child with curr and fall through
+          node_t *temp = child;
+          child = parent;
+          parent = temp;
+        }
+
+        parent->color.set(wo, parent, BLACK);
+        gparent->color.set(wo, gparent, RED);
+        // promote parent
+        node_t *ggparent = gparent->parent.get(wo, gparent);
+        int gID = gparent->ID.get(wo, gparent);
+        node_t *ochild = parent->child[1 - pID].get(wo, parent);
+        // make gparent's pIDth child ochild
+        gparent->child[pID].set(wo, gparent, ochild);
+        if (ochild != nullptr) {
+          ochild->parent.set(wo, ochild, gparent);
+          ochild->ID.set(wo, ochild, pID);
+        }
+        // make gparent the 1-pID'th child of parent
+        parent->child[1 - pID].set(wo, parent, gparent);
+        gparent->parent.set(wo, gparent, parent);
+        gparent->ID.set(wo, gparent, 1 - pID);
+        // make parent the gIDth child of ggparent
+        ggparent->child[gID].set(wo, ggparent, parent);
+        parent->parent.set(wo, parent, ggparent);
+        parent->ID.set(wo, parent, gID);
+        fix_size(wo, gparent);
+        fix_size(wo, parent);
+      }
+
+      // now just set the root to black
+      node_t *root = sentinel->child[0].get(wo, sentinel);
+      if (root->color.get(wo, root) != BLACK)
+        root->color.set(wo, root, BLACK);
+    }
+
+    return res;
+  }
+
+  // remove the node with k as its key if it exists in the tree
+  bool remove(HANDSTM *me, const K &key) {
+    BEGIN_WO(me);
+    // find key
+    node_t *curr = sentinel->child[0].get(wo, sentinel);
+
+    while (curr != nullptr) {
+      int ckey = curr->key.get(wo, curr);
+      if (ckey == key)
+        break;
+      curr = curr->child[key < ckey ? 0 : 1].get(wo, curr);
+    }
+
+    // if we didn't find v, we're done
+    if (curr == nullptr)
+      return false;
+
+    // If `curr` has two children, we need to swap it with its successor
+    if ((curr->child[1].get(wo, curr) != nullptr) &&
+        ((curr->child[0].get(wo, curr)) != nullptr)) {
+      node_t *leftmost = curr->child[1].get(wo, curr);
+      while (leftmost->child[0].get(wo, leftmost) != nullptr)
+        leftmost = leftmost->child[0].get(wo, leftmost);
+      curr->key.set(wo, curr, leftmost->key.get(wo, leftmost));
+      curr->val.set(wo, curr, leftmost->val.get(wo, leftmost));
+      curr = leftmost;
+    }
+
+    // extract x from the tree and prep it for deletion
+    node_t *parent = curr->parent.get(wo, curr);
+    node_t *child =
+        curr->child[(curr->child[0].get(wo, curr) != nullptr) ? 0 : 1].get(
+            wo, curr);
+    int xID = curr->ID.get(wo, curr);
+    parent->child[xID].set(wo, parent, child);
+    if (child != nullptr) {
+      child->parent.set(wo, child, parent);
+      child->ID.set(wo, child, xID);
+    }
+    add_to_path(wo, parent, -1);
+
+    // fix black height violations
+    if ((BLACK == curr->color.get(wo, curr)) && (child != nullptr)) {
+      if (RED == child->color.get(wo, child)) {
+        curr->color.set(wo, curr, RED);
+        child->color.set(wo, child, BLACK);
+      }
+    }
+
+    // rebalance... be sure to save the deletion target!
+    node_t *to_delete = curr;
+    while (true) {
+      parent = curr->parent.get(wo, curr);
+      if ((parent == sentinel) || (RED == curr->color.get(wo, curr)))
+        break;
+      int cID = curr->ID.get(wo, curr);
+      node_t *sibling = parent->child[1 - cID].get(wo, parent);
+
+      // we'd like y's sibling s to be black
+      // if it's not, promote it and recolor
+      if (RED == sibling->color.get(wo, sibling)) {
+        /*
+            Bp          Bs
+           / \         / \
+          By  Rs  =>  Rp  B2
+          / \        / \
+         B1 B2     By  B1
+       */
+        parent->color.set(wo, parent, RED);
+        sibling->color.set(wo, sibling, BLACK);
+        // promote sibling
+        node_t *gparent = parent->parent.get(wo, parent);
+        int pID = parent->ID.get(wo, parent);
+        node_t *nephew = sibling->child[cID].get(wo, sibling);
+        // set nephew as 1-cID child of parent
+        parent->child[1 - cID].set(wo, parent, nephew);
+        nephew->parent.set(wo, nephew, parent);
+        nephew->ID.set(wo, nephew, 1 - cID);
+        // make parent the cID child of the sibling
+        sibling->child[cID].set(wo, sibling, parent);
+        parent->parent.set(wo, parent, sibling);
+        parent->ID.set(wo, parent, cID);
+        // make sibling the pID child of gparent
+        gparent->child[pID].set(wo, gparent, sibling);
+        sibling->parent.set(wo, sibling, gparent);
+        sibling->ID.set(wo, sibling, pID);
+        fix_size(wo, parent);
+        fix_size(wo, sibling);
+        // reset sibling
+        sibling = nephew;
+      }
+
+      // Handle when the far nephew is red
+      node_t *n = sibling->child[1 - cID].get(wo, sibling);
+      if ((n != nullptr) && (RED == (n->color.get(wo, n)))) {
+        /*
+           ?p          ?s
+           / \         / \
+          By  Bs  =>  Bp  Bn
+         / \         / \
+        ?1 Rn      By  ?1
+        */
+        sibling->color.set(wo, sibling, parent->color.get(wo, parent));
+        parent->color.set(wo, parent, BLACK);
+        n->color.set(wo, n, BLACK);
+        // promote sibling
+        node_t *gparent = parent->parent.get(wo, parent);
+        int pID = parent->ID.get(wo, parent);
+        node_t *nephew = sibling->child[cID].get(wo, sibling);
+        // make nephew the 1-cID child of parent
+        parent->child[1 - cID].set(wo, parent, nephew);
+        if (nephew != nullptr) {
+          nephew->parent.set(wo, nephew, parent);
+          nephew->ID.set(wo, nephew, 1 - cID);
+        }
+        // make parent the cID child of the sibling
+        sibling->child[cID].set(wo, sibling, parent);
+        parent->parent.set(wo, parent, sibling);
+        parent->ID.set(wo, parent, cID);
+        // make sibling the pID child of gparent
+        gparent->child[pID].set(wo, gparent, sibling);
+        sibling->parent.set(wo, sibling, gparent);
+        sibling->ID.set(wo, sibling, pID);
+        fix_size(wo, parent);
+        fix_size(wo, sibling);
+        break; // problem solved
+      }
+
+      n = sibling->child[cID].get(wo, sibling);
+      if ((n != nullptr) && (RED == (n->color.get(wo, n)))) {
+        /*
+             ?p          ?p
+             / \         / \
+           By  Bs  =>  By  Bn
+               / \           \
+              Rn B1          Rs
+                               \
+                               B1
+        */
+        sibling->color.set(wo, sibling, RED);
+        n->color.set(wo, n, BLACK);
+        // promote n
+        node_t *gneph = n->child[1 - cID].get(wo, n);
+        // make gneph the cID child of sibling
+        sibling->child[cID].set(wo, sibling, gneph);
+        if (gneph != nullptr) {
+          gneph->parent.set(wo, gneph, sibling);
+          gneph->ID.set(wo, gneph, cID);
+        }
+        // make sibling the 1-cID child of n
+        n->child[1 - cID].set(wo, n, sibling);
+        sibling->parent.set(wo, sibling, n);
+        sibling->ID.set(wo, sibling, 1 - cID);
+        // make n the 1-cID child of parent
+        parent->child[1 - cID].set(wo, parent, n);
+        n->parent.set(wo, n, parent);
+        n->ID.set(wo, n, 1 - cID);
+        fix_size(wo, sibling);
+        fix_size(wo, n);
+        // swap sibling and `n`
+        node_t *temp = sibling;
+        sibling = n;
+        n = temp;
+
+        // now the far nephew is red... copy of code from above
+        sibling->color.set(wo, sibling, parent->color.get(wo, parent));
+        parent->color.set(wo, parent, BLACK);
+        n->color.set(wo, n, BLACK);
+        // promote sibling
+        node_t *gparent = parent->parent.get(wo, parent);
+        int pID = parent->ID.get(wo, parent);
+        node_t *nephew = sibling->child[cID].get(wo, sibling);
+        // make nephew the 1-cID child of parent
+        parent->child[1 - cID].set(wo, parent, nephew);
+        if (nephew != nullptr) {
+          nephew->parent.set(wo, nephew, parent);
+          nephew->ID.set(wo, nephew, 1 - cID);
+        }
+        // make parent the cID child of the sibling
+        sibling->child[cID].set(wo, sibling, parent);
+        parent->parent.set(wo, parent, sibling);
+        parent->ID.set(wo, parent, cID);
+        // make sibling the pID child of gparent
+        gparent->child[pID].set(wo, gparent, sibling);
+        sibling->parent.set(wo, sibling, gparent);
+        sibling->ID.set(wo, sibling, pID);
+        fix_size(wo, parent);
+        fix_size(wo, sibling);
+
+        break; // problem solved
+      }
+
+      /*
+           ?p          ?p
+           / \         / \
+         Bx  Bs  =>  Bp  Rs
+             / \         / \
+            B1 B2      B1  B2
+       */
+
+      sibling->color.set(wo, sibling, RED); // propagate upwards
+
+      // advance to parent and balance again
+      curr = parent;
+    }
+
+    // if curr was red, this fixes the balance
+    curr->color.set(wo, curr, BLACK);
+
+    // free the node and return
+    wo.reclaim(to_delete);
+
+    return true;
+  }
+
+  /// Count the keys in the map that are less than `key`.  This is the index
+  /// that `key` has, or would have, in the sorted order of the keys.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key whose rank is sought
+  ///
+  /// @return The number of keys less than `key`
+  uint64_t rank(HANDSTM *me, const K &key) const {
+    BEGIN_RO(me);
+    return count_below(ro, key, false);
+  }
+
+  /// Find the key/value pair at a position in the sorted order of the keys
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param i   The position (0 is the smallest key)
+  /// @param key A ref parameter for returning the key at position `i`
+  /// @param val A ref parameter for returning the value at position `i`
+  ///
+  /// @return True if the map has more than `i` keys, false otherwise.  The
+  ///         reference parameters are only valid when the return value is true.
+  bool select(HANDSTM *me, uint64_t i, K &key, V &val) const {
+    BEGIN_RO(me);
+    // NB: don't modify `i`, since this transaction might restart
+    uint64_t idx = i;
+    node_t *curr = sentinel->child[0].get(ro, sentinel);
+    while (curr != nullptr) {
+      uint64_t left = size_of(ro, curr->child[0].get(ro, curr));
+      if (idx < left) {
+        curr = curr->child[0].get(ro, curr);
+      } else if (idx == left) {
+        key = curr->key.get(ro, curr);
+        val = curr->val.get(ro, curr);
+        return true;
+      } else {
+        idx -= left + 1;
+        curr = curr->child[1].get(ro, curr);
+      }
+    }
+    return false;
+  }
+
+  /// Count the keys in the map that are between `lo` and `hi`, inclusive
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param lo The smallest key to count
+  /// @param hi The largest key to count
+  ///
+  /// @return The number of keys in [lo, hi]
+  uint64_t count(HANDSTM *me, const K &lo, const K &hi) const {
+    if (hi < lo)
+      return 0;
+    BEGIN_RO(me);
+    return count_below(ro, hi, true) - count_below(ro, lo, false);
+  }
+};
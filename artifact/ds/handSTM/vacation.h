@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+#include "../include/vacation_query.h"
+
+/// A travel reservation system, modeled on the "vacation" application from
+/// STAMP.  There are tables of cars, flights, and rooms, which map each item's
+/// id to its capacity and price, and a table of customers, each of which has a
+/// list of the reservations it holds.  Clients make reservations, cancel all of
+/// a customer's reservations, and add or remove capacity.  Each of these is one
+/// transaction that touches several tables.
+///
+/// STAMP uses red-black trees for its tables.  Here, each table is a hash table
+/// whose chains are sorted by id, and hold about CHAIN_LENGTH entries each.
+/// That lets every client request be a single flat transaction, since HandSTM
+/// transactions do not nest.  ds/xSTM/vacation.h is the same application, with
+/// the same tables, written for compiler instrumentation.
+///
+/// @param HANDSTM The thread's descriptor type, for interacting with STM
+template <class HANDSTM> class vacation_t {
+  using WOSTM = typename HANDSTM::WOSTM;
+  using ROSTM = typename HANDSTM::ROSTM;
+  using STM = typename HANDSTM::STM;
+  using ownable_t = typename HANDSTM::ownable_t;
+  template <typename T> using FIELD = typename HANDSTM::template xField<T>;
+
+  /// The capacity that one table update adds to or removes from an item
+  static const int UNITS = 100;
+
+  /// The average number of entries per hash chain
+  static const int CHAIN_LENGTH = 8;
+
+  /// A car, flight, or room
+  struct item_t : ownable_t {
+    const int id;         // The item's id
+    FIELD<int> total;     // The item's capacity
+    FIELD<int> free;      // The capacity that is not reserved
+    FIELD<int> price;     // The price of reserving the item
+    FIELD<item_t *> next; // The next item in the chain
+
+    /// Construct an item with no reservations
+    ///
+    /// @param id    The item's id
+    /// @param total The item's capacity
+    /// @param price The price of reserving the item
+    item_t(int id, int total, int price)
+        : ownable_t(), id(id), total(total), free(total), price(price),
+          next(nullptr) {}
+  };
+
+  /// A reservation held by a customer.  It is immutable, except for `next`.
+  struct resv_t : ownable_t {
+    const vacation_kind_t kind; // The kind of item that was reserved
+    const int id;               // The id of the item that was reserved
+    const int price;            // The price that was paid
+    FIELD<resv_t *> next;       // The customer's next reservation
+
+    /// Construct a reservation
+    ///
+    /// @param kind  The kind of item that was reserved
+    /// @param id    The id of the item that was reserved
+    /// @param price The price that was paid
+    resv_t(vacation_kind_t kind, int id, int price)
+        : ownable_t(), kind(kind), id(id), price(price), next(nullptr) {}
+  };
+
+  /// A customer
+  struct customer_t : ownable_t {
+    const int id;             // The customer's id
+    FIELD<resv_t *> resvs;    // The customer's reservations
+    FIELD<customer_t *> next; // The next customer in the chain
+
+    /// Construct a customer with no reservations
+    ///
+    /// @param id The customer's id
+    customer_t(int id) : ownable_t(), id(id), resvs(nullptr), next(nullptr) {}
+  };
+
+  /// The head of a hash chain
+  template <class T> struct bucket_t : ownable_t {
+    FIELD<T *> head; // The first entry in the chain
+
+    /// Construct an empty chain
+    bucket_t() : ownable_t(), head(nullptr) {}
+  };
+
+  const size_t num_buckets;           // The number of buckets in each table
+  bucket_t<item_t> *items[NUM_KINDS]; // The tables of cars, flights, and rooms
+  bucket_t<customer_t> *customers;    // The table of customers
+
+  /// Find the bucket for an id
+  ///
+  /// @param table The table to search
+  /// @param id    The id to find
+  ///
+  /// @return The bucket whose chain holds `id`, if it is in the table
+  template <class T> bucket_t<T> *bucket(bucket_t<T> *table, int id) {
+    return &table[(size_t)id % num_buckets];
+  }
+
+  /// Search a chain for the entry with a given id
+  ///
+  /// @param tx   The enclosing transaction
+  /// @param b    The bucket to search
+  /// @param id   The id to find
+  /// @param prev A ref param for returning the entry before the one with `id`
+  ///             (or where it would be), or nullptr if it is the first
+  ///
+  /// @return The entry with `id`, or nullptr if there is none
+  template <class T> T *find(STM &tx, bucket_t<T> *b, int id, T *&prev) {
+    prev = nullptr;
+    T *curr = b->head.get(tx, b);
+    while (curr && curr->id < id) {
+      prev = curr;
+      curr = curr->next.get(tx, curr);
+    }
+    return (curr && curr->id == id) ? curr : nullptr;
+  }
+
+  /// Link a new entry into a chain
+  ///
+  /// @param wo   The enclosing transaction
+  /// @param b    The bucket whose chain gets the entry
+  /// @param prev The entry to link after, or nullptr to link at the head
+  /// @param node The new entry
+  template <class T> void link(WOSTM &wo, bucket_t<T> *b, T *prev, T *node) {
+    if (prev) {
+      node->next.set(wo, node, prev->next.get(wo, prev));
+      prev->next.set(wo, prev, node);
+    } else {
+      node->next.set(wo, node, b->head.get(wo, b));
+      b->head.set(wo, b, node);
+    }
+  }
+
+  /// Unlink an entry from a chain, and reclaim it
+  ///
+  /// @param wo   The enclosing transaction
+  /// @param b    The bucket whose chain holds the entry
+  /// @param prev The entry before `node`, or nullptr if `node` is the first
+  /// @param node The entry to remove
+  template <class T> void unlink(WOSTM &wo, bucket_t<T> *b, T *prev, T *node) {
+    T *next = node->next.get(wo, node);
+    if (prev)
+      prev->next.set(wo, prev, next);
+    else
+      b->head.set(wo, b, next);
+    wo.reclaim(node);
+  }
+
+  /// Add an item, in its own transaction.  Used to populate the tables.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param kind  The kind of item
+  /// @param id    The item's id
+  /// @param total The item's capacity
+  /// @param price The price of reserving the item
+  void add_item(HANDSTM *me, vacation_kind_t kind, int id, int total,
+                int price) {
+    BEGIN_WO(me);
+    auto b = bucket(items[kind], id);
+    item_t *prev;
+    if (!find(wo, b, id, prev))
+      link(wo, b, prev, wo.LOG_NEW(new item_t(id, total, price)));
+  }
+
+  /// Add a customer, in its own transaction.  Used to populate the tables.
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param id The customer's id
+  void add_customer(HANDSTM *me, int id) {
+    BEGIN_WO(me);
+    auto b = bucket(customers, id);
+    customer_t *prev;
+    if (!find(wo, b, id, prev))
+      link(wo, b, prev, wo.LOG_NEW(new customer_t(id)));
+  }
+
+public:
+  /// Construct the tables, and populate them with `cfg->key_range` customers
+  /// and `cfg->key_range` items of each kind, with random capacities and
+  /// prices (as in STAMP)
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param cfg A configuration object with a `key_range` field
+  vacation_t(HANDSTM *me, auto *cfg)
+      : num_buckets(std::max<size_t>(1, cfg->key_range / CHAIN_LENGTH)) {
+    for (int k = 0; k < NUM_KINDS; ++k)
+      items[k] = new bucket_t<item_t>[num_buckets];
+    customers = new bucket_t<customer_t>[num_buckets];
+    std::mt19937 mt(0);
+    for (size_t id = 0; id < cfg->key_range; ++id) {
+      for (int k = 0; k < NUM_KINDS; ++k)
+        add_item(me, (vacation_kind_t)k, id, (mt() % 5 + 1) * UNITS,
+                 (mt() % 5) * 10 + 50);
+      add_customer(me, id);
+    }
+  }
+
+  /// Reserve the most expensive available item of each kind that the queries
+  /// ask about, on behalf of a customer.  The customer is created if it does
+  /// not exist.  A customer never holds two reservations for the same item.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param cid     The customer's id
+  /// @param queries The items to consider
+  /// @param num     The number of queries
+  ///
+  /// @return True if at least one reservation was made
+  bool reserve(HANDSTM *me, int cid, vacation_query_t *queries, int num) {
+    BEGIN_WO(me);
+    // Find the most expensive available item of each kind
+    item_t *best[NUM_KINDS] = {nullptr};
+    int best_price[NUM_KINDS] = {-1, -1, -1};
+    for (int i = 0; i < num; ++i) {
+      auto kind = queries[i].kind;
+      item_t *prev;
+      item_t *item = find(wo, bucket(items[kind], queries[i].id),
+                          queries[i].id, prev);
+      if (!item || item->free.get(wo, item) == 0)
+        continue;
+      int price = item->price.get(wo, item);
+      if (price > best_price[kind]) {
+        best[kind] = item;
+        best_price[kind] = price;
+      }
+    }
+    if (!best[CAR] && !best[FLIGHT] && !best[ROOM])
+      return false;
+
+    // Find or create the customer
+    auto cb = bucket(customers, cid);
+    customer_t *cprev;
+    customer_t *c = find(wo, cb, cid, cprev);
+    if (!c) {
+      c = wo.LOG_NEW(new customer_t(cid));
+      link(wo, cb, cprev, c);
+    }
+
+    // Reserve each item, unless the customer already holds it
+    bool made = false;
+    for (int k = 0; k < NUM_KINDS; ++k) {
+      if (!best[k])
+        continue;
+      bool held = false;
+      for (auto r = c->resvs.get(wo, c); r && !held; r = r->next.get(wo, r))
+        held = r->kind == k && r->id == best[k]->id;
+      if (held)
+        continue;
+      best[k]->free.set(wo, best[k], best[k]->free.get(wo, best[k]) - 1);
+      auto r = wo.LOG_NEW(new resv_t((vacation_kind_t)k, best[k]->id,
+                                     best_price[k]));
+      r->next.set(wo, r, c->resvs.get(wo, c));
+      c->resvs.set(wo, c, r);
+      made = true;
+    }
+    return made;
+  }
+
+  /// Cancel all of a customer's reservations, returning their capacity to the
+  /// items, and then remove the customer
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param cid The customer's id
+  ///
+  /// @return True if the customer existed
+  bool cancel(HANDSTM *me, int cid) {
+    BEGIN_WO(me);
+    auto cb = bucket(customers, cid);
+    customer_t *cprev;
+    customer_t *c = find(wo, cb, cid, cprev);
+    if (!c)
+      return false;
+    for (auto r = c->resvs.get(wo, c); r;) {
+      // NB: An item with reservations is never deleted
+      item_t *prev;
+      item_t *item = find(wo, bucket(items[r->kind], r->id), r->id, prev);
+      if (item)
+        item->free.set(wo, item, item->free.get(wo, item) + 1);
+      auto next = r->next.get(wo, r);
+      wo.reclaim(r);
+      r = next;
+    }
+    unlink(wo, cb, cprev, c);
+    return true;
+  }
+
+  /// Add or remove capacity.  Adding capacity to an item that does not exist
+  /// creates it.  Capacity can only be removed from an item if at least UNITS
+  /// of it are free, and an item is deleted when it has no capacity left.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param queries The items to update
+  /// @param num     The number of queries
+  ///
+  /// @return True if any item changed
+  bool update(HANDSTM *me, vacation_query_t *queries, int num) {
+    BEGIN_WO(me);
+    bool changed = false;
+    for (int i = 0; i < num; ++i) {
+      auto &q = queries[i];
+      auto b = bucket(items[q.kind], q.id);
+      item_t *prev;
+      item_t *item = find(wo, b, q.id, prev);
+      if (q.add) {
+        if (!item) {
+          link(wo, b, prev, wo.LOG_NEW(new item_t(q.id, UNITS, q.price)));
+        } else {
+          item->total.set(wo, item, item->total.get(wo, item) + UNITS);
+          item->free.set(wo, item, item->free.get(wo, item) + UNITS);
+          item->price.set(wo, item, q.price);
+        }
+        changed = true;
+      } else if (item && item->free.get(wo, item) >= UNITS) {
+        int total = item->total.get(wo, item) - UNITS;
+        if (total == 0) {
+          unlink(wo, b, prev, item);
+        } else {
+          item->total.set(wo, item, total);
+          item->free.set(wo, item, item->free.get(wo, item) - UNITS);
+        }
+        changed = true;
+      }
+    }
+    return changed;
+  }
+};
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// An unordered map, implemented as a bucketized cuckoo hash table.  This map
+/// supports get(), insert() and remove() operations.
+///
+/// Each key can only be in one of two buckets, and each bucket holds up to
+/// SLOTS entries, so a lookup reads at most two buckets, no matter how full
+/// the table is.  When both of a key's buckets are full, insert() does a
+/// breadth-first search for a path of displacements that ends at a free slot,
+/// and then moves every entry on the path and stores the new key, all in the
+/// same transaction.  A lock-based cuckoo table needs a careful protocol for
+/// making such a path appear atomic; here, the transaction provides it.
+///
+/// When no path can be found, the table doubles in size.  Resizing is done in
+/// two transactions.  The first marks the table `frozen`, which aborts every
+/// concurrent writer and keeps new ones from writing (they wait for the new
+/// table instead).  The second copies the frozen table into a new one and
+/// installs it.  Lookups never wait, since a frozen table does not change.
+///
+/// This is the hybrid version of ds/handSTM/cuckoo_umap.h.  Updates are the
+/// same HandSTM transactions, but get() is a single STMCAS step that reads the
+/// two buckets and validates their orecs, so lookups do not pay for a read
+/// set or a commit.
+///
+/// NB: Keys and values must be default constructable, and trivially copyable
+///     so that a step can read them while they might be changing.
+///
+/// @tparam K       The type of the keys stored in this map
+/// @tparam V       The type of the values stored in this map
+/// @tparam HYPOL   The HYPOL implementation (PO or PS)
+template <typename K, typename V, class HYPOL> class cuckoo_umap {
+  using WOSTM = typename HYPOL::WOSTM;
+  using ROSTM = typename HYPOL::ROSTM;
+  using STM = typename HYPOL::STM;
+  using RSTEP = typename HYPOL::RSTEP;
+  using ownable_t = typename HYPOL::ownable_t;
+  template <typename T> using FIELD = typename HYPOL::template sxField<T>;
+
+  /// The number of entries in a bucket
+  static const int SLOTS = 4;
+
+  /// The most buckets that insert()'s breadth-first search will visit.  Since
+  /// each bucket has SLOTS children, this bounds paths to about 4 moves.
+  static const int MAX_SEARCH = 256;
+
+  /// A bucket, which holds up to SLOTS entries under one orec.  `used` has a
+  /// bit set for each slot that holds an entry.
+  struct bucket_t : ownable_t {
+    FIELD<uint8_t> used;  // The slots that hold entries
+    FIELD<K> keys[SLOTS]; // The keys of the entries
+    FIELD<V> vals[SLOTS]; // The values of the entries
+
+    /// Construct an empty bucket
+    bucket_t() : ownable_t(), used(0) {}
+  };
+
+  /// An array of buckets, along with its size
+  struct tbl_t : ownable_t {
+    const uint64_t size;     // The number of buckets
+    bucket_t *const buckets; // The buckets
+    FIELD<bool> frozen;      // Is this table being replaced?
+
+    /// Construct a table of empty buckets
+    ///
+    /// @param _size The number of buckets (a power of 2)
+    tbl_t(uint64_t _size)
+        : ownable_t(), size(_size), buckets(new bucket_t[_size]),
+          frozen(false) {}
+
+    /// Reclaim the buckets along with the table
+    virtual ~tbl_t() { delete[] buckets; }
+  };
+
+  /// A bucket of a table that is being built in private memory
+  struct plain_t {
+    uint8_t used = 0; // The slots that hold entries
+    K keys[SLOTS];    // The keys of the entries
+    V vals[SLOTS];    // The values of the entries
+  };
+
+  /// One bucket visited by insert()'s search
+  struct visit_t {
+    uint64_t idx; // The bucket's index in the table
+    int parent;   // The visit that led here, or -1 for the key's own buckets
+    int slot;     // The slot of `parent` whose entry can move here
+  };
+
+  ownable_t *tbl_orec;    // An orec for protecting `active`
+  FIELD<tbl_t *> active;  // The current table
+  std::hash<K> _pre_hash; // A weak hash function for converting keys to ints
+
+  /// Compute the two buckets where a key may be stored.  Both come from one
+  /// strong hash of the key: the low bits pick the first, and the high bits
+  /// pick the second.  They are always different.
+  ///
+  /// @param me   The calling thread's descriptor
+  /// @param key  The key to hash
+  /// @param size The size of the table
+  ///
+  /// @return The indices of the key's two buckets
+  std::pair<uint64_t, uint64_t> table_hash(HYPOL *me, const K &key,
+                                           uint64_t size) const {
+    uint64_t h = me->hash(_pre_hash(key));
+    uint64_t i1 = h & (size - 1), i2 = (h >> 32) & (size - 1);
+    return {i1, i1 == i2 ? i1 ^ 1 : i2};
+  }
+
+public:
+  /// Construct a map with an empty table of `cfg->buckets` buckets
+  ///
+  /// NB: Throws if the provided size is not a power of 2.
+  ///
+  /// @param me  The operation that is creating this umap
+  /// @param cfg A config object with `buckets`
+  cuckoo_umap(HYPOL *me, auto *cfg) : tbl_orec(new ownable_t()) {
+    if (std::popcount(cfg->buckets) != 1)
+      throw("cfg->buckets should be power of 2");
+    BEGIN_WO(me);
+    active.xSet(wo, tbl_orec, new tbl_t(std::max<uint64_t>(cfg->buckets, 2)));
+  }
+
+private:
+  /// Search a bucket for a key
+  ///
+  /// @param tx  An active transaction
+  /// @param b   The bucket to search
+  /// @param key The key to find
+  ///
+  /// @return The slot holding `key`, or -1 if it is not in `b`
+  int find_slot(STM &tx, bucket_t *b, const K &key) {
+    uint8_t used = b->used.xGet(tx, b);
+    for (int s = 0; s < SLOTS; ++s)
+      if ((used & (1 << s)) && b->keys[s].xGet(tx, b) == key)
+        return s;
+    return -1;
+  }
+
+  /// Find a bucket's first free slot
+  ///
+  /// @param used The bucket's `used` bits
+  ///
+  /// @return The first free slot, or -1 if the bucket is full
+  static int free_slot(uint8_t used) {
+    for (int s = 0; s < SLOTS; ++s)
+      if (!(used & (1 << s)))
+        return s;
+    return -1;
+  }
+
+  /// Find a path of displacements from one of a key's buckets to a free slot,
+  /// and move the entries along it, so that the first bucket on the path has
+  /// a free slot
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param wo An active writing transaction
+  /// @param t  The table
+  /// @param i1 The index of the key's first bucket
+  /// @param i2 The index of the key's second bucket
+  ///
+  /// @return {bucket, slot} of a free slot in bucket i1 or i2, or {nullptr, -1}
+  ///         if the search failed and the table must grow
+  std::pair<bucket_t *, int> make_room(HYPOL *me, WOSTM &wo, tbl_t *t,
+                                       uint64_t i1, uint64_t i2) {
+    // Breadth-first search.  A bucket is not added twice to the same path, so
+    // that the moves below never touch a slot twice.
+    visit_t q[MAX_SEARCH];
+    q[0] = {i1, -1, -1};
+    q[1] = {i2, -1, -1};
+    int tail = 2;
+    for (int head = 0; head < tail; ++head) {
+      bucket_t *b = &t->buckets[q[head].idx];
+      int slot = free_slot(b->used.xGet(wo, b));
+      if (slot >= 0) {
+        // Move each entry on the path into the slot its child freed, from the
+        // end of the path back to the key's bucket
+        for (int v = head; q[v].parent >= 0; v = q[v].parent) {
+          bucket_t *p = &t->buckets[q[q[v].parent].idx];
+          int s = q[v].slot;
+          b->keys[slot].xSet(wo, b, p->keys[s].xGet(wo, p));
+          b->vals[slot].xSet(wo, b, p->vals[s].xGet(wo, p));
+          b->used.xSet(wo, b, b->used.xGet(wo, b) | (1 << slot));
+          p->used.xSet(wo, p, p->used.xGet(wo, p) & ~(1 << s));
+          b = p;
+          slot = s;
+        }
+        return {b, slot};
+      }
+      // Every slot is used, so each entry's other bucket is a child
+      for (int s = 0; s < SLOTS && tail < MAX_SEARCH; ++s) {
+        auto [a1, a2] = table_hash(me, b->keys[s].xGet(wo, b), t->size);
+        uint64_t alt = a1 == q[head].idx ? a2 : a1;
+        bool on_path = false;
+        for (int v = head; v >= 0 && !on_path; v = q[v].parent)
+          on_path = q[v].idx == alt;
+        if (!on_path)
+          q[tail++] = {alt, head, s};
+      }
+    }
+    return {nullptr, -1};
+  }
+
+  /// Wait until a frozen table has been replaced
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param t  The frozen table
+  void wait_resize(HYPOL *me, tbl_t *t) {
+    while (true) {
+      {
+        RSTEP tx(me);
+        // NB: no need to validate, since `t` is never installed again
+        if (active.sGet(tx) != t)
+          return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /// Replace the table with one that is at least twice as big.  If another
+  /// thread is already replacing it, this returns right away, and the caller
+  /// will wait when it next tries to write.
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param t  The table that is too full
+  void resize(HYPOL *me, tbl_t *t) {
+    // Freeze `t`, unless someone else has started to replace it
+    {
+      BEGIN_WO(me);
+      if (active.xGet(wo, tbl_orec) != t || t->frozen.xGet(wo, t))
+        return;
+      t->frozen.xSet(wo, t, true);
+    }
+
+    // Copy every entry into a bigger table.  No writer can change `t` now, but
+    // the reads must still be transactional, since an eager writer that has
+    // not yet aborted may have written in place.
+    //
+    // NB: The vectors are declared before BEGIN_WO, since an abort longjmps
+    //     back to it, and would skip the destructors of anything declared after
+    std::vector<std::pair<K, V>> entries;
+    std::vector<plain_t> p;
+    BEGIN_WO(me);
+    entries.clear();
+    p.clear();
+    for (uint64_t i = 0; i < t->size; ++i) {
+      bucket_t *b = &t->buckets[i];
+      uint8_t used = b->used.xGet(wo, b);
+      for (int s = 0; s < SLOTS; ++s)
+        if (used & (1 << s))
+          entries.emplace_back(b->keys[s].xGet(wo, b), b->vals[s].xGet(wo, b));
+    }
+
+    // Lay the entries out in private memory, doubling until they fit
+    for (uint64_t size = t->size * 2;; size *= 2) {
+      p.assign(size, plain_t());
+      bool fits = true;
+      for (auto &[k, v] : entries)
+        if (!(fits = place(me, p, k, v)))
+          break;
+      if (fits)
+        break;
+    }
+
+    // The new table is private until it is installed, so fill it without
+    // logging
+    tbl_t *n = wo.LOG_NEW(new tbl_t(p.size()));
+    for (uint64_t i = 0; i < p.size(); ++i) {
+      bucket_t *b = &n->buckets[i];
+      b->used.xSet_cap(wo, b, p[i].used);
+      for (int s = 0; s < SLOTS; ++s) {
+        b->keys[s].xSet_cap(wo, b, p[i].keys[s]);
+        b->vals[s].xSet_cap(wo, b, p[i].vals[s]);
+      }
+    }
+    active.xSet(wo, tbl_orec, n);
+    wo.reclaim(t);
+  }
+
+  /// Put an entry into a private layout of a table, evicting entries to their
+  /// other bucket as needed
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param p   The buckets of the private table
+  /// @param key The key to place
+  /// @param val The value to place
+  ///
+  /// @return true if the entry was placed, false if `p` is too full.  On
+  ///         failure, some other entry has been lost, so `p` must be discarded.
+  bool place(HYPOL *me, std::vector<plain_t> &p, K key, V val) {
+    uint64_t idx = table_hash(me, key, p.size()).first;
+    for (int moves = 0; moves < MAX_SEARCH; ++moves) {
+      auto [i1, i2] = table_hash(me, key, p.size());
+      for (uint64_t i : {i1, i2}) {
+        int s = free_slot(p[i].used);
+        if (s >= 0) {
+          p[i].keys[s] = key;
+          p[i].vals[s] = val;
+          p[i].used |= 1 << s;
+          return true;
+        }
+      }
+      // Both buckets are full, so swap with a victim in `idx`, and then place
+      // the victim, starting with its other bucket
+      int s = moves % SLOTS;
+      std::swap(key, p[idx].keys[s]);
+      std::swap(val, p[idx].vals[s]);
+      auto [v1, v2] = table_hash(me, key, p.size());
+      idx = idx == v1 ? v2 : v1;
+    }
+    return false;
+  }
+
+public:
+  /// Search the data structure for a node with key `key`.  If not found, return
+  /// false.  If found, return true, and set `val` to the value associated with
+  /// `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(HYPOL *me, const K &key, V &val) {
+    while (true) {
+      RSTEP tx(me);
+      tbl_t *t = active.sGet(tx);
+      if (tx.check_orec(tbl_orec) == HYPOL::END_OF_TIME)
+        continue;
+
+      // Read each bucket, then validate it.  Since every orec is checked
+      // against the step's start time, the reads are a consistent snapshot.
+      auto [i1, i2] = table_hash(me, key, t->size);
+      bool retry = false;
+      for (uint64_t i : {i1, i2}) {
+        bucket_t *b = &t->buckets[i];
+        uint8_t used = b->used.sGet(tx);
+        int found = -1;
+        for (int s = 0; s < SLOTS && found < 0; ++s)
+          if ((used & (1 << s)) && b->keys[s].sGet(tx) == key)
+            found = s;
+        if (found >= 0)
+          val = b->vals[found].sGet(tx);
+        if (tx.check_orec(b) == HYPOL::END_OF_TIME) {
+          retry = true;
+          break;
+        }
+        if (found >= 0)
+          return true;
+      }
+      if (!retry)
+        return false;
+    }
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(HYPOL *me, const K &key, V &val) {
+    while (true) {
+      tbl_t *t = nullptr;    // The table, if it is too full or frozen
+      bool frozen = false;   // Is `t` frozen?
+      {
+        BEGIN_WO(me);
+        t = active.xGet(wo, tbl_orec);
+        frozen = t->frozen.xGet(wo, t);
+        if (!frozen) {
+          auto [i1, i2] = table_hash(me, key, t->size);
+          bucket_t *b1 = &t->buckets[i1], *b2 = &t->buckets[i2];
+          if (find_slot(wo, b1, key) >= 0 || find_slot(wo, b2, key) >= 0)
+            return false;
+          auto [b, s] = make_room(me, wo, t, i1, i2);
+          if (b) {
+            b->keys[s].xSet(wo, b, key);
+            b->vals[s].xSet(wo, b, val);
+            b->used.xSet(wo, b, b->used.xGet(wo, b) | (1 << s));
+            return true;
+          }
+        }
+      }
+      if (frozen) {
+        wait_resize(me, t);
+      } else {
+        EXO_TRACE(tracer_t::RESIZE_BEGIN);
+        resize(me, t);
+        EXO_TRACE(tracer_t::RESIZE_END);
+      }
+    }
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(HYPOL *me, const K &key) {
+    while (true) {
+      tbl_t *t = nullptr;
+      {
+        BEGIN_WO(me);
+        t = active.xGet(wo, tbl_orec);
+        if (!t->frozen.xGet(wo, t)) {
+          auto [i1, i2] = table_hash(me, key, t->size);
+          for (uint64_t i : {i1, i2}) {
+            bucket_t *b = &t->buckets[i];
+            int s = find_slot(wo, b, key);
+            if (s >= 0) {
+              b->used.xSet(wo, b, b->used.xGet(wo, b) & ~(1 << s));
+              return true;
+            }
+          }
+          return false;
+        }
+      }
+      wait_resize(me, t);
+    }
+  }
+};
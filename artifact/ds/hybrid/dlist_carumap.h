@@ -641,7 +641,9 @@ public:
       return true;
     }
 
+    EXO_TRACE(tracer_t::RESIZE_BEGIN);
     resize(me, a_ver);
+    EXO_TRACE(tracer_t::RESIZE_END);
     return true;
   }
 
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "../include/cold_part.h"
+
 /// An ordered map, implemented as a balanced, internal binary search tree. This
-/// map supports get(), insert(), and remove() operations.
+/// map supports get(), get_geq(), insert(), update(), and remove() operations.
 ///
 /// @param K          The type of the keys stored in this map
 /// @param V          The type of the values stored in this map
 /// @param HYPOL      A thread descriptor type, for safe memory reclamation
 /// @param dummy_key  A default key to use
 /// @param dummy_val  A default value to use
-template <typename K, typename V, class HYPOL, K dummy_key, V dummy_val>
+/// @param HOT_COLD   A flag to move values out of tree nodes, into a separate
+///                   allocation, and to cache-align the rest of each node
+template <typename K, typename V, class HYPOL, K dummy_key, V dummy_val,
+          bool HOT_COLD = false>
 class rbtree_omap_drop {
   using WOSTM = typename HYPOL::WOSTM;
   using ROSTM = typename HYPOL::ROSTM;
@@ -23,19 +28,29 @@ class rbtree_omap_drop {
   static const int RED = 0;   // Enum for red
   static const int BLACK = 1; // Enum for black
 
+  struct node_t;
+
+  /// The fields of a node_t that searches do not need
+  struct cold_t {
+    FIELD<V> val; // Value stored at this node
+
+    /// basic constructor
+    cold_t(V val) : val(val) {}
+  };
+
   /// nodes in a red/black tree
-  struct node_t : ownable_t {
-    FIELD<K> key;             // Key stored at this node
-    FIELD<V> val;             // Value stored at this node
-    FIELD<int> color;         // color (RED or BLACK)
-    FIELD<node_t *> parent;   // pointer to parent
-    FIELD<int> ID;            // 0/1 for left/right child
-    FIELD<node_t *> child[2]; // L/R children
+  struct alignas(hot_align_v<ownable_t, HOT_COLD>) node_t : ownable_t {
+    FIELD<K> key;                       // Key stored at this node
+    FIELD<node_t *> child[2];           // L/R children
+    FIELD<int> color;                   // color (RED or BLACK)
+    FIELD<node_t *> parent;             // pointer to parent
+    FIELD<int> ID;                      // 0/1 for left/right child
+    cold_part_t<cold_t, HOT_COLD> cold; // Value stored at this node
 
     /// basic constructor
     node_t(WOSTM &wo, int color, K key, V val, node_t *parent, long ID,
            node_t *child0, node_t *child1)
-        : key(key), val(val), color(color), parent(parent), ID(ID) {
+        : key(key), color(color), parent(parent), ID(ID), cold(val) {
       child[0].xSet(wo, this, child0);
       child[1].xSet(wo, this, child1);
     }
@@ -226,9 +241,7 @@ public:
         RSTEP tx(me);
         auto *dn = curr._obj;
         auto dn_key = dn->key.sGet(tx);
-        // TODO: Use atomic_ref?
-        V val_copy = reinterpret_cast<std::atomic<V> *>(&dn->val)->load(
-            std::memory_order_acquire);
+        V val_copy = dn->cold->val.sGet(tx);
         if (!tx.check_continuation(curr._obj, curr._ver))
           continue;
         if (dn_key != key)
@@ -243,13 +256,77 @@ public:
         //       always scalar?  If so, we don't even need this...
         BEGIN_RO(me);
         if (ro.inheritOrec(curr._obj, curr._ver)) {
-          val = curr._obj->val.xGet(ro, curr._obj);
+          val = curr._obj->cold->val.xGet(ro, curr._obj);
           return true;
         } // else commit and repeat the while loop :)
       }
     }
   }
 
+  /// Find the mapping with the smallest key that is not less than `key`.  The
+  /// search is a single read-only step, so the result is linearizable.
+  ///
+  /// @param me    The calling thread's descriptor
+  /// @param key   The key to search from
+  /// @param found A ref parameter for returning the key that was found
+  /// @param val   A ref parameter for returning the value of `found`
+  ///
+  /// @return True if there is such a key, false otherwise.  The reference
+  ///         parameters are only valid when the return value is true.
+  bool get_geq(HYPOL *me, const K &key, K &found, V &val) const {
+    while (true) {
+      RSTEP tx(me);
+      node_t *curr = sentinel->child[LEFT].sGet(tx);
+      if (tx.check_orec(sentinel) == HYPOL::END_OF_TIME)
+        continue;
+      bool res = false, valid = true;
+      while (curr != nullptr) {
+        auto ckey = curr->key.sGet(tx);
+        auto cval = curr->cold->val.sGet(tx);
+        auto next = curr->child[(ckey < key) ? RIGHT : LEFT].sGet(tx);
+        if (tx.check_orec(curr) == HYPOL::END_OF_TIME) {
+          valid = false;
+          break;
+        }
+        if (!(ckey < key)) {
+          res = true;
+          found = ckey;
+          val = cval;
+          if (ckey == key)
+            break;
+        }
+        curr = next;
+      }
+      if (valid)
+        return res;
+    }
+  }
+
+  /// Replace the value associated with `key`, if `key` is present
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key whose value should change
+  /// @param val The new value
+  ///
+  /// @return True if the key was found and its value replaced
+  bool update(HYPOL *me, const K &key, V &val) {
+    me->snapshots.clear();
+    while (true) {
+      // Find the node with an STMCAS step, then write it in a WOSTM that
+      // continues that step.  If the node was removed in the meantime, its orec
+      // changed, so we retry.
+      auto curr = get_node(me, key).child;
+      if (curr._obj == nullptr)
+        return false;
+
+      BEGIN_WO(me);
+      if (!wo.inheritOrec(curr._obj, curr._ver))
+        continue;
+      curr._obj->cold->val.xSet(wo, curr._obj, val);
+      return true;
+    }
+  }
+
   // insert a node with k/v as its pair if no such key exists in the tree
   bool insert(HYPOL *me, const K &key, V &val) {
     me->snapshots.clear();
@@ -410,8 +487,8 @@ public:
 
           curr->key.xSet(wo, curr,
                          successor._obj->key.xGet(wo, successor._obj));
-          curr->val.xSet(wo, curr,
-                         successor._obj->val.xGet(wo, successor._obj));
+          curr->cold->val.xSet(
+              wo, curr, successor._obj->cold->val.xGet(wo, successor._obj));
           curr = successor._obj;
           parent_ = successor_parent;
         }
@@ -589,6 +666,11 @@ public:
         if (curr->color.xGet(wo, curr) == RED)
           curr->color.xSet(wo, curr, BLACK);
 
+        // Write to the removed node, so that its orec changes.  Otherwise, an
+        // insert whose RSTEP found it could still inherit its orec, and link a
+        // new node below it.
+        to_delete->child[LEFT].xSet(wo, to_delete, nullptr);
+
         // free the node and return
         wo.reclaim(to_delete);
 
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "../../policies/include/hash.h"
+
+/// A map that puts a concurrent counting Bloom filter in front of another map,
+/// so that lookups (and removals) of absent keys can usually return without
+/// traversing it.  This map supports get(), insert(), and remove() operations.
+///
+/// The filter is "blocked": each key hashes to one cache line of 16-bit
+/// counters, and sets NUM_HASHES counters within it, so a negative answer
+/// costs one cache line read.
+///
+/// The filter never produces false negatives.  An insert increments the key's
+/// counters *before* inserting into MAP (and undoes the increment if the key
+/// was already present), and a remove decrements them only *after* it has
+/// removed the key from MAP.  So while a key is in MAP, all of its counters are
+/// nonzero, and a get() that reads a zero counter can linearize at that read.
+///
+/// NB: A counter would wrap if more than 65535 present keys (or in-flight
+///     inserts) shared it.  With the default sizing that is not a concern.
+///
+/// @param K          The type of the keys stored in this map
+/// @param V          The type of the values stored in this map
+/// @param DESCRIPTOR The thread descriptor type used by MAP
+/// @param MAP        The map to put behind the filter
+///
+/// NB: MAP must be constructable from <DESCRIPTOR*, cfg*>
+template <typename K, typename V, class DESCRIPTOR, class MAP>
+class bloom_front_adapter_t {
+  /// The number of counters per expected key, before rounding up to a power of
+  /// two.  With 3 hashes, this gives a false positive rate of a few percent.
+  static const uint64_t COUNTERS_PER_KEY = 8;
+
+  /// The number of counters each key sets
+  static const int NUM_HASHES = 3;
+
+  /// A cache line of counters
+  struct alignas(64) block_t {
+    std::atomic<uint16_t> counters[32]; // The counters
+  };
+
+  MAP *map;            // The map behind the filter
+  block_t *blocks;     // The filter
+  uint64_t block_mask; // The number of blocks, minus one
+
+  /// Find the block and counter indices for a key
+  ///
+  /// @param key The key to hash
+  /// @param idx An array to populate with the counter indices
+  ///
+  /// @return The key's block
+  block_t &locate(const K &key, int (&idx)[NUM_HASHES]) {
+    uint64_t h = mix13_hash(std::hash<K>()(key));
+    for (int i = 0; i < NUM_HASHES; ++i)
+      idx[i] = (h >> (5 * i)) & 31;
+    return blocks[(h >> 32) & block_mask];
+  }
+
+  /// Check if a key might be in the map
+  ///
+  /// @param key The key to check
+  ///
+  /// @return False if `key` is definitely not in the map, true otherwise
+  bool maybe_present(const K &key) {
+    int idx[NUM_HASHES];
+    block_t &b = locate(key, idx);
+    for (int i : idx)
+      if (b.counters[i].load() == 0)
+        return false;
+    return true;
+  }
+
+  /// Add `delta` to each of a key's counters
+  ///
+  /// @param key   The key whose counters should change
+  /// @param delta The amount to add (1 or -1)
+  void adjust(const K &key, int delta) {
+    int idx[NUM_HASHES];
+    block_t &b = locate(key, idx);
+    for (int i : idx)
+      b.counters[i].fetch_add(delta);
+  }
+
+public:
+  /// Construct a bloom_front_adapter_t by constructing its MAP and sizing the
+  /// filter for the key range
+  ///
+  /// @param me  The operation that is constructing the map
+  /// @param cfg A configuration object with a `key_range` field (plus any
+  ///            fields that MAP needs)
+  bloom_front_adapter_t(DESCRIPTOR *me, auto *cfg) : map(new MAP(me, cfg)) {
+    uint64_t counters = cfg->key_range * COUNTERS_PER_KEY;
+    uint64_t num_blocks = 1;
+    while (num_blocks * 32 < counters)
+      num_blocks <<= 1;
+    block_mask = num_blocks - 1;
+    blocks = new block_t[num_blocks];
+    for (uint64_t i = 0; i < num_blocks; ++i)
+      for (auto &c : blocks[i].counters)
+        c.store(0, std::memory_order_relaxed);
+  }
+
+  /// Search the map for a node with key `key`.  If not found, return false.
+  /// If found, return true, and set `val` to the value associated with `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(DESCRIPTOR *me, const K &key, V &val) {
+    return maybe_present(key) && map->get(me, key, val);
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(DESCRIPTOR *me, const K &key, V &val) {
+    adjust(key, 1);
+    if (map->insert(me, key, val))
+      return true;
+    adjust(key, -1);
+    return false;
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(DESCRIPTOR *me, const K &key) {
+    if (!maybe_present(key) || !map->remove(me, key))
+      return false;
+    adjust(key, -1);
+    return true;
+  }
+};
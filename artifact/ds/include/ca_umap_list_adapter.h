@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <new>
+#include <sys/mman.h>
 #include <vector>
 
 // STM Non-resizable Hash Table
@@ -9,6 +13,15 @@
 /// A straightforward non-resizable hashtable. This map supports
 /// get(), insert(), remove(), and size() operations.
 ///
+/// The buckets are constructed in place, in one contiguous array, rather than
+/// being allocated individually.  For OMAPs that store their sentinels inline,
+/// this means that a lookup goes straight from the hash to the bucket's head
+/// (and its orec), without first loading a pointer to the bucket.  Each bucket
+/// is padded to a multiple of 64 bytes, so that updates to one bucket's
+/// sentinels do not false-share with its neighbors.  The array can optionally
+/// be backed by (transparent) huge pages, to reduce TLB misses when there are
+/// many buckets.
+///
 /// @param K      The type of the keys stored in this map
 /// @param V      The type of the values stored in this map
 /// @param STMCAS The STMCAS implementation (PO or PS)
@@ -17,23 +30,58 @@
 /// NB: OMAP must be templated on <K, V, STMCAS>
 template <typename K, typename V, class STMCAS, class OMAP>
 class ca_umap_list_adapter_t {
-  OMAP **buckets;             // The OMAPs that act as the buckets in the table.
+  /// The size of a huge page, which is also the alignment we use for the
+  /// bucket array when huge pages are requested
+  static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  /// A bucket, padded and aligned to a cache line, so that no two buckets share
+  /// a line
+  struct alignas(std::max<size_t>(alignof(OMAP), 64)) slot_t {
+    OMAP map; // The OMAP that holds this bucket's elements
+
+    /// Construct the bucket's (empty) OMAP
+    ///
+    /// @param me  The operation that is constructing the table.
+    /// @param cfg A configuration object for the OMAP
+    slot_t(STMCAS *me, auto *cfg) : map(me, cfg) {}
+  };
+
+  slot_t *buckets;            // The OMAPs that act as the buckets in the table.
   const uint64_t num_buckets; // The number of buckets in the table.
 
 public:
   /// Create a non-resizable hash table with the specified number of buckets.
   ///
   /// @param me  The operation that is constructing the table.
-  /// @param cfg A configuration object with a `buckets` field
+  /// @param cfg A configuration object with `buckets` and `huge_pages` fields
   ca_umap_list_adapter_t(STMCAS *me, auto *cfg) : num_buckets(cfg->buckets) {
-    buckets = (OMAP **)malloc(num_buckets * sizeof(OMAP *));
+    buckets = alloc_buckets(cfg->huge_pages);
 
-    // Fill the "buckets" vector with singly-linked lists.
-    for (unsigned int i = 0; i < num_buckets; ++i)
-      buckets[i] = new OMAP(me, cfg);
+    // Construct an (empty) OMAP in each slot of the "buckets" array
+    for (uint64_t i = 0; i < num_buckets; ++i)
+      new (&buckets[i]) slot_t(me, cfg);
   }
 
 private:
+  /// Allocate uninitialized, suitably aligned space for all of the buckets
+  ///
+  /// @param huge_pages True to ask the OS to back the array with huge pages
+  ///
+  /// @return A pointer to space for `num_buckets` slots
+  slot_t *alloc_buckets(bool huge_pages) {
+    size_t align = huge_pages ? HUGE_PAGE_SIZE : alignof(slot_t);
+    // NB: aligned_alloc requires the size to be a multiple of the alignment
+    size_t bytes = (num_buckets * sizeof(slot_t) + align - 1) / align * align;
+    void *mem = std::aligned_alloc(align, bytes);
+    if (mem == nullptr)
+      throw std::bad_alloc();
+    // NB: This is only advice.  If huge pages are not available, we still get
+    //     a contiguous array, just backed by regular pages.
+    if (huge_pages)
+      madvise(mem, bytes, MADV_HUGEPAGE);
+    return static_cast<slot_t *>(mem);
+  }
+
   std::hash<K> pre_hash;
 
   /// Get the index of the bucket where the provided key belongs
@@ -58,7 +106,7 @@ public:
   /// @return True if the key is found, false otherwise.  The reference
   ///         parameter `val` is only valid when the return value is true.
   bool get(STMCAS *me, const K &key, V &val) {
-    return buckets[hash(me, key)]->get(me, key, val);
+    return buckets[hash(me, key)].map.get(me, key, val);
   }
 
   /// Create a mapping from the provided `key` to the provided `val`, but only
@@ -71,7 +119,7 @@ public:
   ///
   /// @return True if the value was inserted, false otherwise.
   bool insert(STMCAS *me, const K &key, V &val) {
-    return buckets[hash(me, key)]->insert(me, key, val);
+    return buckets[hash(me, key)].map.insert(me, key, val);
   }
 
   /// Clear the mapping involving the provided `key`.
@@ -81,6 +129,6 @@ public:
   ///
   /// @return True if the key was found and removed, false otherwise
   bool remove(STMCAS *me, const K &key) {
-    return buckets[hash(me, key)]->remove(me, key);
+    return buckets[hash(me, key)].map.remove(me, key);
   }
 };
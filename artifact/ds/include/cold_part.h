@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+/// The alignment to use for the "hot" part of a node.  When a node is split,
+/// its hot part (orec, key, and the links that a search follows) should sit in
+/// a single cache line, so we align it to the cache line size.  Otherwise, we
+/// keep the node's natural alignment.
+///
+/// @tparam T     The natural type of the node's base class
+/// @tparam SPLIT True if the node is split into hot and cold parts
+template <class T, bool SPLIT>
+inline constexpr size_t hot_align_v = SPLIT ? 64 : alignof(T);
+
+/// cold_part_t holds the fields of a node that are not needed by searches or
+/// by rebalancing (typically just the value).  It can be stored inline in the
+/// node, which is the traditional layout, or in a separate allocation that the
+/// node owns.  The separate allocation keeps the part of the node that every
+/// traversal touches small, so that fewer cache lines are visited per lookup,
+/// at the cost of one extra miss when the cold part is actually needed.
+///
+/// Either way, the cold part is accessed via operator->, so that data
+/// structures can be written once and instantiated with either layout.
+///
+/// NB: The cold part has the same lifetime as the node, so it is reclaimed
+///     whenever SMR reclaims the node.  Fields in the cold part are protected
+///     by the node's orec.
+///
+/// @tparam C     The type holding the cold fields
+/// @tparam SPLIT True to store `C` in a separate allocation
+template <class C, bool SPLIT> class cold_part_t;
+
+/// The inline (unsplit) specialization of cold_part_t
+template <class C> class cold_part_t<C, false> {
+  C _cold; // The cold fields, stored inline
+
+public:
+  /// Construct the cold fields inline
+  ///
+  /// @param args The arguments to forward to C's constructor
+  template <typename... A>
+  explicit cold_part_t(A &&...args) : _cold(std::forward<A>(args)...) {}
+
+  /// Access the cold fields
+  C *operator->() { return &_cold; }
+
+  /// Access the cold fields from a const node
+  const C *operator->() const { return &_cold; }
+};
+
+/// The split specialization of cold_part_t
+template <class C> class cold_part_t<C, true> {
+  C *const _cold; // The cold fields, stored in a separate allocation
+
+public:
+  /// Construct the cold fields in their own allocation
+  ///
+  /// @param args The arguments to forward to C's constructor
+  template <typename... A>
+  explicit cold_part_t(A &&...args) : _cold(new C(std::forward<A>(args)...)) {}
+
+  /// Reclaim the cold fields along with the node that owns them
+  ~cold_part_t() { delete _cold; }
+
+  /// The cold fields belong to exactly one node, so cold_part_t is not copyable
+  /// or movable
+  cold_part_t(const cold_part_t &) = delete;
+  cold_part_t(cold_part_t &&) = delete;
+  cold_part_t &operator=(const cold_part_t &) = delete;
+  cold_part_t &operator=(cold_part_t &&) = delete;
+
+  /// Access the cold fields.  The pointer itself is immutable, so it does not
+  /// need any synchronization.
+  C *operator->() const { return _cold; }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <x86intrin.h>
+
+/// An update that a thread hands to a flat_combiner_t, because it was unable
+/// to apply it on its own.  Requests live on the publishing thread's stack:
+/// the publisher does not return until a combiner has set `done`, and the
+/// combiner does not touch a request after setting `done`.
+///
+/// @param K The type of the keys in the data structure
+/// @param V The type of the values in the data structure
+template <typename K, typename V> struct fc_request_t {
+  /// The kinds of update that can be combined
+  enum kind_t { INSERT, REMOVE };
+
+  const kind_t kind;              // The kind of update
+  const K key;                    // The key to insert or remove
+  const V val;                    // The value to insert (unused by REMOVE)
+  const int aux;                  // A data-structure-specific argument
+  bool result = false;            // The update's return value
+  std::atomic<bool> done = false; // Set (last) by the combiner that applied it
+  fc_request_t *next = nullptr;   // The next request in a publication list
+
+  /// Construct a request
+  ///
+  /// @param _kind The kind of update
+  /// @param _key  The key to insert or remove
+  /// @param _val  The value to insert
+  /// @param _aux  A data-structure-specific argument (e.g., a skiplist node's
+  ///              height, which must not change from one attempt to the next)
+  fc_request_t(kind_t _kind, const K &_key, const V &_val, int _aux = 0)
+      : kind(_kind), key(_key), val(_val), aux(_aux) {}
+};
+
+/// flat_combiner_t turns a convoy of threads that are all failing to acquire
+/// the same hot orec into a single writer.  A thread that gives up on applying
+/// its update directly publishes a request in the publication list of the shard
+/// that its key hashes to, and then either waits for the request to be
+/// completed, or becomes the shard's combiner.  The combiner detaches the whole
+/// list and hands it to the data structure, which is expected to apply as many
+/// of the requests as it can in each write step.
+///
+/// The publication lists are Treiber stacks.  Since the combiner detaches a
+/// list with a single exchange, and publishers never pop, there is no ABA
+/// problem.  The combiner reverses the list, so that requests are applied in
+/// the order they were published.
+///
+/// NB: The combiner lock only serializes combiners of the same shard.  The data
+///     structure's own orecs still protect the requests' writes, so combined
+///     and uncombined updates can run concurrently.
+///
+/// @param REQ    The request type (an fc_request_t)
+/// @param SHARDS The number of publication lists
+template <class REQ, int SHARDS> class flat_combiner_t {
+  /// A publication list and its combiner lock, padded to avoid false sharing
+  struct alignas(64) shard_t {
+    std::atomic<REQ *> pubs = nullptr; // Published requests, newest first
+    std::atomic<bool> lock = false;    // Held by the shard's combiner
+  };
+
+  shard_t shards[SHARDS]; // The publication lists
+
+public:
+  /// Publish `req` and wait for it to be applied, possibly by applying it (and
+  /// others) as the combiner.
+  ///
+  /// NB: The caller must not be in a WSTEP or RSTEP, since it may spin.
+  ///
+  /// @param hash  A hash of the request's key, for choosing a shard
+  /// @param req   The request to publish
+  /// @param apply A function that applies a list of requests, and uses
+  ///              finish() to complete them
+  ///
+  /// @return The request's result
+  template <class F> bool combine(uint64_t hash, REQ &req, F apply) {
+    shard_t &s = shards[hash % SHARDS];
+    REQ *head = s.pubs.load(std::memory_order_relaxed);
+    do {
+      req.next = head;
+    } while (!s.pubs.compare_exchange_weak(head, &req));
+
+    while (!req.done.load(std::memory_order_acquire)) {
+      if (s.lock.load(std::memory_order_relaxed) ||
+          s.lock.exchange(true, std::memory_order_acquire)) {
+        _mm_pause();
+        continue;
+      }
+      // Detach the list, reverse it, and apply it.  `req` might not be in it,
+      // if another combiner took it, in which case we'll just wait.
+      REQ *batch = s.pubs.exchange(nullptr), *fifo = nullptr;
+      while (batch) {
+        REQ *next = batch->next;
+        batch->next = fifo;
+        fifo = batch;
+        batch = next;
+      }
+      if (fifo)
+        apply(fifo);
+      s.lock.store(false, std::memory_order_release);
+    }
+    return req.result;
+  }
+
+  /// Complete the requests from `first` up to (but not including) `last`.
+  /// Call this only after the write step that applied them has committed.
+  ///
+  /// @param first The first request to complete
+  /// @param last  The request after the last one to complete (or nullptr)
+  static void finish(REQ *first, REQ *last) {
+    while (first != last) {
+      // NB: read `next` first, since `first` may vanish once `done` is set
+      REQ *next = first->next;
+      first->done.store(true, std::memory_order_release);
+      first = next;
+    }
+  }
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+/// hot_node_cache_t is a small, per-thread, direct-mapped cache of the nodes
+/// that recent lookups found, so that repeated lookups of hot keys can skip the
+/// traversal.  Each entry records a key, the node that held it, the node's orec
+/// version when it was validated, and the start time of the operation that
+/// found it.
+///
+/// The cache is private to a thread, so it needs no synchronization.  Instead,
+/// a hit is only trusted after three checks:
+/// - SMR must not have reclaimed anything that was unlinked after the entry's
+///   operation started (checked before and after reading the node), so that the
+///   node's memory is still the node that was cached.
+/// - The node's orec must not be newer than the cached version, which rules out
+///   removal (removing a node always acquires its orec) and any other change.
+/// - The node's key must still be the cached key.
+///
+/// Any failed check just drops the entry, and the caller falls back to its
+/// normal traversal.  Only successful lookups are cached.
+///
+/// NB: There is one cache per thread per data structure type.  It remembers
+///     which data structure filled it, and resets when used with another one,
+///     so threads that alternate between two maps of the same type will not
+///     benefit.
+///
+/// @param K    The type of the keys
+/// @param NODE The type of the nodes that hold keys
+/// @param SIZE The number of entries
+template <typename K, class NODE, int SIZE = 64> class hot_node_cache_t {
+public:
+  /// An entry in the cache
+  struct entry_t {
+    K key;                // The key that was found
+    NODE *node = nullptr; // The node that held `key`, or nullptr if unused
+    uint64_t ver = 0;     // The node's orec version, when it was validated
+    uint64_t time = 0;    // The start time of the operation that found it
+  };
+
+private:
+  const void *owner = nullptr; // The data structure that filled the cache
+  entry_t entries[SIZE];       // The entries
+
+public:
+  /// Get the calling thread's cache for a data structure
+  ///
+  /// @param ds The data structure that is using the cache
+  ///
+  /// @return The calling thread's cache, emptied if it was last used by a
+  ///         different data structure
+  static hot_node_cache_t &get(const void *ds) {
+    static thread_local hot_node_cache_t cache;
+    if (cache.owner != ds) {
+      for (auto &e : cache.entries)
+        e.node = nullptr;
+      cache.owner = ds;
+    }
+    return cache;
+  }
+
+  /// Find the entry for a key, if there is one
+  ///
+  /// @param hash A hash of `key`
+  /// @param key  The key to look up
+  ///
+  /// @return The key's entry, or nullptr
+  entry_t *find(uint64_t hash, const K &key) {
+    entry_t &e = entries[hash % SIZE];
+    return (e.node != nullptr && e.key == key) ? &e : nullptr;
+  }
+
+  /// Record that a lookup found a key, replacing whatever was in its entry
+  ///
+  /// @param hash A hash of `key`
+  /// @param key  The key that was found
+  /// @param node The node that held `key`
+  /// @param ver  The node's orec version, when it was validated
+  /// @param time The start time of the operation that found `node`
+  void put(uint64_t hash, const K &key, NODE *node, uint64_t ver,
+           uint64_t time) {
+    entries[hash % SIZE] = {key, node, ver, time};
+  }
+
+  /// Drop an entry that failed validation
+  ///
+  /// @param e The entry to drop
+  void drop(entry_t *e) { e->node = nullptr; }
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+/// The most updates that one multi-key operation may have.  Data structures
+/// size their per-operation buffers by it, so callers must check it.
+const int MK_MAX_KEYS = 32;
+
+/// One single-key update within a multi-key operation.  A multi-key operation
+/// applies all of its updates atomically, but only if every update's
+/// precondition holds.  Otherwise, it changes nothing.
+///
+/// @param K The type of the keys in the data structure
+/// @param V The type of the values in the data structure
+template <typename K, typename V> struct mk_op_t {
+  /// The kinds of update that can be part of a multi-key operation
+  enum kind_t {
+    INSERT, // Insert `key` -> `val`.  Requires `key` to be absent.
+    REMOVE, // Remove `key`.  Requires `key` to be present.
+    CAS,    // Set `key`'s value to `val`.  Requires it to be `expected`.
+  };
+
+  kind_t kind; // The kind of update
+  K key;       // The key to update
+  V val;       // The value to insert, or CAS's new value
+  V expected;  // CAS's expected value (unused by INSERT and REMOVE)
+};
+
+/// mk_lockset_t collects the objects, and their observed orec values, that a
+/// multi-key operation's read-only searches depended on, so that they can all
+/// be acquired in one WSTEP.  The storage is provided by the caller, since its
+/// size depends on the number of keys.
+///
+/// Orecs are acquired in address order, so that two multi-key operations that
+/// overlap always contend for their first shared orec first, rather than each
+/// acquiring some of the other's orecs.  When the same orec was observed more
+/// than once (e.g., two keys with the same predecessor, or objects that share
+/// an orec in the PS policy), the oldest observation is the one that must
+/// still hold.
+///
+/// @param STMCAS The STMCAS implementation (PO or PS)
+template <class STMCAS> class mk_lockset_t {
+  using WSTEP = typename STMCAS::WSTEP;
+  using ownable_t = typename STMCAS::ownable_t;
+
+public:
+  /// An object and the orec value that a search observed for it
+  struct entry_t {
+    ownable_t *obj; // The object
+    void *orec;     // The object's orec, which is what we sort by
+    uint64_t ver;   // The observed orec value
+  };
+
+private:
+  entry_t *entries; // The caller-provided storage
+  int count = 0;    // The number of entries in use
+
+public:
+  /// Construct an empty lock set
+  ///
+  /// @param buf Storage for as many entries as the operation may need
+  mk_lockset_t(entry_t *buf) : entries(buf) {}
+
+  /// Forget all entries, so that a failed attempt can be re-planned
+  void clear() { count = 0; }
+
+  /// Record that an operation depends on `obj`'s orec still being `ver`
+  ///
+  /// @param obj The object to acquire
+  /// @param ver The orec value that was observed for `obj`
+  void add(ownable_t *obj, uint64_t ver) {
+    entries[count++] = {obj, (void *)obj->orec(), ver};
+  }
+
+  /// Acquire every orec in the set, in address order, as long as each still
+  /// has (at most) its observed value
+  ///
+  /// @param tx The WSTEP that should hold the orecs
+  ///
+  /// @return True if everything was acquired, false if the caller must unwind
+  bool acquire_all(WSTEP &tx) {
+    std::sort(entries, entries + count, [](const entry_t &a, const entry_t &b) {
+      return a.orec < b.orec || (a.orec == b.orec && a.ver < b.ver);
+    });
+    for (int i = 0; i < count; ++i) {
+      // The first entry for an orec has the oldest version, so skip the rest
+      if (i > 0 && entries[i].orec == entries[i - 1].orec)
+        continue;
+      if (!tx.acquire_continuation(entries[i].obj, entries[i].ver))
+        return false;
+    }
+    return true;
+  }
+};
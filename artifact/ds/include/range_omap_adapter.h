@@ -0,0 +1,468 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <x86intrin.h>
+
+/// A range-partitioned ordered map.  The key space is split into a fixed number
+/// of contiguous ranges ("shards"), each of which is backed by its own ordered
+/// map.  This spreads the sentinel / near-root traffic of a single tree over
+/// many trees, while preserving key order across shards.  This map supports
+/// get(), insert(), remove(), and range() operations, and update() if OMAP
+/// does.
+///
+/// Shard boundaries are not fixed: when a shard becomes much larger than one of
+/// its neighbors, the boundary between them is moved, and the keys that change
+/// shards are migrated.  Every operation announces itself, and the shard it is
+/// using, in a per-thread slot.  A rebalancer first freezes the two shards
+/// involved and waits for operations on them to drain, then walks the keys that
+/// must move (with OMAP's get_geq()) while operations on other shards continue.
+/// Only the boundary update itself is "stop the world": the rebalancer closes a
+/// seqlock-style gate and waits for in-flight operations to drain before
+/// writing the new split point.  Operations never block each other, only the
+/// (rare) rebalancer.
+///
+/// NB: Migration and range() find the next key with get_geq(), and step to the
+///     key after it, so K must be an integral type.
+///
+/// @param K          The type of the keys stored in this map
+/// @param V          The type of the values stored in this map
+/// @param DESCRIPTOR The thread descriptor type used by OMAP
+/// @param OMAP       An ordered map type to use as each shard
+///
+/// NB: OMAP must be constructable from <DESCRIPTOR*, cfg*>, and must have
+///     get_geq()
+template <typename K, typename V, class DESCRIPTOR, class OMAP>
+class range_omap_adapter_t {
+  static_assert(std::is_integral<K>::value,
+                "range_omap_adapter_t requires integral keys");
+
+  /// Maximum number of threads that can concurrently use the map
+  static const int MAX_THREADS = 256;
+
+  /// The value of a thread's slot when it is not in an operation
+  static const uint64_t IDLE = ULLONG_MAX;
+
+  /// The shard of a thread's slot when it is not using a shard
+  static const size_t NO_SHARD = SIZE_MAX;
+
+  /// Check for skew once per this many successful inserts (per thread, on
+  /// average)
+  static const uint32_t REBALANCE_SAMPLE = 1024;
+
+  /// A shard is skewed if it is this many times larger than a neighbor
+  static const int64_t SKEW_FACTOR = 2;
+
+  /// Shards smaller than this are never considered skewed
+  static const int64_t MIN_REBALANCE_SIZE = 64;
+
+  /// A per-thread announcement slot, padded to avoid false sharing
+  struct alignas(64) slot_t {
+    std::atomic<uint64_t> epoch; // The gate epoch this thread entered, or IDLE
+    std::atomic<size_t> shard;   // The shard this thread is using, or NO_SHARD
+
+    /// Construct an idle slot
+    slot_t() : epoch(IDLE), shard(NO_SHARD) {}
+  };
+
+  /// A shard, with an approximate count of its elements.  Padded so that
+  /// counter updates in one shard do not interfere with another.
+  struct alignas(64) shard_t {
+    OMAP *map;                 // The ordered map holding this shard's keys
+    std::atomic<int64_t> size; // The number of elements in the shard
+    std::atomic<bool> frozen;  // True while keys migrate into or out of it
+
+    /// Construct an empty, unassigned shard
+    shard_t() : map(nullptr), size(0), frozen(false) {}
+  };
+
+  const size_t num_shards; // The number of shards
+  shard_t *shards;         // The shards, in key order
+  K *splits;               // splits[i] is the lowest key of shard i+1
+  const K domain_lo;       // The lowest key that rebalancing will migrate
+  const K domain_hi;       // One past the highest key rebalancing will migrate
+
+  /// Even while the routing is stable, odd while a split point is being moved
+  std::atomic<uint64_t> gate;
+
+  /// True while a thread is rebalancing, so that there is only one at a time
+  std::atomic<bool> rebalancing;
+
+  slot_t slots[MAX_THREADS]; // Announcement slots for in-flight operations
+
+  /// Which slot indices are held by live threads
+  static inline std::atomic<bool> slot_taken[MAX_THREADS];
+
+  /// One past the highest slot index that any thread has ever held
+  static inline std::atomic<int> slot_count{0};
+
+  /// A thread's claim on a slot index, which it gives back when it exits, so
+  /// that the index can be reused by later threads
+  struct slot_claim_t {
+    int index = -1; // The claimed index, or -1 if none
+
+    /// Release the claimed index, if any
+    ~slot_claim_t() {
+      if (index >= 0)
+        slot_taken[index].store(false, std::memory_order_release);
+    }
+  };
+
+  /// Get the calling thread's announcement slot index
+  ///
+  /// NB: Terminates the program if more than MAX_THREADS threads are alive
+  static int my_slot() {
+    static thread_local slot_claim_t claim;
+    if (claim.index < 0) {
+      for (int i = 0; i < MAX_THREADS && claim.index < 0; ++i) {
+        bool expected = false;
+        if (!slot_taken[i].load(std::memory_order_relaxed) &&
+            slot_taken[i].compare_exchange_strong(expected, true))
+          claim.index = i;
+      }
+      if (claim.index < 0) {
+        fprintf(stderr, "range_omap_adapter_t: at most %d threads at once\n",
+                MAX_THREADS);
+        std::terminate();
+      }
+      // NB: seq_cst, so a rebalancer that sees our announcement in enter()
+      //     also sees our slot
+      int n = slot_count.load();
+      while (n <= claim.index &&
+             !slot_count.compare_exchange_weak(n, claim.index + 1))
+        ;
+    }
+    return claim.index;
+  }
+
+public:
+  /// Create a range-partitioned map with the specified number of shards,
+  /// splitting the configured key range evenly among them.
+  ///
+  /// @param me  The operation that is constructing the map.
+  /// @param cfg A configuration object with `shards` and `key_range` fields
+  range_omap_adapter_t(DESCRIPTOR *me, auto *cfg)
+      : num_shards(cfg->shards > 0 ? cfg->shards : 1),
+        shards(new shard_t[num_shards]), splits(new K[num_shards]),
+        domain_lo(0), domain_hi(cfg->key_range), gate(0), rebalancing(false) {
+    for (size_t i = 0; i < num_shards; ++i) {
+      shards[i].map = new OMAP(me, cfg);
+      // NB: 64-bit math, since (domain_hi - domain_lo) * (i + 1) can overflow K
+      uint64_t width = (uint64_t)domain_hi - (uint64_t)domain_lo;
+      splits[i] = domain_lo + (K)(width * (i + 1) / num_shards);
+    }
+  }
+
+private:
+  /// Enter the gate, waiting for any in-progress split point update to finish
+  ///
+  /// @return The announcement slot of the calling thread
+  slot_t &enter() {
+    slot_t &s = slots[my_slot()];
+    while (true) {
+      uint64_t e = gate.load(std::memory_order_acquire);
+      if (e & 1) {
+        _mm_pause();
+        continue;
+      }
+      // NB: seq_cst store and load, so that a rebalancer that closes the gate
+      //     either sees our announcement or we see the closed gate
+      s.epoch.store(e);
+      if (gate.load() == e)
+        return s;
+      s.epoch.store(IDLE, std::memory_order_release);
+    }
+  }
+
+  /// Enter the gate and claim the shard that holds `key`, waiting for any
+  /// migration that involves that shard to finish
+  ///
+  /// @param key The key that the operation will access
+  /// @param i   A ref parameter for returning the index of the claimed shard
+  ///
+  /// @return The announcement slot of the calling thread
+  slot_t &enter(const K &key, size_t &i) {
+    while (true) {
+      slot_t &s = enter();
+      i = route(key);
+      // NB: seq_cst store and load, so that a rebalancer that freezes shard i
+      //     either sees our claim or we see the freeze
+      s.shard.store(i);
+      if (!shards[i].frozen.load())
+        return s;
+      // Wait outside of the gate, so that the rebalancer can move the split
+      // point, and then route again
+      exit(s);
+      while (shards[i].frozen.load(std::memory_order_acquire))
+        _mm_pause();
+    }
+  }
+
+  /// Exit the gate, and release the claimed shard, if any
+  ///
+  /// @param s The slot returned by enter()
+  void exit(slot_t &s) {
+    s.shard.store(NO_SHARD, std::memory_order_release);
+    s.epoch.store(IDLE, std::memory_order_release);
+  }
+
+  /// Find the index of the shard that holds `key`
+  ///
+  /// NB: Must be called from within the gate
+  ///
+  /// @param key The key to route
+  ///
+  /// @return The index of the shard whose range includes `key`
+  size_t route(const K &key) const {
+    size_t lo = 0, hi = num_shards - 1;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (key < splits[mid])
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  }
+
+  /// Get the lowest key that rebalancing will migrate out of shard `i`
+  K shard_lo(size_t i) const { return i == 0 ? domain_lo : splits[i - 1]; }
+
+  /// Get one past the highest key that rebalancing will migrate out of shard
+  /// `i`
+  K shard_hi(size_t i) const {
+    return i == num_shards - 1 ? domain_hi : splits[i];
+  }
+
+  /// After a successful insert into shard `i`, occasionally check if `i` is
+  /// skewed relative to its smaller neighbor, and if so, rebalance.
+  ///
+  /// NB: Must be called from within the gate, with `s` being the caller's slot,
+  ///     which has claimed shard `i`
+  ///
+  /// @param me The calling thread's descriptor
+  /// @param s  The caller's announcement slot
+  /// @param i  The shard that just grew
+  void maybe_rebalance(DESCRIPTOR *me, slot_t &s, size_t i) {
+    if (num_shards == 1 || (uint32_t)me->rand() % REBALANCE_SAMPLE != 0)
+      return;
+    int64_t my_size = shards[i].size.load(std::memory_order_relaxed);
+    if (my_size < MIN_REBALANCE_SIZE)
+      return;
+    // Pick the smaller neighbor
+    size_t j = (i == 0) ? 1 : i - 1;
+    if (i > 0 && i < num_shards - 1 &&
+        shards[i + 1].size.load(std::memory_order_relaxed) <
+            shards[i - 1].size.load(std::memory_order_relaxed))
+      j = i + 1;
+    int64_t their_size = shards[j].size.load(std::memory_order_relaxed);
+    if (my_size <= SKEW_FACTOR * their_size)
+      return;
+
+    // If someone else is rebalancing, let them do it
+    bool busy = false;
+    if (!rebalancing.compare_exchange_strong(busy, true))
+      return;
+
+    // Freeze shards i and j, and wait for every other operation on them to
+    // drain.  Operations on other shards are not affected.
+    shards[i].frozen.store(true);
+    shards[j].frozen.store(true);
+    for (int t = 0, n = slot_count.load(); t < n; ++t) {
+      if (&slots[t] == &s)
+        continue;
+      size_t sh = slots[t].shard.load();
+      while (sh == i || sh == j) {
+        _mm_pause();
+        sh = slots[t].shard.load();
+      }
+    }
+
+    // Move enough of shard i's range to j to (roughly) even them out, assuming
+    // that keys are uniformly distributed within shard i
+    my_size = shards[i].size.load(std::memory_order_relaxed);
+    their_size = shards[j].size.load(std::memory_order_relaxed);
+    K lo = shard_lo(i), hi = shard_hi(i);
+    if (my_size > their_size && hi > lo) {
+      K width = (K)((hi - lo) * (double)(my_size - their_size) /
+                    (2.0 * my_size));
+      if (width > 0) {
+        K from = (j > i) ? (K)(hi - width) : lo;
+        K to = (j > i) ? hi : (K)(lo + width);
+        migrate(me, i, j, from, to);
+        move_split(s, (j > i) ? i : j, (j > i) ? from : to);
+      }
+    }
+
+    shards[i].frozen.store(false, std::memory_order_release);
+    shards[j].frozen.store(false, std::memory_order_release);
+    rebalancing.store(false, std::memory_order_release);
+  }
+
+  /// Move a split point, while no other operation is routing keys
+  ///
+  /// NB: Must be called by the rebalancer, from within the gate
+  ///
+  /// @param s     The caller's announcement slot
+  /// @param idx   The index of the split point to move
+  /// @param split The new lowest key of shard idx+1
+  void move_split(slot_t &s, size_t idx, K split) {
+    // Close the gate.  Only the rebalancer changes the gate, so it is even.
+    uint64_t e = gate.load(std::memory_order_relaxed);
+    gate.store(e + 1);
+
+    // Wait for every other in-flight operation to drain.  Operations that are
+    // waiting for a frozen shard do so outside of the gate.
+    for (int t = 0, n = slot_count.load(); t < n; ++t)
+      if (&slots[t] != &s)
+        while (slots[t].epoch.load() == e)
+          _mm_pause();
+
+    splits[idx] = split;
+
+    // Re-open the gate.  Our slot still holds `e`, which is fine: the next
+    // operation will announce the new epoch.
+    gate.store(e + 2, std::memory_order_release);
+  }
+
+  /// Move all keys in [from, to) from shard `src` to shard `dst`.  This visits
+  /// only the keys that are present, not every key in the range.
+  ///
+  /// NB: Must be called while `src` and `dst` are frozen
+  ///
+  /// @param me   The calling thread's descriptor
+  /// @param src  The shard from which keys are removed
+  /// @param dst  The shard into which keys are inserted
+  /// @param from The lowest key to move
+  /// @param to   One past the highest key to move
+  void migrate(DESCRIPTOR *me, size_t src, size_t dst, K from, K to) {
+    K k = from;
+    V val{};
+    while (from < to && shards[src].map->get_geq(me, from, k, val) && k < to) {
+      shards[src].map->remove(me, k);
+      shards[dst].map->insert(me, k, val);
+      shards[src].size.fetch_sub(1, std::memory_order_relaxed);
+      shards[dst].size.fetch_add(1, std::memory_order_relaxed);
+      from = k + 1;
+    }
+  }
+
+public:
+  /// Search the data structure for a node with key `key`.  If not found, return
+  /// false.  If found, return true, and set `val` to the value associated with
+  /// `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key to search
+  /// @param val A ref parameter for returning key's value, if found
+  ///
+  /// @return True if the key is found, false otherwise.  The reference
+  ///         parameter `val` is only valid when the return value is true.
+  bool get(DESCRIPTOR *me, const K &key, V &val) {
+    size_t i;
+    slot_t &s = enter(key, i);
+    bool res = shards[i].map->get(me, key, val);
+    exit(s);
+    return res;
+  }
+
+  /// Create a mapping from the provided `key` to the provided `val`, but only
+  /// if no such mapping already exists.  This method does *not* have upsert
+  /// behavior for keys already present.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to create
+  /// @param val The value for the mapping to create
+  ///
+  /// @return True if the value was inserted, false otherwise.
+  bool insert(DESCRIPTOR *me, const K &key, V &val) {
+    size_t i;
+    slot_t &s = enter(key, i);
+    bool res = shards[i].map->insert(me, key, val);
+    if (res) {
+      shards[i].size.fetch_add(1, std::memory_order_relaxed);
+      maybe_rebalance(me, s, i);
+    }
+    exit(s);
+    return res;
+  }
+
+  /// Replace the value associated with `key`, if `key` is present.  This is
+  /// only available if OMAP has update().
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key whose value should change
+  /// @param val The new value
+  ///
+  /// @return True if the key was found and its value replaced
+  bool update(DESCRIPTOR *me, const K &key, V &val) {
+    size_t i;
+    slot_t &s = enter(key, i);
+    bool res = shards[i].map->update(me, key, val);
+    exit(s);
+    return res;
+  }
+
+  /// Clear the mapping involving the provided `key`.
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param key The key for the mapping to eliminate
+  ///
+  /// @return True if the key was found and removed, false otherwise
+  bool remove(DESCRIPTOR *me, const K &key) {
+    size_t i;
+    slot_t &s = enter(key, i);
+    bool res = shards[i].map->remove(me, key);
+    if (res)
+      shards[i].size.fetch_sub(1, std::memory_order_relaxed);
+    exit(s);
+    return res;
+  }
+
+  /// Visit every mapping whose key is in [lo, hi], in key order, even if the
+  /// range spans several shards.  The query is not atomic: each step finds the
+  /// next key with one get_geq() on the shard that holds it, so each key is
+  /// individually linearizable, and concurrent updates to other keys in the
+  /// range may or may not be observed.  A rebalance can run between steps.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param lo      The smallest key to visit
+  /// @param hi      The largest key to visit
+  /// @param visitor A function to call with each found (key, value) pair
+  ///
+  /// @return The number of mappings that were visited
+  template <class F>
+  size_t range(DESCRIPTOR *me, const K &lo, const K &hi, F visitor) {
+    size_t found = 0;
+    K next = lo;
+    while (!(hi < next)) {
+      size_t i;
+      slot_t &s = enter(next, i);
+      // Find the next key in shard i, and where shard i ends
+      bool last = (i == num_shards - 1);
+      K end = last ? hi : splits[i];
+      K k = next;
+      V val{};
+      bool res = shards[i].map->get_geq(me, next, k, val) && !(hi < k) &&
+                 (last || k < end);
+      exit(s);
+      if (res) {
+        visitor(k, val);
+        ++found;
+        if (k == hi)
+          break;
+        next = k + 1;
+      } else if (last) {
+        break;
+      } else {
+        next = end; // Continue in the next shard
+      }
+    }
+    return found;
+  }
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+/// The kinds of items that the travel reservation ("vacation") application
+/// manages.  Each kind has its own table.
+enum vacation_kind_t { CAR = 0, FLIGHT = 1, ROOM = 2, NUM_KINDS = 3 };
+
+/// One query of a travel reservation transaction.  A reservation uses `kind`
+/// and `id`, to ask about an item.  A table update also uses `add` and `price`,
+/// to add capacity to an item (creating it if needed) or remove capacity from
+/// it (deleting it when it has none left).
+///
+/// Queries are generated outside of transactions, and then a whole batch of
+/// them is run as one transaction, like the client in STAMP's vacation.
+struct vacation_query_t {
+  vacation_kind_t kind; // The table to query
+  int id;               // The item to query
+  bool add;             // For updates, add (true) or remove (false) capacity
+  int price;            // For updates that add capacity, the item's new price
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+#include "../../policies/xSTM/common/tm_api.h"
+#include "../include/vacation_query.h"
+
+// NB: We need an operator new().  It can just forward to malloc()
+TX_RENAME(_Znwm) void *my_new(std::size_t size) {
+  void *ptr = malloc(size);
+  return ptr;
+}
+
+/// A travel reservation system, modeled on the "vacation" application from
+/// STAMP.  There are tables of cars, flights, and rooms, which map each item's
+/// id to its capacity and price, and a table of customers, each of which has a
+/// list of the reservations it holds.  Clients make reservations, cancel all of
+/// a customer's reservations, and add or remove capacity.  Each of these is one
+/// transaction that touches several tables.
+///
+/// STAMP uses red-black trees for its tables.  Here, each table is a hash table
+/// whose chains are sorted by id, and hold about CHAIN_LENGTH entries each.
+/// This is the same application, with the same tables, as
+/// ds/handSTM/vacation.h, but written as plain C++ in TX_RAII transactions, so
+/// that the xSTM plugin instruments it.  Comparing the two shows the cost of
+/// compiler instrumentation on whole-application code.
+///
+/// @param DESCRIPTOR A thread descriptor type, for safe memory reclamation
+template <class DESCRIPTOR> class vacation_t {
+  /// The capacity that one table update adds to or removes from an item
+  static const int UNITS = 100;
+
+  /// The average number of entries per hash chain
+  static const int CHAIN_LENGTH = 8;
+
+  /// A car, flight, or room
+  struct item_t {
+    const int id; // The item's id
+    int total;    // The item's capacity
+    int free;     // The capacity that is not reserved
+    int price;    // The price of reserving the item
+    item_t *next; // The next item in the chain
+
+    /// Construct an item with no reservations
+    ///
+    /// @param id    The item's id
+    /// @param total The item's capacity
+    /// @param price The price of reserving the item
+    item_t(int id, int total, int price)
+        : id(id), total(total), free(total), price(price), next(nullptr) {
+      TX_CTOR;
+    }
+  };
+
+  /// A reservation held by a customer.  It is immutable, except for `next`.
+  struct resv_t {
+    const vacation_kind_t kind; // The kind of item that was reserved
+    const int id;               // The id of the item that was reserved
+    const int price;            // The price that was paid
+    resv_t *next;               // The customer's next reservation
+
+    /// Construct a reservation
+    ///
+    /// @param kind  The kind of item that was reserved
+    /// @param id    The id of the item that was reserved
+    /// @param price The price that was paid
+    resv_t(vacation_kind_t kind, int id, int price)
+        : kind(kind), id(id), price(price), next(nullptr) {
+      TX_CTOR;
+    }
+  };
+
+  /// A customer
+  struct customer_t {
+    const int id;     // The customer's id
+    resv_t *resvs;    // The customer's reservations
+    customer_t *next; // The next customer in the chain
+
+    /// Construct a customer with no reservations
+    ///
+    /// @param id The customer's id
+    customer_t(int id) : id(id), resvs(nullptr), next(nullptr) { TX_CTOR; }
+  };
+
+  /// The head of a hash chain
+  template <class T> struct bucket_t {
+    T *head; // The first entry in the chain
+
+    /// Construct an empty chain
+    bucket_t() : head(nullptr) {}
+  };
+
+  const size_t num_buckets;           // The number of buckets in each table
+  bucket_t<item_t> *items[NUM_KINDS]; // The tables of cars, flights, and rooms
+  bucket_t<customer_t> *customers;    // The table of customers
+
+  /// Find the bucket for an id
+  ///
+  /// @param table The table to search
+  /// @param id    The id to find
+  ///
+  /// @return The bucket whose chain holds `id`, if it is in the table
+  template <class T> bucket_t<T> *bucket(bucket_t<T> *table, int id) {
+    return &table[(size_t)id % num_buckets];
+  }
+
+  /// Search a chain for the entry with a given id
+  ///
+  /// @param b    The bucket to search
+  /// @param id   The id to find
+  /// @param prev A ref param for returning the entry before the one with `id`
+  ///             (or where it would be), or nullptr if it is the first
+  ///
+  /// @return The entry with `id`, or nullptr if there is none
+  template <class T> T *find(bucket_t<T> *b, int id, T *&prev) {
+    prev = nullptr;
+    T *curr = b->head;
+    while (curr && curr->id < id) {
+      prev = curr;
+      curr = curr->next;
+    }
+    return (curr && curr->id == id) ? curr : nullptr;
+  }
+
+  /// Link a new entry into a chain
+  ///
+  /// @param b    The bucket whose chain gets the entry
+  /// @param prev The entry to link after, or nullptr to link at the head
+  /// @param node The new entry
+  template <class T> void link(bucket_t<T> *b, T *prev, T *node) {
+    if (prev) {
+      node->next = prev->next;
+      prev->next = node;
+    } else {
+      node->next = b->head;
+      b->head = node;
+    }
+  }
+
+  /// Unlink an entry from a chain, and reclaim it
+  ///
+  /// @param b    The bucket whose chain holds the entry
+  /// @param prev The entry before `node`, or nullptr if `node` is the first
+  /// @param node The entry to remove
+  template <class T> void unlink(bucket_t<T> *b, T *prev, T *node) {
+    if (prev)
+      prev->next = node->next;
+    else
+      b->head = node->next;
+    delete node;
+  }
+
+  /// Add an item, in its own transaction.  Used to populate the tables.
+  ///
+  /// @param kind  The kind of item
+  /// @param id    The item's id
+  /// @param total The item's capacity
+  /// @param price The price of reserving the item
+  void add_item(vacation_kind_t kind, int id, int total, int price) {
+    TX_RAII;
+    auto b = bucket(items[kind], id);
+    item_t *prev;
+    if (!find(b, id, prev))
+      link(b, prev, new item_t(id, total, price));
+  }
+
+  /// Add a customer, in its own transaction.  Used to populate the tables.
+  ///
+  /// @param id The customer's id
+  void add_customer(int id) {
+    TX_RAII;
+    auto b = bucket(customers, id);
+    customer_t *prev;
+    if (!find(b, id, prev))
+      link(b, prev, new customer_t(id));
+  }
+
+public:
+  /// Construct the tables, and populate them with `cfg->key_range` customers
+  /// and `cfg->key_range` items of each kind, with random capacities and
+  /// prices (as in STAMP)
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param cfg A configuration object with a `key_range` field
+  vacation_t(DESCRIPTOR *, auto *cfg)
+      : num_buckets(std::max<size_t>(1, cfg->key_range / CHAIN_LENGTH)) {
+    for (int k = 0; k < NUM_KINDS; ++k)
+      items[k] = new bucket_t<item_t>[num_buckets];
+    customers = new bucket_t<customer_t>[num_buckets];
+    std::mt19937 mt(0);
+    for (size_t id = 0; id < cfg->key_range; ++id) {
+      for (int k = 0; k < NUM_KINDS; ++k)
+        add_item((vacation_kind_t)k, id, (mt() % 5 + 1) * UNITS,
+                 (mt() % 5) * 10 + 50);
+      add_customer(id);
+    }
+  }
+
+  /// Reserve the most expensive available item of each kind that the queries
+  /// ask about, on behalf of a customer.  The customer is created if it does
+  /// not exist.  A customer never holds two reservations for the same item.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param cid     The customer's id
+  /// @param queries The items to consider
+  /// @param num     The number of queries
+  ///
+  /// @return True if at least one reservation was made
+  bool reserve(DESCRIPTOR *, int cid, vacation_query_t *queries, int num) {
+    TX_RAII;
+    // Find the most expensive available item of each kind
+    item_t *best[NUM_KINDS] = {nullptr};
+    int best_price[NUM_KINDS] = {-1, -1, -1};
+    for (int i = 0; i < num; ++i) {
+      auto kind = queries[i].kind;
+      item_t *prev;
+      item_t *item = find(bucket(items[kind], queries[i].id), queries[i].id,
+                          prev);
+      if (!item || item->free == 0)
+        continue;
+      int price = item->price;
+      if (price > best_price[kind]) {
+        best[kind] = item;
+        best_price[kind] = price;
+      }
+    }
+    if (!best[CAR] && !best[FLIGHT] && !best[ROOM])
+      return false;
+
+    // Find or create the customer
+    auto cb = bucket(customers, cid);
+    customer_t *cprev;
+    customer_t *c = find(cb, cid, cprev);
+    if (!c) {
+      c = new customer_t(cid);
+      link(cb, cprev, c);
+    }
+
+    // Reserve each item, unless the customer already holds it
+    bool made = false;
+    for (int k = 0; k < NUM_KINDS; ++k) {
+      if (!best[k])
+        continue;
+      bool held = false;
+      for (auto r = c->resvs; r && !held; r = r->next)
+        held = r->kind == k && r->id == best[k]->id;
+      if (held)
+        continue;
+      --best[k]->free;
+      auto r = new resv_t((vacation_kind_t)k, best[k]->id, best_price[k]);
+      r->next = c->resvs;
+      c->resvs = r;
+      made = true;
+    }
+    return made;
+  }
+
+  /// Cancel all of a customer's reservations, returning their capacity to the
+  /// items, and then remove the customer
+  ///
+  /// @param me  The calling thread's descriptor
+  /// @param cid The customer's id
+  ///
+  /// @return True if the customer existed
+  bool cancel(DESCRIPTOR *, int cid) {
+    TX_RAII;
+    auto cb = bucket(customers, cid);
+    customer_t *cprev;
+    customer_t *c = find(cb, cid, cprev);
+    if (!c)
+      return false;
+    for (auto r = c->resvs; r;) {
+      // NB: An item with reservations is never deleted
+      item_t *prev;
+      item_t *item = find(bucket(items[r->kind], r->id), r->id, prev);
+      if (item)
+        ++item->free;
+      auto next = r->next;
+      delete r;
+      r = next;
+    }
+    unlink(cb, cprev, c);
+    return true;
+  }
+
+  /// Add or remove capacity.  Adding capacity to an item that does not exist
+  /// creates it.  Capacity can only be removed from an item if at least UNITS
+  /// of it are free, and an item is deleted when it has no capacity left.
+  ///
+  /// @param me      The calling thread's descriptor
+  /// @param queries The items to update
+  /// @param num     The number of queries
+  ///
+  /// @return True if any item changed
+  bool update(DESCRIPTOR *, vacation_query_t *queries, int num) {
+    TX_RAII;
+    bool changed = false;
+    for (int i = 0; i < num; ++i) {
+      auto &q = queries[i];
+      auto b = bucket(items[q.kind], q.id);
+      item_t *prev;
+      item_t *item = find(b, q.id, prev);
+      if (q.add) {
+        if (!item) {
+          link(b, prev, new item_t(q.id, UNITS, q.price));
+        } else {
+          item->total += UNITS;
+          item->free += UNITS;
+          item->price = q.price;
+        }
+        changed = true;
+      } else if (item && item->free >= UNITS) {
+        int total = item->total - UNITS;
+        if (total == 0) {
+          unlink(b, prev, item);
+        } else {
+          item->total = total;
+          item->free -= UNITS;
+        }
+        changed = true;
+      }
+    }
+    return changed;
+  }
+};
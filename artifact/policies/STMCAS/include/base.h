@@ -41,9 +41,11 @@ protected:
 
   static global_t _globals; // lightweight singleton-like access to the globals
 
-  exotm_t exo;         // The thread's exoTM context
-  timestamp_smr_t smr; // The safe memory reclamation context
-  rdtsc_rand_t rng;    // A random number generator
+  exotm_t exo;                // The thread's exoTM context
+  timestamp_smr_t smr;        // The safe memory reclamation context
+  rdtsc_rand_t rng;           // A random number generator
+  uint64_t conflicts = 0;     // Failed validations and acquisitions
+  uint64_t failed_rsteps = 0; // # consecutive read-only steps that failed
 
 public:
   /// A pair consisting of an ownable and its version.  We use this for
@@ -68,10 +70,32 @@ public:
   uint64_t get_last_wo_end_time() { return exo.get_last_wo_end_time(); }
 
   /// Start an operation (notify SMR)
-  void op_begin() { smr.enter(); }
-
-  /// End an operation (notify SMR)
-  void op_end() { smr.exit(_globals.smr); }
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
+
+  /// End an operation (notify SMR), and stop any visible reads it started
+  void op_end() {
+    exo.become_invisible();
+    failed_rsteps = 0;
+    smr.exit(_globals.smr);
+    EXO_TRACE(tracer_t::OP_END);
+  }
+
+  /// Report the time at which the current operation called op_begin()
+  uint64_t get_op_start_time() { return smr.get_enter_time(); }
+
+  /// Report if an object that was reachable during an operation that started
+  /// at `time` might have been reclaimed since then.  Data structures that keep
+  /// pointers across operations must check this before and after using them.
+  ///
+  /// @param time The start time of the operation where the object was found
+  ///
+  /// @return true if the object might have been reclaimed
+  bool reclaimed_since(uint64_t time) {
+    return timestamp_smr_t::reclaimed_since(_globals.smr, time);
+  }
 
   /// A good hash function.  Works nicely to "finalize" after std::hash().
   ///
@@ -83,6 +107,22 @@ public:
   /// Produce a random number from a thread-local generator
   int rand() { return rng.rand(); }
 
+  /// Report how many validations and acquisitions have failed.  Each failure
+  /// forces (part of) a step to be retried, so this is STMCAS's analog of an
+  /// abort count.
+  uint64_t get_aborts() { return conflicts; }
+
+protected:
+  /// Count a failed validation or acquisition
+  ///
+  /// @param ok The result of the validation or acquisition
+  ///
+  /// @return `ok`
+  bool tally(bool ok) {
+    conflicts += !ok;
+    return ok;
+  }
+
 private:
   // NB:  In order for ccds to be able to do has-a instead of is-a, we need a
   //      friend relationship
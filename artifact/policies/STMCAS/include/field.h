@@ -38,13 +38,15 @@ public:
   }
 
   /// Write the field from a WSTEP.  The caller must ensure the
-  /// corresponding orec is owned before calling this.
+  /// corresponding orec is owned before calling this, and that the step has
+  /// acquired every orec it needs, since writing begins the step's commit.
   ///
   /// NB: memory_order_relaxed, because we assume it is owned
   ///
-  /// @param val   The new value
-  /// @param WSTEP An unused parameter to restrict access to WSTEP contexts
-  void set(T val, typename STMCAS::WSTEP &) {
+  /// @param val The new value
+  /// @param tx  The writing step
+  void set(T val, typename STMCAS::WSTEP &tx) {
+    tx.commit_begin();
     _val.store(val, std::memory_order_relaxed);
   }
 };
@@ -1,14 +1,26 @@
 #pragma once
 
+#include "../../exoTM/exotm.h"
+#include "../../include/phases.h"
+#include "../../include/tracer.h"
+
 /// STEP is the base for the RSTEP and WSTEP RAII wrappers for the exoTM API
 template <class DESCRIPTOR> struct Step {
 protected:
-  DESCRIPTOR *op; // The thread descriptor for this operation
+  DESCRIPTOR *op;    // The thread descriptor for this operation
+  phase_span_t span; // The step's duration, for phase accounting
 
   /// Construct by recording the descriptor
   ///
   /// @param me The thread descriptor
-  Step(DESCRIPTOR *me) : op(me) {}
+  Step(DESCRIPTOR *me) : op(me), span(me->get_aborts()) {}
+
+  /// Count the outcome of a check or acquisition
+  ///
+  /// @param ok The result of the check or acquisition
+  ///
+  /// @return `ok`
+  bool tally(bool ok) { return this->op->tally(ok); }
 
 public:
   /// Check if an object's orec value is still `val`
@@ -18,7 +30,9 @@ public:
   ///
   /// @return True if it still matches, false otherwise
   bool check_continuation(typename DESCRIPTOR::ownable_t *obj, uint64_t val) {
-    return this->op->exo.check_continuation(obj->orec(), val);
+    this->op->exo.announce_read(obj->orec());
+    bool ok = this->op->exo.check_continuation(obj->orec(), val);
+    return this->tally(ok);
   }
 
   /// Validate that an object's orec is usable by the step
@@ -27,22 +41,51 @@ public:
   ///
   /// @return END_OF_TIME if obj's orec is not usable, else the orec version
   uint64_t check_orec(typename DESCRIPTOR::ownable_t *obj) {
-    return this->op->exo.check_orec(obj->orec());
+    uint64_t res = this->op->exo.check_orec(obj->orec());
+    this->tally(res != DESCRIPTOR::END_OF_TIME);
+    return res;
   }
 
   /// Return the start time of the step
   uint64_t get_start_time() { return this->op->exo.get_start_time(); }
 };
 
-/// RO is an RAII object for managing read-only steps
+/// RO is an RAII object for managing read-only steps.
+///
+/// A step fails if any of its checks fail, and the data structure then retries
+/// it.  After VISIBLE_READER_ATTEMPTS consecutive failed steps, the operation
+/// makes its reads visible.  Its announcements are kept across failed steps,
+/// so each retry gets at least as far as the last one before it can fail, and
+/// they are withdrawn by the first step that succeeds, by the next writing
+/// step, or by op_end().
 template <class DESCRIPTOR> struct RStep : Step<DESCRIPTOR> {
+private:
+  uint64_t conflicts; // The descriptor's conflict count when the step began
+
+public:
   /// Construct to start a read-only step
   ///
   /// @param me The thread descriptor
-  RStep(DESCRIPTOR *me) : Step<DESCRIPTOR>(me) { this->op->exo.ro_begin(); }
+  RStep(DESCRIPTOR *me) : Step<DESCRIPTOR>(me), conflicts(me->get_aborts()) {
+    if (VISIBLE_READER_ATTEMPTS > 0 &&
+        this->op->failed_rsteps >= VISIBLE_READER_ATTEMPTS)
+      this->op->exo.become_visible();
+    this->op->exo.ro_begin();
+  }
 
   /// Destruct the object to end the reading step
-  ~RStep() { this->op->exo.ro_end(); }
+  ~RStep() {
+    this->op->exo.ro_end();
+    if (VISIBLE_READER_ATTEMPTS > 0) {
+      if (this->op->get_aborts() == conflicts) {
+        this->op->exo.become_invisible();
+        this->op->failed_rsteps = 0;
+      } else {
+        ++this->op->failed_rsteps;
+      }
+    }
+    this->span.charge(phase_timer_t::TRAVERSE, this->op->get_aborts());
+  }
 };
 
 /// WO is an RAII object for managing writing steps
@@ -50,10 +93,16 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   /// Construct to start a writing step
   ///
   /// @param me The thread descriptor
-  WStep(DESCRIPTOR *me) : Step<DESCRIPTOR>(me) { this->op->exo.wo_begin(); }
+  WStep(DESCRIPTOR *me) : Step<DESCRIPTOR>(me) {
+    this->op->exo.become_invisible();
+    this->op->exo.wo_begin();
+  }
 
   /// Destruct the object to end the writing step
-  ~WStep() { this->op->exo.wo_end(); }
+  ~WStep() {
+    this->op->exo.wo_end();
+    this->span.charge(phase_timer_t::ACQUIRE, this->op->get_aborts());
+  }
 
   /// Acquire obj's orec, but only if its orec matches val
   ///
@@ -62,7 +111,8 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   ///
   /// @return True if the object's orec is successfully acquired
   bool acquire_continuation(typename DESCRIPTOR::ownable_t *obj, uint64_t val) {
-    return this->op->exo.acquire_continuation(obj->orec(), val);
+    bool ok = this->op->exo.acquire_continuation(obj->orec(), val);
+    return this->tally(ok);
   }
 
   /// Acquire obj's orec, but only if it is consistent with the start time of
@@ -72,7 +122,8 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   ///
   /// @return True if the orec was acquired, false otherwise
   bool acquire_consistent(typename DESCRIPTOR::ownable_t *obj) {
-    return this->op->exo.acquire_consistent(obj->orec());
+    bool ok = this->op->exo.acquire_consistent(obj->orec());
+    return this->tally(ok);
   }
 
   /// Acquire obj's orec, even if its orec would be inconsistent with the
@@ -82,11 +133,27 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   ///
   /// @return True if object's orec is successfully acquired
   bool acquire_aggressive(typename DESCRIPTOR::ownable_t *obj) {
-    return this->op->exo.acquire_aggressive(obj->orec());
+    bool ok = this->op->exo.acquire_aggressive(obj->orec());
+    // If the policy waits for committing owners, and this step holds no orecs
+    // (so two steps can't wait on each other), wait and try once more
+    using WAIT = typename DESCRIPTOR::LOCK_WAIT;
+    if (WAIT::ENABLED && !ok && !this->op->exo.has_orecs() &&
+        this->op->exo.template wait_for_release<WAIT>(obj->orec()))
+      ok = this->op->exo.acquire_aggressive(obj->orec());
+    return this->tally(ok);
   }
 
+  /// Announce that the step has acquired everything it needs, and is about to
+  /// write.  Until the step ends, other steps may wait for it to release its
+  /// orecs instead of failing.  set() calls this, so a step must acquire all
+  /// of its orecs before its first write.
+  void commit_begin() { this->op->exo.commit_begin(); }
+
   /// Unwind the step, so that it can be restarted
-  void unwind() { this->op->exo.unwind(); }
+  void unwind() {
+    EXO_TRACE(tracer_t::ABORT, tracer_t::UNWIND);
+    this->op->exo.unwind();
+  }
 
   /// Schedule an object for reclamation.  This should only be called from
   /// writing steps that won't unwind.
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../exoTM/exotm.h"
+#include "../include/hash.h"
+#include "../include/minivector.h"
+#include "../include/rdtsc_rand.h"
+#include "../include/shm_region.h"
+#include "../include/shm_smr.h"
+#include "include/field.h"
+#include "include/raii.h"
+
+/// shm_stmcas_t is a variant of stmcas_t for data structures that live in a
+/// shm_region_t, so that several processes can operate on them at once.  It
+/// differs from stmcas_t in three ways:
+/// - Orecs are always embedded in objects (as in orec_po_t), since a table of
+///   orecs would have to be shared, too.  ownable_t has no virtual methods,
+///   because vtable pointers are not valid in other processes.
+/// - Objects are allocated from the region, and SMR uses shm_smr_t, whose
+///   registry of timestamps is in the region.
+/// - Each descriptor's exoTM lock word comes from its shm_smr_t slot, since
+///   descriptor addresses are only unique within a process.
+///
+/// Data structures written for stmcas_t will need their links changed to
+/// shm_ptr_t before they can use this policy.
+///
+/// NB: The calling process must have a region mapped (see shm_region_t) before
+///     constructing a descriptor.
+struct shm_stmcas_t {
+  using STEP = Step<shm_stmcas_t>;   // RAII RSTEP/WSTEP base
+  using RSTEP = RStep<shm_stmcas_t>; // RAII RSTEP manager
+  using WSTEP = WStep<shm_stmcas_t>; // RAII WSTEP manager
+  using LOCK_WAIT = no_lock_wait_t;  // Id-based contexts never wait on locks
+
+  /// The maximum value an orec can ever have
+  static const auto END_OF_TIME = exotm_t::END_OF_TIME;
+
+  /// The base type for objects that are protected by STMCAS.  It embeds an
+  /// orec, and it is allocated from (and reclaimed to) the region.
+  ///
+  /// NB: Subclasses must be trivially destructible
+  class ownable_t {
+    exotm_t::orec_t _orec; // the orec for this object is embedded in it
+
+  public:
+    /// Return a reference to the ownable_t's orec
+    exotm_t::orec_t *orec() { return &_orec; }
+
+    /// Allocate an ownable_t from the region
+    static void *operator new(size_t size) { return shm_region_t::alloc(size); }
+
+    /// Return an ownable_t to the region immediately.  Shared objects should be
+    /// reclaimed via WSTEP::reclaim instead.
+    static void operator delete(void *ptr) { shm_region_t::free(ptr); }
+  };
+
+  /// The type for fields that are shared and protected by STMCAS
+  template <typename T>
+  struct sField : public stmcas_field_t<T, shm_stmcas_t> {
+    /// Construct an sField
+    ///
+    /// @param val The initial value
+    explicit sField(T val) : stmcas_field_t<T, shm_stmcas_t>(val) {}
+
+    /// Default-construct an sField
+    explicit sField() : stmcas_field_t<T, shm_stmcas_t>() {}
+  };
+
+private:
+  shm_smr_t smr;              // The safe memory reclamation context
+  exotm_t exo;                // The thread's exoTM context
+  rdtsc_rand_t rng;           // A random number generator
+  uint64_t conflicts = 0;     // Failed validations and acquisitions
+  uint64_t failed_rsteps = 0; // Unused, since exo is never visible
+
+public:
+  /// Construct a shm_stmcas_t, using its SMR slot to make a lock word that is
+  /// unique across processes
+  shm_stmcas_t() : smr(), exo(smr.id()) {}
+
+  /// Return the time when this thread's last write step committed
+  uint64_t get_last_wo_end_time() { return exo.get_last_wo_end_time(); }
+
+  /// Start an operation (notify SMR)
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
+
+  /// End an operation (notify SMR)
+  void op_end() {
+    smr.exit();
+    EXO_TRACE(tracer_t::OP_END);
+  }
+
+  /// A good hash function.  Works nicely to "finalize" after std::hash().
+  ///
+  /// @param val The value to hash
+  ///
+  /// @return A 64-bit hash value
+  uint64_t hash(size_t val) { return mix13_hash(val); }
+
+  /// Produce a random number from a thread-local generator
+  int rand() { return rng.rand(); }
+
+  /// Report how many validations and acquisitions have failed
+  uint64_t get_aborts() { return conflicts; }
+
+private:
+  /// Count a failed validation or acquisition
+  ///
+  /// @param ok The result of the validation or acquisition
+  ///
+  /// @return `ok`
+  bool tally(bool ok) {
+    conflicts += !ok;
+    return ok;
+  }
+
+  friend STEP;
+  friend WSTEP;
+  friend RSTEP;
+};
@@ -9,12 +9,17 @@
 /// the pieces together in a single object, with appropriate language-level
 /// protection.
 ///
-/// @tparam OP The orec policy to use.
-template <template <typename, typename> typename OP>
+/// @tparam OP   The orec policy to use.
+/// @tparam WAIT The lock-wait strategy: whether a step that holds no orecs, and
+///              fails to acquire an orec because another step is committing,
+///              should wait for it and try again, instead of failing at once.
+template <template <typename, typename> typename OP,
+          class WAIT = no_lock_wait_t>
 struct stmcas_t : public base_t<OP> {
   using STEP = Step<stmcas_t>;   // RAII RSTEP/WSTEP base
   using RSTEP = RStep<stmcas_t>; // RAII RSTEP manager
   using WSTEP = WStep<stmcas_t>; // RAII WSTEP manager
+  using LOCK_WAIT = WAIT;        // The lock-wait strategy
 
   /// Construct an stmcas_t
   stmcas_t() : base_t<OP>() {}
@@ -36,3 +41,8 @@ private:
   friend RSTEP;
   friend class ccds_t;
 };
+
+/// stmcas_t, but waiting for lock holders that are committing, instead of
+/// failing at once
+template <template <typename, typename> typename OP>
+using stmcas_wait_t = stmcas_t<OP, commit_lock_wait_t<>>;
@@ -49,10 +49,16 @@ public:
   /// Construct a thread_t
   thread_t(int _tid = 0) : smr(_globals.smr), tid(_tid) {}
   /// Start an operation (notify SMR)
-  void op_begin() { smr.enter(); }
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
 
   /// End an operation (notify SMR)
-  void op_end() { smr.exit(_globals.smr); }
+  void op_end() {
+    smr.exit(_globals.smr);
+    EXO_TRACE(tracer_t::OP_END);
+  }
 
   /// A good hash function.  You should use std::hash to produce a hashed val,
   /// and then this will run a good hash on the result.
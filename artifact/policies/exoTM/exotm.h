@@ -2,13 +2,103 @@
 
 #include <atomic>
 #include <climits>
+#include <mutex>
+#include <sched.h>
 #include <x86intrin.h>
 
+#include "../include/hash.h"
 #include "../include/minivector.h"
+#include "../include/tracer.h"
 
 #define likely(x) __builtin_expect(!!(x), 1)
 #define unlikely(x) __builtin_expect(!!(x), 0)
 
+/// A lock-wait strategy for policies built on exoTM, which never waits: a
+/// thread that finds an orec locked gives up on it right away.  This is the
+/// default strategy of every policy.
+struct no_lock_wait_t {
+  static constexpr bool ENABLED = false; // Does this strategy ever wait?
+  static constexpr int SPINS = 0;        // The most re-checks of an orec
+  static constexpr int YIELD = 1;        // Yield once every YIELD re-checks
+};
+
+/// A lock-wait strategy for policies built on exoTM, which waits for a bounded
+/// time for the owner of a locked orec to release it, but only while the owner
+/// is writing back and releasing its orecs (see exotm_t::commit_begin).
+///
+/// @tparam SPINS_ The most times to re-check the orec
+/// @tparam YIELD_ Yield the CPU once every YIELD_ re-checks, and pause the rest
+///                of the time.  Yielding matters when there are more threads
+///                than cores, since then the owner may not be running.
+template <int SPINS_ = 128, int YIELD_ = 8> struct commit_lock_wait_t {
+  static constexpr bool ENABLED = true;  // Does this strategy ever wait?
+  static constexpr int SPINS = SPINS_;   // The most re-checks of an orec
+  static constexpr int YIELD = YIELD_;   // Yield once every YIELD re-checks
+};
+
+/// The number of consecutive failed attempts after which a read-only operation
+/// makes its reads visible (see exotm_t::become_visible).  The default, 0,
+/// means that readers are always invisible.  Override it at compile time (e.g.,
+/// -DVISIBLE_READER_ATTEMPTS=8) to let long reads finish under steady writes.
+#ifndef VISIBLE_READER_ATTEMPTS
+#define VISIBLE_READER_ATTEMPTS 0
+#endif
+
+/// The number of reader indicators that visible readers share.  Orecs hash to
+/// indicators, so a collision only makes a writer back off needlessly.
+#ifndef READER_TABLE_SIZE
+#define READER_TABLE_SIZE 65536
+#endif
+
+/// The state that visible readers share: a table of reader indicators, and the
+/// number of contexts that are currently visible.  Writers only look at the
+/// indicators when the count is nonzero, so invisible runs just pay for one
+/// read of a line that rarely changes.
+///
+/// @tparam SIZE The number of reader indicators
+template <size_t SIZE> class reader_table_t {
+public:
+  /// A reader indicator: the number of visible reads of the orecs that map to it
+  using indicator_t = std::atomic<uint32_t>;
+
+private:
+  static inline std::atomic<uint64_t> visible_count = 0; // # visible contexts
+  static inline indicator_t indicators[SIZE];            // The indicators
+
+public:
+  /// Count a context that has become visible
+  static void add_visible() { visible_count.fetch_add(1); }
+
+  /// Stop counting a context that has become invisible
+  static void remove_visible() {
+    visible_count.fetch_sub(1, std::memory_order_release);
+  }
+
+  /// Report if any context is currently visible
+  static bool any_visible() { return visible_count.load() != 0; }
+
+  /// Map an orec to its reader indicator
+  ///
+  /// @param orec The orec whose indicator is sought
+  ///
+  /// @return The orec's reader indicator
+  static indicator_t *indicator(const void *orec) {
+    return &indicators[mix13_hash((uintptr_t)orec) % SIZE];
+  }
+};
+
+/// Without visible readers, there is no table and no count, so builds that
+/// never become visible do not pay for them.  No context is ever visible, so
+/// exotm_t never asks this stand-in for an indicator.
+template <> class reader_table_t<0> {
+public:
+  using indicator_t = std::atomic<uint32_t>;
+  static void add_visible() {}
+  static void remove_visible() {}
+  static bool any_visible() { return false; }
+  static indicator_t *indicator(const void *) { return nullptr; }
+};
+
 /// exotm_t encapsulates all of the state and functionality needed by a thread
 /// that uses the exoTM transactional mechanisms. This includes per-thread state
 /// and the global clock.
@@ -31,10 +121,70 @@
 /// possible for programmers to associate multiple orecs with different parts of
 /// an object.
 ///
+/// A lock word identifies the context that holds the orec.  When a policy
+/// calls commit_begin(), it promises that its orecs will be released soon, and
+/// other threads that find one of those orecs locked can wait_for_release()
+/// instead of aborting.
+///
+/// Readers are usually invisible, so a long read can be aborted by any writer
+/// that commits to an orec it read, over and over.  After a policy calls
+/// become_visible(), every orec that the thread checks is also counted in a
+/// reader indicator, until become_invisible().  A writer that acquires an orec
+/// whose indicator is nonzero puts the orec back, waits briefly, and fails, so
+/// the orecs that a visible reader has checked stay valid.  Writers back off
+/// instead of waiting while holding orecs, and readers never hold orecs, so no
+/// thread waits on a thread that waits on it.
+///
 /// TODO: Should we create an exoTM variant that uses a GV1 clock?
 class exotm_t {
   static const uint64_t LOCK_BIT = 1ULL << 63; // MSB is the lock bit for orecs
 
+  /// The part of a context that other threads inspect when they find one of
+  /// its orecs locked.  A context's lock word is the address of its status_t.
+  ///
+  /// NB: status_t objects are recycled, but never freed, so it is always safe
+  ///     to follow a lock word, even if its context has since been destroyed.
+  struct alignas(64) status_t {
+    std::atomic<bool> committing = false; // Will the owner release soon?
+    status_t *next = nullptr;             // The next status_t in the pool
+  };
+
+  static inline std::mutex pool_lock;     // Protects `pool`
+  static inline status_t *pool = nullptr; // Unused status_t objects
+
+  /// The most times that a writer re-checks a reader indicator after backing
+  /// off, and how often it yields the CPU while doing so
+  static constexpr int BACK_OFF_SPINS = 128, BACK_OFF_YIELD = 8;
+
+  /// Are visible readers compiled in?
+  static constexpr bool VISIBLE_READERS = VISIBLE_READER_ATTEMPTS > 0;
+
+  /// The reader indicators and the count of visible contexts, or an empty
+  /// stand-in when visible readers are not compiled in
+  using readers = reader_table_t<VISIBLE_READERS ? READER_TABLE_SIZE : 0>;
+
+  /// A reader indicator: the number of visible reads of the orecs that map to it
+  using indicator_t = readers::indicator_t;
+
+  /// Get a status_t for a new context, reusing one if possible
+  static status_t *status_alloc() {
+    std::lock_guard<std::mutex> guard(pool_lock);
+    if (pool == nullptr)
+      return new status_t();
+    status_t *res = pool;
+    pool = res->next;
+    return res;
+  }
+
+  /// Return a context's status_t to the pool
+  ///
+  /// @param s The status_t to recycle
+  static void status_free(status_t *s) {
+    std::lock_guard<std::mutex> guard(pool_lock);
+    s->next = pool;
+    pool = s;
+  }
+
 public:
   /// A special value that is larger than any value that rdtsc will return, and
   /// that won't be mistaken for a pointer.
@@ -61,15 +211,41 @@ public:
 private:
   std::atomic<uint64_t> start_time; // This operation's start time, or EOT
   minivector<orec_t *> locks;       // All orecs held by the current transaction
+  status_t *const status;           // Shared status, or null if ids are used
   const uint64_t my_lock;           // This thread's unique lock word
   uint64_t last_wo_end_time = 0;    // Time of last wo_end
   bool unwound = false;             // Are we between unwind() and wo_end()?
+  bool visible = false;             // Are this context's reads visible?
+
+  /// The reader indicators that this context has incremented while visible
+  minivector<indicator_t *> announced;
 
 public:
   /// Construct a thread's exoTM context
   exotm_t()
-      : start_time(END_OF_TIME),
-        my_lock(LOCK_BIT | reinterpret_cast<uintptr_t>(this)) {}
+      : start_time(END_OF_TIME), status(status_alloc()),
+        my_lock(LOCK_BIT | reinterpret_cast<uintptr_t>(status)) {}
+
+  /// Construct a thread's exoTM context with an explicit lock word id.  The
+  /// default lock word is an address, which is only unique within a process.
+  /// When orecs are shared by several processes, the policy must supply an id
+  /// that is unique among all contexts that use those orecs.
+  ///
+  /// NB: Lock words that are ids do not identify a status_t, so contexts built
+  ///     this way never wait_for_release().
+  ///
+  /// @param id A nonzero id that no other live context is using
+  explicit exotm_t(uint64_t id)
+      : start_time(END_OF_TIME), status(nullptr), my_lock(LOCK_BIT | id) {}
+
+  /// exoTM contexts cannot be copied, since each needs its own lock word
+  exotm_t(const exotm_t &) = delete;
+
+  /// Destruct a thread's exoTM context, recycling its status_t
+  ~exotm_t() {
+    if (status)
+      status_free(status);
+  }
 
   /// Start using exoTM to read orecs
   void ro_begin() {
@@ -79,6 +255,7 @@ public:
     // TODO:  Investigate coupling this clock with the SMR's clock
     uint64_t time = get_time_relaxed();
     start_time.exchange(time);
+    EXO_TRACE(tracer_t::RO_BEGIN);
   }
 
   /// Stop using exoTM to read orecs
@@ -95,6 +272,7 @@ public:
   ///         then END_OF_TIME.  Otherwise, the observed value of the orec will
   ///         be returned.
   uint64_t check_orec(const orec_t *orec) {
+    announce_read(orec);
     // NB: this is a seqlock read acquire... can't be relaxed
     auto res = orec->curr.load(std::memory_order_acquire);
     return (res <= start_time || res == my_lock) ? res : END_OF_TIME;
@@ -120,6 +298,7 @@ public:
   ///         then END_OF_TIME.  Otherwise, the observed value of the orec will
   ///         be returned.
   uint64_t check_orec(const orec_t *orec, bool &locked) {
+    announce_read(orec);
     // NB: this is a seqlock read acquire... can't be relaxed
     auto res = orec->curr.load(std::memory_order_acquire);
     locked = res & LOCK_BIT;
@@ -146,6 +325,7 @@ public:
     // Read the hardware clock, just like in ro_begin()
     uint64_t time = get_time_relaxed();
     start_time.exchange(time);
+    EXO_TRACE(tracer_t::WO_BEGIN);
     // Mark that we're not unwinding
     //
     // NB: we set it here so hopefully the compiler can propagate it
@@ -163,9 +343,11 @@ public:
     if (val == my_lock)
       return true;
     if (unlikely(val > start_time)) // NB: subsumes the LOCK_BIT check
-      return false;
+      return acquire_failed();
     if (unlikely(!orec->curr.compare_exchange_strong(val, my_lock)))
-      return false;
+      return acquire_failed();
+    if (unlikely(has_readers(orec)))
+      return back_off(orec, val);
     orec->prev = val;
     locks.push_back(orec);
     return true;
@@ -175,7 +357,8 @@ public:
   /// acquired before this call was made.
   ///
   /// @param orec   The orec to acquire
-  /// @param locked A ref param to indicate if the location is locked
+  /// @param locked A ref param to indicate if the location is locked, or is in
+  ///               use by a visible reader
   ///
   /// @return true if the orec was acquired, false otherwise
   bool acquire_consistent(orec_t *orec, bool &locked) {
@@ -187,10 +370,14 @@ public:
     }
     if (unlikely(val > start_time)) {
       locked = val & LOCK_BIT;
-      return false;
+      return acquire_failed();
     }
     if (unlikely(!orec->curr.compare_exchange_strong(val, my_lock)))
-      return false;
+      return acquire_failed();
+    if (unlikely(has_readers(orec))) {
+      locked = true;
+      return back_off(orec, val);
+    }
     orec->prev = val;
     locks.push_back(orec);
     return true;
@@ -206,17 +393,109 @@ public:
     // Relaxed load is OK: we're going to CAS it
     auto orec_val = orec->curr.load(std::memory_order_relaxed);
     if (unlikely(orec_val > val))
-      return orec_val == my_lock;
+      return orec_val == my_lock || acquire_failed();
     if (unlikely(!orec->curr.compare_exchange_strong(orec_val, my_lock)))
-      return false;
+      return acquire_failed();
+    if (unlikely(has_readers(orec)))
+      return back_off(orec, orec_val);
     orec->prev = orec_val;
     locks.push_back(orec);
     return true;
   }
 
+  /// Announce that the current operation has acquired and validated everything
+  /// it needs, and is about to write and then release its orecs, without
+  /// waiting on any other thread.  This lasts until the next wo_end() or
+  /// unwind().
+  void commit_begin() {
+    if (status)
+      status->committing.store(true, std::memory_order_relaxed);
+  }
+
+  /// Wait, for a bounded time, for another thread to release an orec, but only
+  /// if the policy's strategy waits, and only while that thread has announced
+  /// (via commit_begin()) that it is about to release it.
+  ///
+  /// An unlocked orec that visible readers are using is not released, since a
+  /// writer that tried again would only back off again.
+  ///
+  /// @tparam WAIT The policy's lock-wait strategy (e.g., no_lock_wait_t)
+  ///
+  /// @param orec The orec to wait on
+  ///
+  /// @return true if the orec is unlocked, or changed while waiting, in which
+  ///         case the caller can try again instead of aborting; false otherwise
+  template <class WAIT> bool wait_for_release(const orec_t *orec) {
+    auto val = orec->curr.load(std::memory_order_acquire);
+    if (!(val & LOCK_BIT))
+      return visible || !has_readers(orec);
+    if (!WAIT::ENABLED || !status || val == my_lock)
+      return false;
+    auto owner = reinterpret_cast<status_t *>(val & ~LOCK_BIT);
+    for (int i = 0; i < WAIT::SPINS; ++i) {
+      if (!owner->committing.load(std::memory_order_relaxed))
+        return false;
+      // Yield now and then, in case the owner isn't running
+      if (i % WAIT::YIELD == WAIT::YIELD - 1)
+        sched_yield();
+      else
+        _mm_pause();
+      if (orec->curr.load(std::memory_order_acquire) != val)
+        return true;
+    }
+    return false;
+  }
+
   /// Report if the current operation has acquired any orecs
   bool has_orecs() { return !locks.empty(); }
 
+  /// Make this context's reads visible: from now until become_invisible(),
+  /// each orec that it checks stays valid, because writers back off from it.
+  /// The announcements outlive ro_end() and unwind(), so that a policy can
+  /// retry a failed read without losing them.
+  ///
+  /// NB: Reader indicators are not shared among processes, so contexts with
+  ///     explicit ids (see exotm_t(uint64_t)) stay invisible.
+  void become_visible() {
+    if (!VISIBLE_READERS || visible || !status)
+      return;
+    visible = true;
+    readers::add_visible();
+    EXO_TRACE(tracer_t::VISIBLE);
+  }
+
+  /// Withdraw all of this context's read announcements, and make its reads
+  /// invisible again.  The context must not hold any orecs while it is
+  /// visible, or it could back off from its own announcements.
+  void become_invisible() {
+    if (!VISIBLE_READERS || likely(!visible))
+      return;
+    for (auto i : announced)
+      i->fetch_sub(1, std::memory_order_release);
+    announced.clear();
+    readers::remove_visible();
+    visible = false;
+  }
+
+  /// If this context is visible, announce that it reads `orec`.  check_orec()
+  /// does this on its own.  Policies should call it before any other kind of
+  /// check of an orec that they have not yet checked.
+  ///
+  /// @param orec The orec that is about to be read
+  void announce_read(const orec_t *orec) {
+    if (!VISIBLE_READERS || likely(!visible))
+      return;
+    // Repeated reads of the same object only need one announcement
+    auto i = readers::indicator(orec);
+    if (!announced.empty() && *(announced.end() - 1) == i)
+      return;
+    // NB: This RMW orders the increment before the caller reads the orec.  It
+    //     pairs with the CAS in the acquire methods, which is ordered before
+    //     their has_readers() check.
+    i->fetch_add(1);
+    announced.push_back(i);
+  }
+
   /// Try to acquire an orec, without comparing its value to `this.start_time`.
   /// Return false on failure.
   ///
@@ -227,13 +506,15 @@ public:
     // Relaxed load is OK: we're going to CAS it
     auto val = orec->curr.load(std::memory_order_relaxed);
     if (unlikely(val & LOCK_BIT)) // if it's locked, it had better be mine!
-      return (val == my_lock);
+      return val == my_lock || acquire_failed();
     if (likely(orec->curr.compare_exchange_strong(val, my_lock))) {
+      if (unlikely(has_readers(orec)))
+        return back_off(orec, val);
       orec->prev = val;
       locks.push_back(orec);
       return true;
     }
-    return false;
+    return acquire_failed();
   }
 
   /// Stop using exoTM to write orecs, by advancing orec values to a new time
@@ -256,7 +537,9 @@ public:
     //     lock release
     for (auto o : locks)
       o->curr.store(last_wo_end_time, std::memory_order_relaxed);
+    EXO_TRACE(tracer_t::COMMIT, locks.size());
     locks.clear();
+    end_commit();
   }
 
   /// Undo writes to orecs.  Calling this will effectively transform wo_end into
@@ -279,6 +562,7 @@ public:
         o->curr.store(o->prev + 1, std::memory_order_relaxed);
     }
     locks.clear();
+    end_commit();
   }
 
   /// Report the value returned by ro_begin() or wo_begin()
@@ -288,6 +572,51 @@ public:
   uint64_t get_last_wo_end_time() { return last_wo_end_time; }
 
 private:
+  /// Report if any visible reader has announced a read of an orec
+  ///
+  /// @param orec The orec that the caller just locked
+  ///
+  /// @return true if the caller must not keep `orec`
+  bool has_readers(const orec_t *orec) {
+    return VISIBLE_READERS && unlikely(readers::any_visible()) &&
+           readers::indicator(orec)->load() != 0;
+  }
+
+  /// Release an orec that was just locked, because a visible reader is using
+  /// it, and then wait (for a bounded time) for its readers to finish
+  ///
+  /// NB: Nothing was written under the lock, so the old value can be restored.
+  ///
+  /// @param orec The orec to release
+  /// @param val  The value of the orec before it was locked
+  ///
+  /// @return false
+  bool back_off(orec_t *orec, uint64_t val) {
+    orec->curr.store(val, std::memory_order_release);
+    auto i = readers::indicator(orec);
+    for (int n = 0; n < BACK_OFF_SPINS && i->load() != 0; ++n) {
+      if (n % BACK_OFF_YIELD == BACK_OFF_YIELD - 1)
+        sched_yield();
+      else
+        _mm_pause();
+    }
+    return acquire_failed();
+  }
+
+  /// Record a failed orec acquisition
+  ///
+  /// @return false
+  bool acquire_failed() {
+    EXO_TRACE(tracer_t::ACQUIRE_FAIL);
+    return false;
+  }
+
+  /// Withdraw a commit_begin() announcement, once all orecs are released
+  void end_commit() {
+    if (status)
+      status->committing.store(false, std::memory_order_relaxed);
+  }
+
   /// Use rdtscp to get the hardware clock cycle count with strong read ordering
   ///
   /// This is currently unused, because rdtsc suffices.
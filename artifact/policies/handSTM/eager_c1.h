@@ -11,8 +11,11 @@
 /// - No quiescence, but safe memory reclamation
 /// - Can be configured with per-object or per-stripe orecs
 ///
-/// @tparam OP The orec policy to use.
-template <template <typename, typename> typename OP>
+/// @tparam OP   The orec policy to use.
+/// @tparam WAIT The lock-wait strategy to use (see exotm.h).  By default, a
+///              transaction that finds an orec locked does not wait.
+template <template <typename, typename> typename OP,
+          class WAIT = no_lock_wait_t>
 struct eager_c1_t : public undo_base_t<OP, true> {
   using STM = Stm<eager_c1_t>;     // RAII ROSTM/WOSTM base
   using ROSTM = RoStm<eager_c1_t>; // RAII ROSTM manager
@@ -26,6 +29,7 @@ private:
   using OWNABLE = typename undo_base_t<OP, true>::ownable_t;
   using UNDO_T = undolog_t::undo_t;
   static const auto EOT = exotm_t::END_OF_TIME;
+  using LOCK_WAIT = WAIT;
 
 public:
   /// The type for fields that are shared and protected by HandSTM
@@ -49,3 +53,8 @@ private:
   template <typename T, typename DESCRIPTOR> friend class eager_field_t;
   template <typename T, typename DESCRIPTOR> friend class eager_c1_field;
 };
+
+/// eager_c1_t, but waiting for lock holders that are committing, instead of
+/// aborting at once
+template <template <typename, typename> typename OP>
+using eager_c1_wait_t = eager_c1_t<OP, commit_lock_wait_t<>>;
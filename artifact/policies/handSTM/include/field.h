@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "../../include/tracer.h"
+
 /// field_base_t has the code that is shared among all of our HandSTM policies'
 /// field implementations
 ///
@@ -23,6 +25,19 @@ protected:
   /// be friends of the RAII objects
   DESCRIPTOR &OP(typename DESCRIPTOR::STM &tx) { return *tx.op; }
 
+  /// Wait for the owner of o's orec to release it, as the policy's lock-wait
+  /// strategy allows
+  ///
+  /// @param tx The transaction that found the orec locked
+  /// @param o  The ownable for this location (locates the orec)
+  ///
+  /// @return true if the caller can try again instead of aborting
+  bool wait_for_release(typename DESCRIPTOR::STM &tx,
+                        typename DESCRIPTOR::OWNABLE *o) {
+    using WAIT = typename DESCRIPTOR::LOCK_WAIT;
+    return OP(tx).exo.template wait_for_release<WAIT>(o->orec());
+  }
+
 public:
   /// Write to shared memory (captured / not-actually-shared memory)
   ///
@@ -96,9 +111,9 @@ public:
         return;
       }
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -161,9 +176,9 @@ public:
         return from_mem;
       }
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -183,7 +198,7 @@ public:
     T from_mem = op(tx).undolog.safe_read(&this->_val);
     // If validation fails, abort, else return the value without logging
     if (op(tx).exo.check_orec(o->orec()) == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     return from_mem;
   }
 };
@@ -232,9 +247,9 @@ public:
         return from_mem;
       }
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -262,7 +277,7 @@ public:
     // If validation fails, then even on a transient pre/post issue, orec
     // bumps are going to cause us to abort in validation, so just abort now
     if (pre != post || pre == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     // Validation succeeded, so return the value without logging
     return from_mem;
   }
@@ -313,7 +328,8 @@ public:
         return ret;
       }
 
-      // wait if locked
+      // wait if locked.  The owner is always committing, since it only locks
+      // orecs at commit time, so it will release them soon.
       while (locked)
         op(tx).exo.check_orec(o->orec(), locked);
 
@@ -339,7 +355,7 @@ public:
     // read the location, then orec.  If validation fails, we must abort.
     ret = op(tx).redolog.safe_read(&this->_val);
     if (op(tx).exo.check_orec(o->orec()) == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     return ret;
   }
 
@@ -458,9 +474,9 @@ public:
       if (op(tx).exo.acquire_consistent(o->orec(), locked))
         return;
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -528,9 +544,9 @@ public:
         return ret;
       }
 
-      // abort if locked
-      while (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -554,7 +570,7 @@ public:
     // read the location, then orec.  If validation fails, we must abort.
     ret = op(tx).redolog.safe_read(&this->_val);
     if (op(tx).exo.check_orec(o->orec()) == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     return ret;
   }
 };
@@ -608,9 +624,9 @@ public:
         return ret;
       }
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -644,7 +660,7 @@ public:
     // whoever owns it will abort and reset the orec to the value we logged in
     // a prior get().
     if (pre != post || pre == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     // Validation succeeded, so return the value without logging
     return ret;
   }
@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <setjmp.h>
 
+#include "../../exoTM/exotm.h"
+#include "../../include/phases.h"
+
 /// STM is the base for the ROSTM and WOSTM RAII objects, which delineate
 /// HandSTM transactions
 template <class DESCRIPTOR> struct Stm {
@@ -16,23 +19,38 @@ protected:
   ///
   /// @param me The thread descriptor
   /// @param jb The register checkpoint (jump buffer)
-  Stm(DESCRIPTOR *me, jmp_buf *jb) : op(me) { me->checkpoint = jb; }
+  Stm(DESCRIPTOR *me, jmp_buf *jb) : op(me) {
+    me->checkpoint = jb;
+    me->tx_span.restart();
+  }
 };
 
-/// ROSTM is an RAII object for read-only transactions
+/// ROSTM is an RAII object for read-only transactions.
+///
+/// An abort longjmps back to BEGIN_RO, which constructs the ROSTM again, so the
+/// constructor runs once per attempt.  After VISIBLE_READER_ATTEMPTS failed
+/// attempts, the transaction makes its reads visible, so that writers can't
+/// invalidate what it has read.  It stays visible across later aborts, and
+/// becomes invisible when it commits.
 template <class DESCRIPTOR> struct RoStm : Stm<DESCRIPTOR> {
   /// Construct to start a transaction
   ///
   /// @param me The thread descriptor
   /// @param jb The register checkpoint (jump buffer)
   RoStm(DESCRIPTOR *me, jmp_buf *jb) : Stm<DESCRIPTOR>(me, jb) {
+    if (VISIBLE_READER_ATTEMPTS > 0 &&
+        ++this->op->ro_attempts > VISIBLE_READER_ATTEMPTS)
+      this->op->exo.become_visible();
     this->op->exo.ro_begin();
   }
 
   /// Destruct the object to commit the transaction
   ~RoStm() {
     this->op->exo.ro_end();
+    this->op->exo.become_invisible();
+    this->op->ro_attempts = 0;
     this->op->readset.clear();
+    this->op->tx_span.charge(phase_timer_t::TRAVERSE);
   }
 };
 
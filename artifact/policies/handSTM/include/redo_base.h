@@ -48,6 +48,9 @@ template <template <typename, typename> typename OP> struct redo_base_t {
   REDOLOG redolog;                 // A redo log, for replaying writes on commit
   minivector<ownable_t *> mallocs; // pending allocations
   minivector<ownable_t *> frees;   // pending reclaims
+  uint64_t aborts = 0;             // # transactions this thread has aborted
+  uint64_t ro_attempts = 0;        // # attempts at the current RO transaction
+  phase_span_t tx_span;            // The current attempt, for phase accounting
 
   /// Construct a redo_base_t
   redo_base_t() : exo(), smr(_globals.smr) {}
@@ -56,7 +59,7 @@ template <template <typename, typename> typename OP> struct redo_base_t {
   void acquire_all() {
     for (auto o : lockset)
       if (!exo.acquire_consistent(o))
-        abort();
+        abort(tracer_t::ACQUIRE);
   }
 
   /// Ensure that all orecs that we've read have timestamps older than the start
@@ -66,7 +69,7 @@ template <template <typename, typename> typename OP> struct redo_base_t {
     // NB: on relaxed architectures, we may have unnecessary fences here
     for (auto o : readset)
       if (exo.check_orec(o) == exotm_t::END_OF_TIME)
-        abort();
+        abort(tracer_t::VALIDATION);
   }
 
   /// Specialized version of validation for timestamp extension.  Compare
@@ -76,12 +79,17 @@ template <template <typename, typename> typename OP> struct redo_base_t {
       bool mine = false;
       bool ok = exo.check_continuation(o, old_start, mine);
       if (!ok && !mine)
-        abort();
+        abort(tracer_t::VALIDATION);
     }
   }
 
   /// Unwind the transaction
-  void abort() {
+  ///
+  /// @param why The reason for the abort, for tracing
+  void abort(tracer_t::reason_t why = tracer_t::CONFLICT) {
+    EXO_TRACE(tracer_t::ABORT, why);
+    ++aborts;
+    tx_span.charge(phase_timer_t::RETRY);
     exo.unwind(exotm_t::ROLLBACK_ORECS); // roll back locks to release them
 
     // reset all lists.  Note that we can free right away, without SMR.
@@ -96,10 +104,16 @@ template <template <typename, typename> typename OP> struct redo_base_t {
   }
 
   /// Start an operation (notify SMR)
-  void op_begin() { smr.enter(); }
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
 
   /// End an operation (notify SMR)
-  void op_end() { smr.exit(_globals.smr); }
+  void op_end() {
+    smr.exit(_globals.smr);
+    EXO_TRACE(tracer_t::OP_END);
+  }
 
   /// A good hash function.  Works nicely to "finalize" after std::hash().
   ///
@@ -111,22 +125,32 @@ template <template <typename, typename> typename OP> struct redo_base_t {
   /// Produce a random number from a thread-local generator
   int rand() { return rng.rand(); }
 
+  /// Report how many transactions this thread has aborted
+  uint64_t get_aborts() { return aborts; }
+
   /// Commit a writing transaction
   void commit() {
+    tx_span.charge(phase_timer_t::TRAVERSE);
+
     // read-only fast-path
     if (lockset.empty() && !exo.has_orecs()) {
       exo.ro_end();
       readset.clear();
+      tx_span.charge(phase_timer_t::VALIDATE);
       return;
     }
 
     // Acquire locks, if there are any that aren't acquired yet, then validate
     acquire_all();
+    tx_span.charge(phase_timer_t::ACQUIRE);
     validate();
+    tx_span.charge(phase_timer_t::VALIDATE);
 
     // We're committed, so write-back, release locks, and clean up
+    exo.commit_begin();
     redolog.writeback();
     exo.wo_end();
+    tx_span.charge(phase_timer_t::WRITEBACK);
     mallocs.clear();
     for (auto a : frees)
       smr.reclaim(a); // Need SMR here!
@@ -52,6 +52,9 @@ protected:
   undolog_t undolog;               // An undo log, for undoing writes on abort
   minivector<ownable_t *> mallocs; // pending allocations
   minivector<ownable_t *> frees;   // pending reclaims
+  uint64_t aborts = 0;             // # transactions this thread has aborted
+  uint64_t ro_attempts = 0;        // # attempts at the current RO transaction
+  phase_span_t tx_span;            // The current attempt, for phase accounting
 
   /// Construct an undo_base_t
   undo_base_t() : exo(), smr(_globals.smr) {}
@@ -63,7 +66,7 @@ protected:
     // NB: on relaxed architectures, we may have unnecessary fences here
     for (auto o : readset)
       if (exo.check_orec(o) == exotm_t::END_OF_TIME)
-        abort();
+        abort(tracer_t::VALIDATION);
   }
 
   /// Specialized version of validation for timestamp extension.  Compare
@@ -74,12 +77,17 @@ protected:
       bool mine = false;
       bool ok = exo.check_continuation(o, old_start, mine);
       if (!ok && !mine)
-        abort();
+        abort(tracer_t::VALIDATION);
     }
   }
 
   /// Unwind the transaction
-  void abort() {
+  ///
+  /// @param why The reason for the abort, for tracing
+  void abort(tracer_t::reason_t why = tracer_t::CONFLICT) {
+    EXO_TRACE(tracer_t::ABORT, why);
+    ++aborts;
+    tx_span.charge(phase_timer_t::RETRY);
     undolog.undo_writes();
     if (ABORT_AS_SILENT_STORE)
       exo.wo_end(); // commit as silent store to release locks
@@ -98,10 +106,16 @@ protected:
 
 public:
   /// Start an operation (notify SMR)
-  void op_begin() { smr.enter(); }
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
 
   /// End an operation (notify SMR)
-  void op_end() { smr.exit(_globals.smr); }
+  void op_end() {
+    smr.exit(_globals.smr);
+    EXO_TRACE(tracer_t::OP_END);
+  }
 
   /// A good hash function.  Works nicely to "finalize" after std::hash().
   ///
@@ -113,21 +127,30 @@ public:
   /// Produce a random number from a thread-local generator
   int rand() { return rng.rand(); }
 
+  /// Report how many transactions this thread has aborted
+  uint64_t get_aborts() { return aborts; }
+
 protected:
   /// Commit a writing transaction
   void commit() {
+    tx_span.charge(phase_timer_t::TRAVERSE);
+
     // read-only fast-path
     if (!exo.has_orecs()) {
       exo.ro_end();
       readset.clear();
+      tx_span.charge(phase_timer_t::VALIDATE);
       return;
     }
 
     // Locks are already acquired, so just validate
     validate();
+    tx_span.charge(phase_timer_t::VALIDATE);
 
     // We're committed, so release locks and clean up
+    exo.commit_begin();
     exo.wo_end();
+    tx_span.charge(phase_timer_t::WRITEBACK);
     mallocs.clear();
     for (auto a : frees)
       smr.reclaim(a); // Need SMR here!
@@ -14,8 +14,11 @@
 /// Note that check-once orecs don't really let us use orec checks to filter out
 /// and avoid redolog lookups.
 ///
-/// @tparam OP The orec policy to use.
-template <template <typename, typename> typename OP>
+/// @tparam OP   The orec policy to use.
+/// @tparam WAIT The lock-wait strategy to use (see exotm.h).  By default, a
+///              transaction that finds an orec locked does not wait.
+template <template <typename, typename> typename OP,
+          class WAIT = no_lock_wait_t>
 struct wb_c1_t : public redo_base_t<OP> {
   using STM = Stm<wb_c1_t>;     // RAII ROSTM/WOSTM base
   using ROSTM = RoStm<wb_c1_t>; // RAII ROSTM manager
@@ -28,6 +31,7 @@ private:
   // Types needed by the (friend) field template, but not worth making public
   using OWNABLE = typename redo_base_t<OP>::ownable_t;
   static const auto EOT = exotm_t::END_OF_TIME;
+  using LOCK_WAIT = WAIT;
 
 public:
   /// The type for fields that are shared and protected by HandSTM
@@ -51,3 +55,8 @@ private:
   template <typename T, typename DESCRIPTOR> friend class wb_field_t;
   template <typename T, typename DESCRIPTOR> friend class wb_c1_field;
 };
+
+/// wb_c1_t, but waiting for lock holders that are committing, instead of
+/// aborting at once
+template <template <typename, typename> typename OP>
+using wb_c1_wait_t = wb_c1_t<OP, commit_lock_wait_t<>>;
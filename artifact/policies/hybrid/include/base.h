@@ -53,6 +53,7 @@ protected:
   REDOLOG redolog;                 // A redo log, for replaying writes on commit
   minivector<ownable_t *> mallocs; // pending allocations
   minivector<ownable_t *> frees;   // pending reclaims
+  uint64_t aborts = 0;             // # transactions this thread has aborted
 
 public:
   /// A copy of snapshot_t from STMCAS
@@ -71,7 +72,7 @@ protected:
   void acquire_all() {
     for (auto o : lockset)
       if (!exo.acquire_consistent(o))
-        abort();
+        abort(tracer_t::ACQUIRE);
   }
 
   /// validate(), copied from HandSTM::redo_base_t
@@ -79,7 +80,7 @@ protected:
     // NB: on relaxed architectures, we may have unnecessary fences here
     for (auto o : readset) {
       if (exo.check_orec(o) == exotm_t::END_OF_TIME)
-        abort();
+        abort(tracer_t::VALIDATION);
     }
   }
 
@@ -90,12 +91,16 @@ protected:
       bool mine = false;
       bool ok = exo.check_continuation(o, old_start, mine);
       if (!ok && !mine)
-        abort();
+        abort(tracer_t::VALIDATION);
     }
   }
 
   /// abort(), copied from HandSTM::redo_base_t
-  void abort() {
+  ///
+  /// @param why The reason for the abort, for tracing
+  void abort(tracer_t::reason_t why = tracer_t::CONFLICT) {
+    EXO_TRACE(tracer_t::ABORT, why);
+    ++aborts;
     exo.unwind(exotm_t::ROLLBACK_ORECS); // roll back locks to release them
 
     // reset all lists.  Note that we can free right away, without SMR, because
@@ -124,6 +129,7 @@ protected:
     validate();
 
     // We're committed, so write-back, release locks, and clean up
+    exo.commit_begin();
     redolog.writeback();
     exo.wo_end();
     mallocs.clear();
@@ -154,10 +160,16 @@ public:
   uint64_t get_last_wo_end_time() { return exo.get_last_wo_end_time(); }
 
   /// Start an operation (notify SMR)
-  void op_begin() { smr.enter(); }
+  void op_begin() {
+    EXO_TRACE(tracer_t::OP_BEGIN);
+    smr.enter();
+  }
 
   /// End an operation (notify SMR)
-  void op_end() { smr.exit(_globals.smr); }
+  void op_end() {
+    smr.exit(_globals.smr);
+    EXO_TRACE(tracer_t::OP_END);
+  }
 
   /// A good hash function.  Works nicely to "finalize" after std::hash().
   ///
@@ -168,6 +180,9 @@ public:
 
   /// Produce a random number from a thread-local generator
   int rand() { return rng.rand(); }
+
+  /// Report how many transactions this thread has aborted
+  uint64_t get_aborts() { return aborts; }
 };
 
 /// HYBRID_GLOBALS_INITIALIZER should be called once, in the main C++ file of a
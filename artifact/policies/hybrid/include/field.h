@@ -2,6 +2,8 @@
 
 #include <atomic>
 
+#include "../../include/tracer.h"
+
 /// field_base_t has the code that is shared among all of our HandSTM policies'
 /// field implementations
 ///
@@ -23,6 +25,19 @@ protected:
   /// be friends of the RAII objects
   DESCRIPTOR &OP(typename DESCRIPTOR::STM &tx) { return *tx.op; }
 
+  /// Wait for the owner of o's orec to release it, as the policy's lock-wait
+  /// strategy allows
+  ///
+  /// @param tx The transaction that found the orec locked
+  /// @param o  The ownable for this location (locates the orec)
+  ///
+  /// @return true if the caller can try again instead of aborting
+  bool wait_for_release(typename DESCRIPTOR::STM &tx,
+                        typename DESCRIPTOR::OWNABLE *o) {
+    using WAIT = typename DESCRIPTOR::LOCK_WAIT;
+    return OP(tx).exo.template wait_for_release<WAIT>(o->orec());
+  }
+
 public:
   /// Read from shared memory (middle read in a sequence of reads of `o` by
   /// `tx`, without any control flow / computed addresses)
@@ -79,13 +94,15 @@ public:
   }
 
   /// Write the sField from a WSTEP.  The caller must ensure the corresponding
-  /// orec is owned before calling this.
+  /// orec is owned before calling this, and that the step has acquired every
+  /// orec it needs, since writing begins the step's commit.
   ///
   /// NB: memory_order_relaxed, because we assume it is owned
   ///
-  /// @param val   The new value
-  /// @param WSTEP An unused parameter to restrict access to WSTEP contexts
-  void sSet(T val, typename DESCRIPTOR::WSTEP &) {
+  /// @param val The new value
+  /// @param tx  The writing step
+  void sSet(T val, typename DESCRIPTOR::WSTEP &tx) {
+    tx.commit_begin();
     std::atomic_ref(this->_val).store(val, std::memory_order_relaxed);
   }
 };
@@ -141,7 +158,8 @@ public:
         return ret;
       }
 
-      // wait if locked
+      // wait if locked.  The owner is always committing, since it only locks
+      // orecs at commit time, so it will release them soon.
       while (locked)
         op(tx).exo.check_orec(o->orec(), locked);
 
@@ -167,7 +185,7 @@ public:
     // read the location, then orec.  If validation fails, we must abort.
     ret = op(tx).redolog.safe_read(&this->_val);
     if (op(tx).exo.check_orec(o->orec()) == DESCRIPTOR::EOT)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     return ret;
   }
 
@@ -248,9 +266,9 @@ public:
         return ret;
       }
 
-      // abort if locked
-      while (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -274,7 +292,7 @@ public:
     // read the location, then orec.  If validation fails, we must abort.
     ret = op(tx).redolog.safe_read(&this->_val);
     if (op(tx).exo.check_orec(o->orec()) == exotm_t::END_OF_TIME)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     return ret;
   }
 
@@ -308,9 +326,9 @@ public:
       if (op(tx).exo.acquire_consistent(o->orec(), locked))
         return;
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -375,9 +393,9 @@ public:
         return ret;
       }
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -411,7 +429,7 @@ public:
     // whoever owns it will abort and reset the orec to the value we logged in
     // a prior get().
     if (pre != post || pre == exotm_t::END_OF_TIME)
-      op(tx).abort();
+      op(tx).abort(tracer_t::VALIDATION);
     // Validation succeeded, so return the value without logging
     return ret;
   }
@@ -445,9 +463,9 @@ public:
       if (op(tx).exo.acquire_consistent(o->orec(), locked))
         return;
 
-      // abort if locked
-      if (locked)
-        op(tx).abort();
+      // abort if locked, unless the owner releases it soon
+      if (locked && !this->wait_for_release(tx, o))
+        op(tx).abort(tracer_t::LOCKED);
 
       // Extend the validity range, then try again
       auto old_start = op(tx).exo.get_start_time();
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <setjmp.h>
 
+#include "../../include/tracer.h"
+
 /// STM is the base for the ROSTM and WOSTM RAII objects, which delineate
 /// HandSTM-like transactions
 template <class DESCRIPTOR> struct Stm {
@@ -139,6 +141,12 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   /// Destruct the object to end the writing step
   ~WStep() { this->op->exo.wo_end(); }
 
+  /// Announce that the step has acquired everything it needs, and is about to
+  /// write.  Until the step ends, transactions may wait for it to release its
+  /// orecs instead of aborting.  sSet() calls this, so a step must acquire all
+  /// of its orecs before its first write.
+  void commit_begin() { this->op->exo.commit_begin(); }
+
   /// Acquire obj's orec, but only if its orec matches val
   ///
   /// @param obj The object whose orec we want to acquire
@@ -170,7 +178,10 @@ template <class DESCRIPTOR> struct WStep : Step<DESCRIPTOR> {
   }
 
   /// Unwind the step, so that it can be restarted
-  void unwind() { this->op->exo.unwind(); }
+  void unwind() {
+    EXO_TRACE(tracer_t::ABORT, tracer_t::UNWIND);
+    this->op->exo.unwind();
+  }
 
   /// Schedule an object for reclamation.  This should only be called from
   /// writing steps that won't unwind.
@@ -11,8 +11,11 @@
 /// - No quiescence, but safe memory reclamation
 /// - Can be configured with per-object or per-stripe orecs
 ///
-/// @tparam OP The orec policy to use.
-template <template <typename, typename> typename OP>
+/// @tparam OP   The orec policy to use.
+/// @tparam WAIT The lock-wait strategy to use (see exotm.h).  By default, a
+///              transaction that finds an orec locked does not wait.
+template <template <typename, typename> typename OP,
+          class WAIT = no_lock_wait_t>
 struct lazy_t : public base_t<OP> {
   using STM = Stm<lazy_t>;     // RAII ROSTM/WOSTM base
   using ROSTM = RoStm<lazy_t>; // RAII ROSTM manager
@@ -28,6 +31,7 @@ private:
   // Types needed by the (friend) field template, but not worth making public
   using OWNABLE = typename base_t<OP>::ownable_t;
   static const auto EOT = exotm_t::END_OF_TIME;
+  using LOCK_WAIT = WAIT;
 
 public:
   /// The type for fields that are shared and protected by HyPol
@@ -51,3 +55,8 @@ private:
   template <typename T, typename DESCRIPTOR> friend class field_base_t;
   template <typename T, typename DESCRIPTOR> friend class lazy_field;
 };
+
+/// lazy_t, but waiting for lock holders that are committing, instead of
+/// aborting at once
+template <template <typename, typename> typename OP>
+using lazy_wait_t = lazy_t<OP, commit_lock_wait_t<>>;
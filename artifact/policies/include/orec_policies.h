@@ -2,6 +2,13 @@
 
 #include "hash.h"
 
+/// The number of orecs in orec_ps_t's table.  This can be overridden at compile
+/// time (e.g., -DOREC_TABLE_SIZE=4096), to study how false conflicts depend on
+/// the size of the table.
+#ifndef OREC_TABLE_SIZE
+#define OREC_TABLE_SIZE 1048576
+#endif
+
 /// A policy that places orecs directly in reclaimable objects
 ///
 /// @tparam SMR  The safe memory reclamation's reclaimable object
@@ -39,8 +46,8 @@ template <class SMR, class OREC> struct orec_po_t {
 template <class SMR, class OREC> struct orec_ps_t {
   /// The global state for this policy
   struct global_t {
-    static const int NUM_ORECS = 1048576; // The number of orecs to use
-    OREC orecs[NUM_ORECS];                // The table of orecs
+    static const int NUM_ORECS = OREC_TABLE_SIZE; // The number of orecs
+    OREC orecs[NUM_ORECS];                        // The table of orecs
 
     /// Map an address to an orec table entry
     ///
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <x86intrin.h>
+
+/// phase_timer_t accumulates, per thread, the cycles that operations spend in
+/// each phase of their execution (traversal, lock acquisition, validation,
+/// write-back, SMR, and attempts that failed and had to be retried).  Dividing
+/// by the number of operations shows where an operation's time goes, which is
+/// the first thing to know before deciding what to optimize.
+///
+/// Phase accounting is compiled out unless the program is built with
+/// -DEXOTM_PHASES (e.g., `CXXFLAGS=-DEXOTM_PHASES make`), since it reads the
+/// cycle counter a few times per step or transaction.
+///
+/// NB: The counters are thread-local, so each thread must read its own.
+struct phase_timer_t {
+  /// The phases that time is charged to
+  enum phase_t {
+    OP,        // Whole operations, from SMR enter() to SMR exit()
+    SMR,       // SMR enter() and exit(), including sweeps
+    TRAVERSE,  // Read-only steps, and transactions before commit
+    ACQUIRE,   // Writing steps, and commit-time lock acquisition
+    VALIDATE,  // Commit-time validation
+    WRITEBACK, // Commit-time redo write-back and lock release
+    RETRY,     // Steps and transactions that failed, and will be retried
+    NUM_PHASES
+  };
+
+  /// The names of the phases, for reporting
+  static constexpr const char *NAMES[NUM_PHASES] = {
+      "op", "smr", "traverse", "acquire", "validate", "writeback", "retry"};
+
+  /// The calling thread's cycles in each phase
+  static inline thread_local uint64_t cycles[NUM_PHASES] = {0};
+
+  /// Discard the calling thread's counts (e.g., after warm-up)
+  static void reset() {
+    for (auto &c : cycles)
+      c = 0;
+  }
+
+  /// Report whether phase accounting was compiled in
+  static constexpr bool enabled() {
+#ifdef EXOTM_PHASES
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+#ifdef EXOTM_PHASES
+/// A span of time that can be charged to a phase.  It starts when it is
+/// constructed, and each charge() restarts it, so that consecutive phases of
+/// one transaction can share a span.
+class phase_span_t {
+  uint64_t start; // When the span (re)started
+  uint64_t fails; // The owner's failure count when the span started
+
+public:
+  /// Start a span
+  ///
+  /// @param fails The owner's current count of failures, so that charge() can
+  ///              tell whether the span ended in a failure
+  explicit phase_span_t(uint64_t fails = 0) : start(__rdtsc()), fails(fails) {}
+
+  /// Restart the span without charging it
+  ///
+  /// @param fails The owner's current count of failures
+  void restart(uint64_t fails = 0) {
+    start = __rdtsc();
+    this->fails = fails;
+  }
+
+  /// Charge the time since the span started to a phase, and restart the span
+  ///
+  /// @param p     The phase to charge
+  /// @param fails The owner's current count of failures.  If it changed since
+  ///              the span started, the time is charged to RETRY instead.
+  void charge(phase_timer_t::phase_t p, uint64_t fails = 0) {
+    uint64_t now = __rdtsc();
+    phase_timer_t::cycles[fails == this->fails ? p : phase_timer_t::RETRY] +=
+        now - start;
+    start = now;
+    this->fails = fails;
+  }
+};
+#else
+/// Without -DEXOTM_PHASES, spans do nothing
+class phase_span_t {
+public:
+  explicit phase_span_t(uint64_t = 0) {}
+  void restart(uint64_t = 0) {}
+  void charge(phase_timer_t::phase_t, uint64_t = 0) {}
+};
+#endif
+
+/// A phase_span_t that charges itself to a phase when it goes out of scope
+class phase_scope_t {
+  phase_span_t span;        // The span being timed
+  phase_timer_t::phase_t p; // The phase to charge
+
+public:
+  /// Start timing a scope
+  ///
+  /// @param p The phase to charge when the scope ends
+  explicit phase_scope_t(phase_timer_t::phase_t p) : p(p) {}
+
+  /// Charge the scope's time
+  ~phase_scope_t() { span.charge(p); }
+};
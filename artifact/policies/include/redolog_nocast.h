@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
@@ -25,7 +26,14 @@
 ///     will not be able to log it correctly.
 ///
 /// NB: redolog_t cannot handle scalars with a size greater than 8 bytes
-template <int CHUNKSIZE = 32> class redolog_nocast_t {
+///
+/// NB: Most transactions write only a few chunks.  Until the log holds more
+///     than LINEAR_LIMIT chunks, lookups just scan the vector, and the index
+///     is neither consulted nor maintained.  The index is built when the log
+///     first outgrows that limit, and only then does clear() have to bump its
+///     version.  LINEAR_LIMIT must be less than the initial capacity, and 0
+///     means "always use the index".
+template <int CHUNKSIZE = 32, size_t LINEAR_LIMIT = 8> class redolog_nocast_t {
   /// MASK is for isolating/clearing the low bits of an address.
   static const uintptr_t MASK = ((uintptr_t)CHUNKSIZE) - 1;
 
@@ -68,6 +76,9 @@ template <int CHUNKSIZE = 32> class redolog_nocast_t {
     size_t count;              // Current # elements in vector
   } vec;
 
+  /// True once `vec` has outgrown LINEAR_LIMIT, and `ht` indexes it
+  bool indexed = false;
+
   /// This hash function is straight from CLRS (that's where the magic constant
   /// comes from).
   size_t hash(uintptr_t const key) const {
@@ -93,8 +104,11 @@ template <int CHUNKSIZE = 32> class redolog_nocast_t {
     // double the index size
     delete[] ht.tbl;
     ht.tbl = new index_t[doubleIndexLength()];
+    reindex();
+  }
 
-    // rehash the elements
+  /// Add every chunk in `vec` to `ht`, which must not have any valid entries
+  void reindex() {
     for (size_t i = 0; i < vec.count; ++i) {
       size_t h = hash(vec.chunks[i].bAddr);
 
@@ -124,11 +138,23 @@ template <int CHUNKSIZE = 32> class redolog_nocast_t {
     ht.ver = 1;
   }
 
+  /// Scan `vec` for the chunk containing `key`, or return -1 on failure.  Use
+  /// this only while the log is not indexed.
+  int scan(uintptr_t key) const {
+    for (size_t i = 0; i < vec.count; ++i)
+      if (vec.chunks[i].bAddr == key)
+        return i;
+    return -1;
+  }
+
 public:
   /// Construct a RedoLog by providing an initial capacity (default 64)
   redolog_nocast_t(const size_t initial_capacity = 64)
       : ht({nullptr, 0, 1, 8 * sizeof(uint32_t)}),
         vec({nullptr, initial_capacity, 0}) {
+    // reserve() appends without checking capacity while the log is not indexed
+    assert(initial_capacity > LINEAR_LIMIT &&
+           "ERROR: LINEAR_LIMIT must be less than the initial capacity");
     // Find a good index length for the initial capacity of the list.
     while (ht.len < SPILL_FACTOR * initial_capacity)
       doubleIndexLength();
@@ -146,6 +172,8 @@ public:
   /// Use linear probing to find the vector index of the chunk containing `key`,
   /// or -1 on failure
   int lookup(uintptr_t key) {
+    if (!indexed)
+      return scan(key);
     size_t h = hash(key);
     while (ht.tbl[h].vVer == ht.ver) { // Chunk only valid if versions match
       if (ht.tbl[h].cAddr == key)
@@ -165,6 +193,21 @@ public:
   ///
   /// NB: we expect key's low bits to be masked to zero
   size_t reserve(uintptr_t key) {
+    // Small logs are searched linearly.  If this is a new chunk that pushes
+    // the log past LINEAR_LIMIT, index everything and continue with `ht`.
+    if (!indexed) {
+      int idx = scan(key);
+      if (idx != -1)
+        return idx;
+      if (__builtin_expect(vec.count < LINEAR_LIMIT, true)) {
+        vec.chunks[vec.count].bAddr = key;
+        vec.chunks[vec.count].vBytes = 0LL;
+        return vec.count++;
+      }
+      reindex();
+      indexed = true;
+    }
+
     //  Find the slot that this address should hash to. If it is valid,
     //  return the index. If we find an unused slot then it's a new
     //  insertion.
@@ -200,6 +243,10 @@ public:
   /// fast-clear the hash by bumping the version number
   void clear() {
     vec.count = 0;
+    // If the index was never built, it has no valid entries to clear
+    if (!indexed)
+      return;
+    indexed = false;
     ht.ver += 1;
     // if there is version number overflow, we'll need to do a heavyweight reset
     // of the index
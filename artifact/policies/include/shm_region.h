@@ -0,0 +1,336 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdint>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+/// shm_region_t manages a region of memory that is mapped MAP_SHARED, so that
+/// several processes can operate on the same data structure.  Each process may
+/// map the region at a different address, so objects in the region must refer
+/// to each other by offsets (see shm_ptr_t), never by pointers.
+///
+/// The region begins with a header, which holds the allocator's metadata, a
+/// root offset through which processes find the data structure in the region,
+/// and the registry of thread slots used by shm_smr_t.  The rest of the region
+/// is carved into chunks, each of which is dedicated to one power-of-two size
+/// class, so that free() can find an object's size class from its offset.
+///
+/// NB: A process maps at most one region at a time.  Its base address is a
+///     per-process global, so that a shm_ptr_t is no bigger than a pointer.
+///
+/// NB: Allocation uses a spin lock per size class.  If a process dies while
+///     holding one, or while in the middle of an operation, the region must be
+///     discarded.
+class shm_region_t {
+public:
+  /// The maximum number of threads, across all processes, that can have a
+  /// shm_smr_t at the same time
+  static const int MAX_SLOTS = 1024;
+
+  /// A thread's entry in the registry of timestamps.  Slots are never freed,
+  /// only released and re-claimed.  A slot whose process died without
+  /// releasing it can be released by any other process (see release_if_dead).
+  ///
+  /// NB: Slots are padded, since each thread writes its slot's timestamp on
+  ///     every operation
+  struct alignas(64) slot_t {
+    std::atomic<uint64_t> ts; // The owning thread's timestamp
+    std::atomic<bool> in_use; // Is this slot owned by a live thread?
+    std::atomic<pid_t> pid;   // The process that owns the slot, or 0
+
+    /// Construct an unowned slot
+    slot_t() : ts(ULLONG_MAX), in_use(false), pid(0) {}
+  };
+
+private:
+  /// A value that identifies an initialized region
+  static const uint64_t MAGIC = 0x65786f544d73686dULL;
+
+  /// log_2 of the size of a chunk
+  static const int CHUNK_BITS = 20;
+
+  /// The size of a chunk
+  static const uint64_t CHUNK_SIZE = 1ULL << CHUNK_BITS;
+
+  /// log_2 of the smallest and largest size classes
+  static const int MIN_SHIFT = 4, MAX_SHIFT = 12;
+
+  /// The number of size classes
+  static const int NUM_CLASSES = MAX_SHIFT - MIN_SHIFT + 1;
+
+  /// The size class of chunks that belong to an allocation bigger than
+  /// 2^MAX_SHIFT bytes
+  static const uint8_t LARGE = 0xFF;
+
+  /// The allocator's metadata for one size class
+  struct alignas(64) class_t {
+    std::atomic<bool> lock; // Protects the other fields
+    uint64_t free_head;     // Offset of the first free object, or 0
+    uint64_t bump;          // Offset of the next unused object in the chunk
+    uint64_t bump_end;      // Offset of the end of the current chunk
+
+    /// Construct a size class with no memory
+    class_t() : lock(false), free_head(0), bump(0), bump_end(0) {}
+  };
+
+  /// The header at the start of every region.  It is followed by one byte per
+  /// chunk, holding the size class of that chunk.
+  struct header_t {
+    const uint64_t magic;             // MAGIC, once the header is initialized
+    const uint64_t size;              // The size of the region, in bytes
+    std::atomic<uint64_t> next_chunk; // Offset of the next unused chunk
+    std::atomic<uint64_t> root;       // Offset of the root object, or 0
+    std::atomic<uint32_t> slot_count; // Number of slots that were ever used
+    class_t classes[NUM_CLASSES];     // Allocator metadata, by size class
+    slot_t slots[MAX_SLOTS];          // The registry for shm_smr_t
+
+    /// Construct the header of a region of `_size` bytes
+    header_t(uint64_t _size)
+        : magic(MAGIC), size(_size), root(0), slot_count(0) {
+      uint64_t data = sizeof(header_t) + (size >> CHUNK_BITS);
+      next_chunk = (data + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1);
+    }
+
+    /// Get the table of chunk size classes
+    uint8_t *chunk_class() { return reinterpret_cast<uint8_t *>(this + 1); }
+  };
+
+  static inline char *base = nullptr; // This process's mapping of the region
+  static inline size_t mapped = 0;    // The size of the mapping
+
+  /// Get the region's header
+  static header_t *header() { return reinterpret_cast<header_t *>(base); }
+
+  /// Map `bytes` bytes of the shared memory object `fd` into this process
+  static void map(int fd, size_t bytes) {
+    void *mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_NORESERVE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+      throw std::runtime_error("shm_region_t: mmap failed");
+    base = static_cast<char *>(mem);
+    mapped = bytes;
+  }
+
+  /// Reserve `n` contiguous chunks
+  ///
+  /// @return The offset of the first chunk
+  static uint64_t new_chunks(uint64_t n) {
+    uint64_t off = header()->next_chunk.fetch_add(n * CHUNK_SIZE);
+    if (off + n * CHUNK_SIZE > header()->size)
+      throw std::bad_alloc();
+    return off;
+  }
+
+  /// Acquire the lock of a size class
+  static void lock(class_t &c) {
+    while (c.lock.exchange(true, std::memory_order_acquire))
+      _mm_pause();
+  }
+
+  /// Release the lock of a size class
+  static void unlock(class_t &c) {
+    c.lock.store(false, std::memory_order_release);
+  }
+
+public:
+  /// Create a new shared memory object, map it, and initialize it as an empty
+  /// region.  Any existing object with the same name is replaced.
+  ///
+  /// @param name  The name of the shared memory object (e.g., "/my_map")
+  /// @param bytes The size of the region.  Memory is only committed as it is
+  ///              used, so this can be generous.
+  static void create(const std::string &name, size_t bytes) {
+    bytes = (bytes + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1);
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0)
+      throw std::runtime_error("shm_region_t: cannot create " + name);
+    if (ftruncate(fd, bytes) != 0) {
+      close(fd);
+      throw std::runtime_error("shm_region_t: cannot size " + name);
+    }
+    detach();
+    map(fd, bytes);
+    new (base) header_t(bytes);
+  }
+
+  /// Map an existing region into this process.  If the process already has a
+  /// region mapped, it is unmapped first, so any pointers into it become
+  /// invalid (offsets remain valid).
+  ///
+  /// @param name The name of the shared memory object
+  static void attach(const std::string &name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+      throw std::runtime_error("shm_region_t: cannot open " + name);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw std::runtime_error("shm_region_t: cannot stat " + name);
+    }
+    detach();
+    map(fd, st.st_size);
+    if (header()->magic != MAGIC)
+      throw std::runtime_error("shm_region_t: " + name + " is not a region");
+  }
+
+  /// Unmap this process's region, if it has one
+  static void detach() {
+    if (base != nullptr)
+      munmap(base, mapped);
+    base = nullptr;
+    mapped = 0;
+  }
+
+  /// Remove a shared memory object's name.  Processes that have it mapped can
+  /// keep using it.
+  ///
+  /// @param name The name of the shared memory object
+  static void unlink(const std::string &name) { shm_unlink(name.c_str()); }
+
+  /// Convert a pointer into the region to an offset
+  static uint64_t to_offset(const void *ptr) {
+    return static_cast<const char *>(ptr) - base;
+  }
+
+  /// Convert an offset to a pointer into this process's mapping of the region
+  static void *from_offset(uint64_t off) { return base + off; }
+
+  /// Get the offset of the root object, which is 0 until some process sets it
+  static std::atomic<uint64_t> &root() { return header()->root; }
+
+  /// Get the registry of thread slots
+  static slot_t *slots() { return header()->slots; }
+
+  /// Get the number of registry slots that have ever been used
+  static std::atomic<uint32_t> &slot_count() { return header()->slot_count; }
+
+  /// Release a slot if the process that owns it no longer exists, so that its
+  /// timestamp stops holding back reclamation, and so that another thread can
+  /// claim it.
+  ///
+  /// NB: A process that dies while holding an allocator lock, or in the middle
+  ///     of a writing step, still leaves the region unusable.  If the dead
+  ///     process's pid has been reused, the slot is not released.
+  ///
+  /// @param s The slot to check
+  ///
+  /// @return True if this call released the slot
+  static bool release_if_dead(slot_t &s) {
+    pid_t owner = s.pid.load();
+    if (owner == 0 || owner == getpid() || kill(owner, 0) == 0 ||
+        errno != ESRCH)
+      return false;
+    // Only one process may release the slot
+    if (!s.pid.compare_exchange_strong(owner, 0))
+      return false;
+    s.ts = ULLONG_MAX;
+    s.in_use.store(false, std::memory_order_release);
+    return true;
+  }
+
+  /// Allocate `bytes` bytes from the region.  The object is aligned to its
+  /// size class, up to 2^MAX_SHIFT.
+  ///
+  /// @param bytes The number of bytes to allocate
+  ///
+  /// @return A pointer to the new object in this process's mapping
+  static void *alloc(size_t bytes) {
+    // Big allocations get their own chunks
+    if (bytes > (1ULL << MAX_SHIFT)) {
+      uint64_t n = (bytes + CHUNK_SIZE - 1) >> CHUNK_BITS;
+      uint64_t off = new_chunks(n);
+      for (uint64_t i = 0; i < n; ++i)
+        header()->chunk_class()[(off >> CHUNK_BITS) + i] = LARGE;
+      return base + off;
+    }
+
+    int shift = MIN_SHIFT;
+    while ((1ULL << shift) < bytes)
+      ++shift;
+    class_t &c = header()->classes[shift - MIN_SHIFT];
+    lock(c);
+    uint64_t off = c.free_head;
+    if (off != 0) {
+      c.free_head = *reinterpret_cast<uint64_t *>(base + off);
+    } else {
+      if (c.bump == c.bump_end) {
+        uint64_t chunk;
+        try {
+          chunk = new_chunks(1);
+        } catch (...) {
+          unlock(c);
+          throw;
+        }
+        header()->chunk_class()[chunk >> CHUNK_BITS] = shift;
+        c.bump = chunk;
+        c.bump_end = chunk + CHUNK_SIZE;
+      }
+      off = c.bump;
+      c.bump += 1ULL << shift;
+    }
+    unlock(c);
+    return base + off;
+  }
+
+  /// Return an object to the region.  Big allocations are never reclaimed.
+  ///
+  /// @param ptr A pointer (in this process's mapping) returned by alloc()
+  static void free(void *ptr) {
+    uint64_t off = to_offset(ptr);
+    uint8_t shift = header()->chunk_class()[off >> CHUNK_BITS];
+    if (shift == LARGE)
+      return;
+    class_t &c = header()->classes[shift - MIN_SHIFT];
+    lock(c);
+    *reinterpret_cast<uint64_t *>(ptr) = c.free_head;
+    c.free_head = off;
+    unlock(c);
+  }
+};
+
+/// shm_ptr_t is a position-independent pointer to an object in the process's
+/// shm_region_t.  It stores the object's offset in the region, which is the
+/// same in every process, and converts it to a pointer on use.  The offset 0
+/// (the region header) represents nullptr.
+///
+/// shm_ptr_t is trivially copyable, so it can be stored in a std::atomic (and
+/// hence in an STMCAS field).
+///
+/// @tparam T The type of object that is referenced
+template <typename T> class shm_ptr_t {
+  uint64_t off; // The object's offset in the region, or 0 for nullptr
+
+public:
+  /// Construct a null shm_ptr_t
+  shm_ptr_t() : off(0) {}
+
+  /// Construct a shm_ptr_t from a pointer into this process's region
+  ///
+  /// @param ptr The pointer, or nullptr
+  shm_ptr_t(T *ptr) : off(ptr ? shm_region_t::to_offset(ptr) : 0) {}
+
+  /// Convert to a pointer into this process's mapping of the region
+  T *get() const {
+    return off ? static_cast<T *>(shm_region_t::from_offset(off)) : nullptr;
+  }
+
+  /// Access the referenced object
+  T *operator->() const { return get(); }
+
+  /// Report the offset of the referenced object
+  uint64_t offset() const { return off; }
+
+  /// Compare two shm_ptr_ts
+  bool operator==(const shm_ptr_t &other) const { return off == other.off; }
+};
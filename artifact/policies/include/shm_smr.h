@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <stdexcept>
+#include <unistd.h>
+#include <utility>
+#include <x86intrin.h>
+
+#include "minivector.h"
+#include "shm_region.h"
+#include "tracer.h"
+
+/// shm_smr_t is the counterpart of timestamp_smr_t for objects that live in a
+/// shm_region_t.  The algorithm is the same: an operation publishes a timestamp
+/// when it starts, and an object that was unlinked at time T can be freed once
+/// every thread has either cleared its timestamp or published one larger than
+/// T.  Since rdtscp is synchronized across the cores of a host, the timestamps
+/// of different processes can be compared.
+///
+/// The difference is that the registry of timestamps is a fixed array of slots
+/// in the region's header, so that threads of every process that has the region
+/// mapped see each other.  The lists of objects awaiting reclamation are still
+/// private to each thread, since only the thread that unlinked an object will
+/// free it.
+///
+/// NB: Objects are returned to the region without running a destructor, so
+///     only trivially destructible objects may be reclaimed.
+///
+/// If a process dies without destroying its contexts, their slots are
+/// released by the next sweep that they hold back, or by the next context that
+/// finds no free slot.
+class shm_smr_t {
+  /// How many times can we insert into the unreachable set before requiring a
+  /// sweep()
+  static const int SWEEP_THRESHOLD = 1024;
+
+  shm_region_t::slot_t *slot; // This thread's slot in the registry
+  uint32_t index;             // The index of `slot` in the registry
+  minivector<void *> pending; // Objects to reclaim
+
+  /// Objects that are logically unreachable, but maybe not reclaimable yet due
+  /// to concurrent optimistic accesses.
+  std::deque<std::pair<void *, uint64_t>> unreachable;
+
+  /// How many more exits before we need to sweep
+  int exits_remaining = SWEEP_THRESHOLD;
+
+public:
+  /// Construct a shm_smr_t context by claiming a free slot in the registry of
+  /// the process's region
+  shm_smr_t() : slot(nullptr), index(0) {
+    if (!claim_slot()) {
+      // Release the slots of dead processes, then try again
+      auto slots = shm_region_t::slots();
+      for (uint32_t i = 0, n = shm_region_t::slot_count(); i < n; ++i)
+        shm_region_t::release_if_dead(slots[i]);
+      if (!claim_slot())
+        throw std::runtime_error("shm_smr_t: no free registry slots");
+    }
+    // Make sure sweep() will look at our slot
+    auto &count = shm_region_t::slot_count();
+    uint32_t c = count.load();
+    while (c <= index && !count.compare_exchange_weak(c, index + 1)) {
+    }
+  }
+
+  /// Destroy a shm_smr_t context.  Anything still awaiting reclamation is
+  /// reclaimed once it is safe to do so, and then the slot is released.
+  ///
+  /// NB: Must not be called from within an enter()/exit() region.
+  ~shm_smr_t() {
+    unsigned int dummy;
+    uint64_t time = __rdtscp(&dummy);
+    for (auto p : pending)
+      unreachable.push_back({p, time});
+    pending.clear();
+    while (true) {
+      sweep();
+      if (unreachable.empty())
+        break;
+      _mm_pause();
+    }
+    slot->ts = ULLONG_MAX;
+    slot->pid = 0;
+    slot->in_use.store(false, std::memory_order_release);
+  }
+
+  /// Report an id for this context that is unique among all live contexts in
+  /// all processes that share the region
+  uint64_t id() const { return index + 1; }
+
+  /// Begin a region that will optimistically access shared objects
+  void enter() {
+    unsigned int dummy;
+    slot->ts.exchange(__rdtscp(&dummy));
+  }
+
+  /// Exit a region that optimistically accesses shared objects
+  void exit() {
+    slot->ts = (ULLONG_MAX); // only need store fence, not load fence
+    if (!pending.size())
+      return;
+    unsigned int dummy;
+    uint64_t time = __rdtscp(&dummy);
+    for (auto p : pending)
+      unreachable.push_back({p, time});
+    pending.clear();
+    if (--exits_remaining > 0)
+      return;
+    exits_remaining = SWEEP_THRESHOLD;
+    sweep();
+  }
+
+  /// Schedule an object for reclamation
+  void reclaim(void *ptr) { pending.push_back(ptr); }
+
+private:
+  /// Claim the first free slot in the registry
+  ///
+  /// @return True if a slot was claimed
+  bool claim_slot() {
+    auto slots = shm_region_t::slots();
+    for (uint32_t i = 0; i < shm_region_t::MAX_SLOTS; ++i) {
+      bool expected = false;
+      if (!slots[i].in_use.load(std::memory_order_relaxed) &&
+          slots[i].in_use.compare_exchange_strong(expected, true)) {
+        slot = &slots[i];
+        index = i;
+        slot->pid = getpid();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Traverse the `unreachable` collection and return anything whose timestamp
+  /// indicates that it cannot be undergoing optimistic access to the region.
+  void sweep() {
+    EXO_TRACE(tracer_t::SWEEP_BEGIN, unreachable.size());
+    // Find ts of oldest running operation, in any process.  If it holds back
+    // the oldest unreachable object, and its process has died, it will never
+    // finish, so release its slot and look again.
+    uint64_t oldest;
+    auto slots = shm_region_t::slots();
+    while (true) {
+      oldest = ULLONG_MAX;
+      uint32_t oldest_index = 0;
+      for (uint32_t i = 0, n = shm_region_t::slot_count(); i < n; ++i) {
+        auto t = slots[i].ts.load();
+        if (t < oldest) {
+          oldest = t;
+          oldest_index = i;
+        }
+      }
+      if (unreachable.empty() || unreachable.front().second < oldest ||
+          !shm_region_t::release_if_dead(slots[oldest_index]))
+        break;
+    }
+    uint32_t freed = 0;
+    while (!unreachable.empty()) {
+      auto [ptr, ts] = unreachable.front();
+      if (ts >= oldest)
+        break;
+      shm_region_t::free(ptr);
+      unreachable.pop_front();
+      ++freed;
+    }
+    EXO_TRACE(tracer_t::SWEEP_END, freed);
+  }
+};
@@ -7,6 +7,8 @@
 #include <x86intrin.h>
 
 #include "minivector.h"
+#include "phases.h"
+#include "tracer.h"
 
 /// timestamp_smr_t is a safe memory reclamation algorithm based on the use of
 /// timestamps.
@@ -29,7 +31,14 @@
 /// store a flat list of {pointer, timestamp} pairs.
 ///
 /// Each thread should have its own timestamp_smr_t instance, all of which
-/// should share the same timestamp_smr_t::global_t instance
+/// should share the same timestamp_smr_t::global_t instance.
+///
+/// Threads may come and go: a thread's timestamp lives in a slot_t that is
+/// linked into a global list, and when a timestamp_smr_t is destroyed, its slot
+/// is released so that the next timestamp_smr_t to be constructed can claim it.
+/// Thus the list that sweep() traverses is bounded by the maximum number of
+/// threads that were ever live at the same time, not by the number of threads
+/// that were ever created.
 class timestamp_smr_t {
   /// How many times can we insert into the unreachable set before requiring a
   /// sweep()
@@ -44,20 +53,40 @@ public:
     virtual ~reclaimable_t() {}
   };
 
+private:
+  /// A thread's entry in the global list of timestamps.  Slots are never
+  /// unlinked or freed, only released and re-claimed, so a sweep() can always
+  /// traverse the list safely.
+  ///
+  /// NB: Slots are padded, since each thread writes its slot's timestamp on
+  ///     every enter() and exit()
+  struct alignas(64) slot_t {
+    std::atomic<uint64_t> ts; // The owning thread's timestamp
+    std::atomic<bool> in_use; // Is this slot owned by a live thread?
+    slot_t *next;             // Next slot in the list
+
+    /// Construct a slot that is owned by the calling thread
+    slot_t() : ts(ULLONG_MAX), in_use(true), next(nullptr) {}
+  };
+
+public:
   /// Global variables related to timestamp_smr_t.  A synchronization policy
   /// that uses timestamp_smr_t is responsible for defining exactly one instance
   /// of this object.
   struct global_t {
-    /// A pointer to the head of the list of timestamp_smr_t contexts
-    std::atomic<timestamp_smr_t *> all_threads;
+    /// A pointer to the head of the list of thread slots
+    std::atomic<slot_t *> all_threads;
+
+    /// The largest timestamp of any object that has been reclaimed
+    std::atomic<uint64_t> last_reclaimed;
 
-    /// Construct a global context by zeroing the pointer to thread contexts
-    global_t() : all_threads(nullptr) {}
+    /// Construct a global context by zeroing the pointer to thread slots
+    global_t() : all_threads(nullptr), last_reclaimed(0) {}
   };
 
 private:
-  timestamp_smr_t *next;               // Next thread in the chain
-  std::atomic<uint64_t> ts;            // This thread's timestamp
+  global_t &shared;                    // The globals this context uses
+  slot_t *slot;                        // This thread's slot in the list
   minivector<reclaimable_t *> pending; // Objects to reclaim
 
   /// Objects that are logically unreachable, but maybe not reclaimable yet due
@@ -67,75 +96,151 @@ private:
   /// How many more exits before we need to sweep
   int exits_remaining = SWEEP_THRESHOLD;
 
+  /// The time since the current enter(), for phase accounting
+  phase_span_t op_span;
+
 public:
-  /// Construct a timestamp_smr_t context by atomically adding it to the end of
-  /// the global list
-  timestamp_smr_t(global_t &_globals) : ts(ULLONG_MAX) {
+  /// Construct a timestamp_smr_t context by claiming a released slot from the
+  /// global list, or by atomically adding a new slot to the head of the list if
+  /// none is available
+  timestamp_smr_t(global_t &_globals) : shared(_globals), slot(nullptr) {
+    for (auto s = shared.all_threads.load(); s != nullptr; s = s->next) {
+      bool expected = false;
+      if (!s->in_use.load(std::memory_order_relaxed) &&
+          s->in_use.compare_exchange_strong(expected, true)) {
+        slot = s;
+        return;
+      }
+    }
+    slot = new slot_t();
+    while (true) {
+      slot_t *curr_head = shared.all_threads;
+      slot->next = curr_head;
+      if (shared.all_threads.compare_exchange_strong(curr_head, slot))
+        break;
+    }
+  }
+
+  /// Destroy a timestamp_smr_t context.  Anything still awaiting reclamation is
+  /// reclaimed once it is safe to do so, and then the slot is released.
+  ///
+  /// NB: Must not be called from within an enter()/exit() region.  The wait
+  ///     for concurrent operations is bounded by the length of the longest
+  ///     in-flight operation.
+  ~timestamp_smr_t() {
+    unsigned int dummy;
+    uint64_t time = __rdtscp(&dummy);
+    for (auto p : pending)
+      unreachable.push_back({p, time});
+    pending.clear();
     while (true) {
-      timestamp_smr_t *curr_head = _globals.all_threads;
-      next = curr_head;
-      if (_globals.all_threads.compare_exchange_strong(curr_head, this))
+      sweep(shared);
+      if (unreachable.empty())
         break;
+      _mm_pause();
     }
+    slot->ts = ULLONG_MAX;
+    slot->in_use.store(false, std::memory_order_release);
   }
 
   /// Begin a region that will optimistically access reclaimable_t objects
   void enter() {
+    phase_scope_t scope(phase_timer_t::SMR);
+    op_span.restart();
     // enter the "epoch"
     unsigned int dummy;
     // TODO: Can we get by with rdtsc, since ts.exchange is a load/store fence
     //        and there is a data dependence?
-    ts.exchange(__rdtscp(&dummy));
+    slot->ts.exchange(__rdtscp(&dummy));
   }
 
   /// Exit a region that optimistically accesses reclaimable_t objects
   ///
   /// @param globals A reference to the global state for timestamp_smr_t
   void exit(global_t &globals) {
+    phase_span_t span;
     // exit the "epoch"
-    ts = (ULLONG_MAX); // only need store fence, not load fence
+    slot->ts = (ULLONG_MAX); // only need store fence, not load fence
     // If we have pendings, we need a timestamp for them, then we can move them
     // to `unreachable`
-    if (!pending.size())
-      return;
-    unsigned int dummy;
-    uint64_t time = __rdtscp(&dummy);
-    for (auto p : pending)
-      unreachable.push_back({p, time});
-    pending.clear();
-    // Check if it's time to sweep...
-    if (--exits_remaining > 0)
-      return;
-    exits_remaining = SWEEP_THRESHOLD;
-    sweep(globals);
+    if (pending.size()) {
+      unsigned int dummy;
+      uint64_t time = __rdtscp(&dummy);
+      for (auto p : pending)
+        unreachable.push_back({p, time});
+      pending.clear();
+      // Check if it's time to sweep...
+      if (--exits_remaining <= 0) {
+        exits_remaining = SWEEP_THRESHOLD;
+        sweep(globals);
+      }
+    }
+    span.charge(phase_timer_t::SMR);
+    op_span.charge(phase_timer_t::OP);
   }
 
   /// Schedule an object for reclamation
   void reclaim(reclaimable_t *ptr) { pending.push_back(ptr); }
 
+  /// Report the timestamp of the current enter()/exit() region
+  uint64_t get_enter_time() const {
+    return slot->ts.load(std::memory_order_relaxed);
+  }
+
+  /// Report if any object that was scheduled for reclamation at or after
+  /// `time` might have been reclaimed.  A thread that holds a pointer across
+  /// regions can use this to check, before and after accessing the object,
+  /// that it is still safe to do so, as long as the object was reachable in a
+  /// region that started at `time`.
+  ///
+  /// @param globals A reference to the global state for timestamp_smr_t
+  /// @param time    The timestamp of the region where the object was reachable
+  ///
+  /// @return true if the object might have been reclaimed
+  static bool reclaimed_since(global_t &globals, uint64_t time) {
+    return globals.last_reclaimed.load(std::memory_order_acquire) >= time;
+  }
+
 private:
   /// Traverse the `unreachable` collection and reclaim anything whose timestamp
   /// indicates that it cannot be undergoing optimistic access.
   ///
   /// @param globals A reference to the global state for timestamp_smr_t
   void sweep(global_t &globals) {
+    EXO_TRACE(tracer_t::SWEEP_BEGIN, unreachable.size());
     // Find ts of oldest running operation
     uint64_t oldest = ULLONG_MAX;
     auto head = globals.all_threads.load();
+    // NB: Released slots hold ULLONG_MAX, so they never constrain `oldest`
     while (head != nullptr) {
       auto t = head->ts.load();
       if (t < oldest)
         oldest = t;
       head = head->next;
     }
-    // We know the deque is ordered from oldest to newest, so keep sweeping from
-    // the front until there's nothing old enough
-    while (!unreachable.empty()) {
-      auto [ptr, ts] = unreachable.front();
-      if (ts >= oldest)
-        return;
-      delete ptr;
+    // We know the deque is ordered from oldest to newest, so find the prefix
+    // that is old enough
+    size_t count = 0;
+    while (count < unreachable.size() && unreachable[count].second < oldest)
+      ++count;
+    if (count == 0) {
+      EXO_TRACE(tracer_t::SWEEP_END);
+      return;
+    }
+
+    // Announce the newest timestamp that is about to be reclaimed *before*
+    // reclaiming anything (see reclaimed_since)
+    uint64_t newest = unreachable[count - 1].second;
+    uint64_t last = globals.last_reclaimed.load();
+    while (last < newest &&
+           !globals.last_reclaimed.compare_exchange_weak(last, newest)) {
+    }
+
+    // Reclaim the prefix
+    for (size_t i = 0; i < count; ++i) {
+      delete unreachable.front().first;
       unreachable.pop_front();
     }
+    EXO_TRACE(tracer_t::SWEEP_END, count);
   }
 };
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include <x86intrin.h>
+
+/// tracer_t records timestamped events (operation and transaction boundaries,
+/// commits, aborts, failed orec acquisitions, SMR sweeps, resizes) into a ring
+/// buffer per thread, and writes them all to a Chrome trace / Perfetto JSON
+/// file when the program exits.  Counters say how many aborts happened; a
+/// timeline shows when, and what else was happening at the time.
+///
+/// Tracing is compiled out unless the program is built with -DEXOTM_TRACE
+/// (e.g., `CXXFLAGS=-DEXOTM_TRACE make`).  The output file is
+/// `exotm_trace.json`, unless the EXOTM_TRACE_FILE environment variable names
+/// a different one.  Load it at https://ui.perfetto.dev or chrome://tracing.
+///
+/// Each ring buffer is written only by its thread, so recording an event is
+/// just an rdtsc and a store.  When a ring fills, the oldest events are
+/// overwritten.  When a thread exits, its ring goes back to the registry, and
+/// the next thread to record an event continues in that ring, so there are only
+/// as many rings as there were threads alive at once.  Each ring is one row of
+/// the timeline, and it keeps the events of the threads that used it, until
+/// they are overwritten.
+///
+/// NB: The dump happens at exit, so it assumes that the other threads are no
+///     longer recording.
+class tracer_t {
+public:
+  /// The kinds of events that can be recorded
+  enum event_t : uint16_t {
+    OP_BEGIN,     // A data structure operation started (op_begin)
+    OP_END,       // A data structure operation finished (op_end)
+    RO_BEGIN,     // A read-only step or transaction started
+    WO_BEGIN,     // A writing step or transaction started (or was extended)
+    COMMIT,       // A writing step or transaction released its orecs
+    ABORT,        // A transaction aborted, or a step unwound (arg: reason_t)
+    ACQUIRE_FAIL, // An orec acquisition failed
+    IRREVOC,      // A transaction became irrevocable
+    SWEEP_BEGIN,  // An SMR sweep started (arg: # objects awaiting reclamation)
+    SWEEP_END,    // An SMR sweep finished (arg: # objects reclaimed)
+    RESIZE_BEGIN, // A hash table resize started
+    RESIZE_END,   // A hash table resize finished
+    VISIBLE,      // A reader made its reads visible
+  };
+
+  /// The reasons for an ABORT event
+  enum reason_t : uint32_t {
+    CONFLICT,   // Unspecified conflict
+    LOCKED,     // An orec was locked by another thread
+    VALIDATION, // An orec was newer than the transaction's start time
+    ACQUIRE,    // An orec could not be acquired at commit time
+    UNWIND,     // The data structure chose to unwind a step
+  };
+
+private:
+  /// One recorded event
+  struct record_t {
+    uint64_t time; // The rdtsc time of the event
+    uint32_t arg;  // An event-specific argument
+    event_t type;  // The kind of event
+  };
+
+  /// The number of events each thread's ring buffer can hold
+  static const uint64_t CAPACITY = 1 << 16;
+
+  /// A thread's ring buffer
+  struct ring_t {
+    record_t records[CAPACITY];  // The events, oldest first (modulo CAPACITY)
+    std::atomic<uint64_t> count; // The number of events ever recorded
+    int tid;                     // The thread's index, for the timeline
+
+    /// Construct an empty ring for thread `tid`
+    ring_t(int tid) : count(0), tid(tid) {}
+  };
+
+  /// The state shared by all threads
+  struct registry_t {
+    using clock_t = std::chrono::steady_clock;
+
+    std::mutex lock;                  // Protects `rings` and `free_rings`
+    std::vector<ring_t *> rings;      // All rings that were ever created
+    std::vector<ring_t *> free_rings; // Rings of threads that have exited
+    uint64_t start_tsc;               // rdtsc when tracing started
+    clock_t::time_point start_clk;    // The wall clock at `start_tsc`
+
+    /// Construct the registry, remember when tracing started, and arrange for
+    /// the trace to be written at exit
+    registry_t()
+        : start_tsc(__rdtsc()), start_clk(clock_t::now()) {
+      std::atexit(dump);
+    }
+  };
+
+  /// Get the registry, constructing it on first use
+  ///
+  /// NB: The registry is never destroyed, since dump() runs during exit
+  static registry_t &registry() {
+    static registry_t *reg = new registry_t();
+    return *reg;
+  }
+
+  /// Get the calling thread's ring.  On first use, take a ring that an exited
+  /// thread gave back, or else create and register a new one.
+  ///
+  /// NB: Once the thread has given its ring back (during thread exit), this
+  ///     returns nullptr, so events recorded by later thread_local destructors
+  ///     are dropped.
+  static ring_t *mine() {
+    static thread_local ring_t *ring = nullptr;
+    static thread_local bool exited = false;
+    if (__builtin_expect(ring == nullptr, 0) && !exited) {
+      /// Give the ring back to the registry when the thread exits
+      struct release_t {
+        ~release_t() {
+          registry_t &reg = registry();
+          std::lock_guard<std::mutex> guard(reg.lock);
+          reg.free_rings.push_back(ring);
+          ring = nullptr;
+          exited = true;
+        }
+      };
+      registry_t &reg = registry();
+      {
+        std::lock_guard<std::mutex> guard(reg.lock);
+        if (!reg.free_rings.empty()) {
+          ring = reg.free_rings.back();
+          reg.free_rings.pop_back();
+        } else {
+          ring = new ring_t(reg.rings.size());
+          reg.rings.push_back(ring);
+        }
+      }
+      static thread_local release_t release;
+      (void)release;
+    }
+    return ring;
+  }
+
+  /// Report the name and Chrome trace phase of an event
+  ///
+  /// @param type  The kind of event
+  /// @param phase A ref param for returning 'B' (begin), 'E' (end), or 'i'
+  ///              (instant)
+  ///
+  /// @return The event's name in the timeline
+  static const char *describe(event_t type, char &phase) {
+    static const char *names[] = {
+        "op",     "op",    "ro_begin",     "wo_begin",
+        "commit", "abort", "acquire_fail", "irrevocable",
+        "sweep",  "sweep", "resize",       "resize",
+        "visible"};
+    switch (type) {
+    case OP_BEGIN:
+    case SWEEP_BEGIN:
+    case RESIZE_BEGIN:
+      phase = 'B';
+      break;
+    case OP_END:
+    case SWEEP_END:
+    case RESIZE_END:
+      phase = 'E';
+      break;
+    default:
+      phase = 'i';
+    }
+    return names[type];
+  }
+
+  /// Write every thread's events to the trace file, as Chrome trace JSON
+  static void dump() {
+    registry_t &reg = registry();
+    std::lock_guard<std::mutex> guard(reg.lock);
+
+    // Convert rdtsc ticks to microseconds, using the elapsed wall-clock time
+    double us = std::chrono::duration<double, std::micro>(
+                    registry_t::clock_t::now() - reg.start_clk)
+                    .count();
+    double ticks_per_us = us > 0 ? (__rdtsc() - reg.start_tsc) / us : 1;
+
+    const char *name = getenv("EXOTM_TRACE_FILE");
+    FILE *f = fopen(name ? name : "exotm_trace.json", "w");
+    if (f == nullptr)
+      return;
+    static const char *reasons[] = {"conflict", "locked", "validation",
+                                    "acquire", "unwind"};
+    fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    bool first = true;
+    for (auto r : reg.rings) {
+      fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+                 "\"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+              first ? "" : ",\n", r->tid, r->tid);
+      first = false;
+      uint64_t count = r->count.load(std::memory_order_acquire);
+      uint64_t begin = count > CAPACITY ? count - CAPACITY : 0;
+      int depth = 0; // Skip 'E' events whose 'B' was overwritten
+      for (uint64_t i = begin; i < count; ++i) {
+        record_t &e = r->records[i % CAPACITY];
+        char phase;
+        const char *ev = describe(e.type, phase);
+        if (phase == 'E' && depth == 0)
+          continue;
+        depth += phase == 'B' ? 1 : phase == 'E' ? -1 : 0;
+        double ts = (double)(int64_t)(e.time - reg.start_tsc) / ticks_per_us;
+        fprintf(f,
+                ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, "
+                "\"pid\": 0, \"tid\": %d",
+                ev, phase, ts, r->tid);
+        if (phase == 'i')
+          fprintf(f, ", \"s\": \"t\"");
+        if (e.type == ABORT)
+          fprintf(f, ", \"args\": {\"reason\": \"%s\"}", reasons[e.arg]);
+        else if (e.arg != 0)
+          fprintf(f, ", \"args\": {\"n\": %u}", e.arg);
+        fprintf(f, "}");
+      }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+  }
+
+public:
+  /// Record an event in the calling thread's ring buffer
+  ///
+  /// @param type The kind of event
+  /// @param arg  An event-specific argument
+  static void record(event_t type, uint32_t arg = 0) {
+    ring_t *r = mine();
+    if (r == nullptr)
+      return;
+    uint64_t n = r->count.load(std::memory_order_relaxed);
+    r->records[n % CAPACITY] = {__rdtsc(), arg, type};
+    r->count.store(n + 1, std::memory_order_release);
+  }
+};
+
+/// EXO_TRACE records an event when tracing is enabled, and does nothing (not
+/// even evaluate its arguments) otherwise.
+#ifdef EXOTM_TRACE
+#define EXO_TRACE(...) tracer_t::record(__VA_ARGS__)
+#else
+#define EXO_TRACE(...)
+#endif
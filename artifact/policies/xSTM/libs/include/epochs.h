@@ -12,6 +12,14 @@
 /// thread is in a transaction, and (b) if any thread is executing with a stale
 /// view of memory.  These properties allow threads to know when certain actions
 /// (like freeing memory) can proceed.
+///
+/// Thread IDs and list entries are never released.  Instead, when a thread
+/// exits, its descriptor (and with it, its ID or list entry) is recycled for
+/// the next thread that starts (see API_TM_DESCRIPTOR).  Thus the range of
+/// IDs, and the length of the list, that quiesce() and tryIrrevoc() must scan
+/// only grows with the peak number of concurrent threads.  Between
+/// transactions, a descriptor's epoch is cleared, so an idle (or recycled)
+/// entry never blocks quiesce() or tryIrrevoc().
 
 #pragma once
 
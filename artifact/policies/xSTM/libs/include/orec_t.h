@@ -47,6 +47,10 @@ public:
     return &orecs[(reinterpret_cast<uintptr_t>(addr) >> COVERAGE) % NUM_ORECS];
   }
 
+  /// Map an orec key (an address that has already been shifted by COVERAGE,
+  /// or a key chosen by an allocator) to an orec table entry
+  orec_t *get_by_key(uintptr_t key) { return &orecs[key % NUM_ORECS]; }
+
   /// Get the current value of the clock
   uintptr_t get_time() { return timestamp.get_time(); }
 
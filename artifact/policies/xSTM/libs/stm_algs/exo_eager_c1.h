@@ -21,7 +21,11 @@
 ///
 /// @param QUIESCE true for quiescence, false if transactions don't quiesce
 /// @param CM      a contention manager, invoked only at begin/commit/abort
-template <bool QUIESCE, class CM> class ExoEagerC1 {
+/// @param ALLOC   an allocation manager, which also maps addresses to orecs
+/// @param WAIT    a lock-wait strategy (see exotm.h).  By default, never wait.
+template <bool QUIESCE, class CM, class ALLOC = BasicAllocationManager,
+          class WAIT = no_lock_wait_t>
+class ExoEagerC1 {
   /// The type of the Epoch table
   ///
   /// NB: There's a very close interaction with the Epoch table.  Since we want
@@ -45,7 +49,7 @@ template <bool QUIESCE, class CM> class ExoEagerC1 {
   OptimizedStackFrameManager frame; // For tracking the transaction's stack
   minivector<int> readset;          // Orecs to validate
   undolog_t undolog;                // An undo log, for undoing writes on abort
-  BasicAllocationManager allocator; // Manage malloc/free/aligned alloc
+  ALLOC allocator;                  // Manage malloc/free/aligned alloc
   DeferredActionHandler defers;     // Functions to run after commit/abort
 
 public:
@@ -125,6 +129,7 @@ public:
           abortTx();
 
       // release locks and exit epoch table
+      exo.commit_begin();
       exo.wo_end();
 
       // CM, then quiesce, then clean up everything, so that we quiesce before
@@ -153,10 +158,10 @@ public:
   /// then we free.
   void txFree(void *addr) { allocator.reclaim(addr); }
 
-  /// Use a simple hash to transform an address into the index of an orec
+  /// Use a simple hash to transform an address's orec key (from the
+  /// allocator) into the index of an orec
   int get_orec_index(void *addr) {
-    return (reinterpret_cast<uintptr_t>(addr) >> OREC_COVERAGE) %
-           globals.NUM_ORECS;
+    return allocator.orecKey(addr) % globals.NUM_ORECS;
   }
 
   /// Transactional read
@@ -179,8 +184,8 @@ public:
         return from_mem;
       }
 
-      // abort if locked
-      if (locked)
+      // abort if locked, unless the owner releases it soon
+      if (locked && !exo.wait_for_release<WAIT>(&globals.orecs[o]))
         abortTx();
 
       // Extend the validity range, then try again
@@ -212,8 +217,8 @@ public:
         return;
       }
 
-      // abort if locked
-      if (locked)
+      // abort if locked, unless the owner releases it soon
+      if (locked && !exo.wait_for_release<WAIT>(&globals.orecs[o]))
         abortTx();
 
       // Extend the validity range, then try again
@@ -233,6 +238,7 @@ public:
     // Get the token and quiesce, or else abort
     if (!epoch.tryIrrevoc(globals.epoch, this))
       abortTx();
+    EXO_TRACE(tracer_t::IRREVOC);
 
     // now validate.  If it fails, release irrevocability
     for (auto o : readset) {
@@ -272,6 +278,7 @@ private:
   /// ensure that the descriptor is in an appropriate state for starting a new
   /// transaction.  Note that we *will* call beginTx again, unlike libITM.
   void abortTx() {
+    EXO_TRACE(tracer_t::ABORT);
     // undo any writes
     undolog.undo_writes();
 
@@ -22,7 +22,11 @@
 ///
 /// @param QUIESCE true for quiescence, false if transactions don't quiesce
 /// @param CM      a contention manager, invoked only at begin/commit/abort
-template <bool QUIESCE, class CM> class ExoLazyC2 {
+/// @param ALLOC   an allocation manager, which also maps addresses to orecs
+/// @param WAIT    a lock-wait strategy (see exotm.h).  By default, never wait.
+template <bool QUIESCE, class CM, class ALLOC = BasicAllocationManager,
+          class WAIT = no_lock_wait_t>
+class ExoLazyC2 {
   /// The type of the Epoch table
   ///
   /// NB: There's a very close interaction with the Epoch table.  Since we want
@@ -49,7 +53,7 @@ template <bool QUIESCE, class CM> class ExoLazyC2 {
   OptimizedStackFrameManager frame; // For tracking the transaction's stack
   minivector<int> readset;          // Orecs to validate
   REDOLOG redolog;                  // A redo log, for redoing writes at commit
-  BasicAllocationManager allocator; // Manage malloc/free/aligned alloc
+  ALLOC allocator;                  // Manage malloc/free/aligned alloc
   DeferredActionHandler defers;     // Functions to run after commit/abort
 
 public:
@@ -134,6 +138,7 @@ public:
           abortTx();
 
       // replay redo log, then release locks and exit epoch table
+      exo.commit_begin();
       redolog.writeback();
       exo.wo_end();
 
@@ -163,10 +168,10 @@ public:
   /// then we free.
   void txFree(void *addr) { allocator.reclaim(addr); }
 
-  /// Use a simple hash to transform an address into the index of an orec
+  /// Use a simple hash to transform an address's orec key (from the
+  /// allocator) into the index of an orec
   int get_orec_index(void *addr) {
-    return (reinterpret_cast<uintptr_t>(addr) >> OREC_COVERAGE) %
-           globals.NUM_ORECS;
+    return allocator.orecKey(addr) % globals.NUM_ORECS;
   }
 
   /// Transactional read
@@ -237,6 +242,7 @@ public:
     // Get the token and quiesce, or else abort
     if (!epoch.tryIrrevoc(globals.epoch, this))
       abortTx();
+    EXO_TRACE(tracer_t::IRREVOC);
 
     // now validate.  If it fails, release irrevocability.
     for (auto o : readset) {
@@ -278,6 +284,7 @@ private:
   /// ensure that the descriptor is in an appropriate state for starting a new
   /// transaction.  Note that we *will* call beginTx again, unlike libITM.
   void abortTx() {
+    EXO_TRACE(tracer_t::ABORT);
     // Exit the Epoch and CM, so other threads don't have to wait on this thread
     exo.unwind();
     cm.afterAbort(globals.cm, 0);
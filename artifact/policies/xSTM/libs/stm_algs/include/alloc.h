@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 
 #include "../../../../include/minivector.h"
+#include "../../include/constants.h"
 
 /// A mechanism that allows a transaction to log its allocations and frees, and
 /// to finalize or undo them if the transaction commits or aborts.  It also
@@ -91,4 +94,256 @@ public:
     uintptr_t a = (uintptr_t)addr;
     return a >= lstart && a < lend;
   }
-};
\ No newline at end of file
+
+  /// Map an address to the key from which its orec is chosen.  Every address
+  /// is mapped by stripes of 2^OREC_COVERAGE bytes.
+  uintptr_t orecKey(void *addr) {
+    return reinterpret_cast<uintptr_t>(addr) >> OREC_COVERAGE;
+  }
+};
+
+/// ObjectHeap is the global part of the ObjectAllocationManager.  It hands out
+/// "chunks" of memory that are dedicated to a single power-of-two size class,
+/// and remembers the size class of each chunk in a registry that never
+/// changes once a chunk is registered.  Since every object in a chunk is
+/// aligned to its size, the start of the object holding any address in a chunk
+/// can be computed from the address alone.
+///
+/// NB: Chunks are never returned to the OS, so that the mapping from an
+///     address to its object never changes while any thread might use it.
+class ObjectHeap {
+public:
+  /// log_2 of the size of a chunk
+  static const int CHUNK_BITS = 20;
+
+  /// The size of a chunk, which is also its alignment
+  static const uintptr_t CHUNK_SIZE = 1UL << CHUNK_BITS;
+
+  /// log_2 of the smallest size class.  It must be at least OREC_COVERAGE, so
+  /// that a redo log granule never spans two objects.
+  static const int MIN_SHIFT = OREC_COVERAGE;
+
+  /// log_2 of the largest size class.  Bigger allocations come from malloc.
+  static const int MAX_SHIFT = 11;
+
+private:
+  /// The number of registry entries.  Chunks whose registry entry is taken by
+  /// another chunk are not used.
+  static const size_t REGISTRY_SIZE = 1 << 16;
+
+  /// The number of chunks newChunk() tries before it gives up
+  static const int NEW_CHUNK_TRIES = 8;
+
+  /// For each chunk, the chunk's address, with its size class in the low bits
+  static inline std::atomic<uintptr_t> registry[REGISTRY_SIZE];
+
+public:
+  /// Report the size class (as log_2 of its size) of the chunk holding `addr`,
+  /// or 0 if `addr` is not in any chunk
+  static int shiftOf(uintptr_t addr) {
+    uintptr_t base = addr & ~(CHUNK_SIZE - 1);
+    uintptr_t e = registry[(base >> CHUNK_BITS) % REGISTRY_SIZE].load(
+        std::memory_order_acquire);
+    return ((e & ~(CHUNK_SIZE - 1)) == base) ? (e & (CHUNK_SIZE - 1)) : 0;
+  }
+
+  /// Create and register a chunk for objects of size 2^shift.  A chunk whose
+  /// registry entry is taken is held until we are done, so that the next
+  /// allocation lands at a different address.
+  ///
+  /// @return The new chunk, or nullptr if no chunk could be registered
+  static char *newChunk(int shift) {
+    void *rejects[NEW_CHUNK_TRIES];
+    int num_rejects = 0;
+    char *res = nullptr;
+    while (num_rejects < NEW_CHUNK_TRIES) {
+      void *mem = aligned_alloc(CHUNK_SIZE, CHUNK_SIZE);
+      if (mem == nullptr)
+        break;
+      uintptr_t base = reinterpret_cast<uintptr_t>(mem), expected = 0;
+      if (registry[(base >> CHUNK_BITS) % REGISTRY_SIZE]
+              .compare_exchange_strong(expected, base | shift)) {
+        res = static_cast<char *>(mem);
+        break;
+      }
+      rejects[num_rejects++] = mem;
+    }
+    for (int i = 0; i < num_rejects; ++i)
+      free(rejects[i]);
+    return res;
+  }
+};
+
+/// An allocation manager that gives each TM_MALLOCed object its own orec.
+/// Small allocations are rounded up to a power of two, and carved out of
+/// ObjectHeap chunks, so that orecKey() can map any address within an object
+/// to the start of that object.  Memory that does not come from the heap
+/// (large objects, globals, memory allocated outside of transactions) falls
+/// back to stripe mapping.  This avoids false conflicts among neighboring
+/// small objects, and it lets a transaction that reads several fields of a
+/// node validate one orec instead of several.
+///
+/// Freed objects are kept in per-thread free lists, which are recycled with
+/// the thread's descriptor.
+///
+/// NB: An object that comes from this manager must be freed with TM_FREE (or
+///     by a transaction), never by a non-transactional call to free().
+class ObjectAllocationManager {
+  /// The number of size classes
+  static const int NUM_CLASSES =
+      ObjectHeap::MAX_SHIFT - ObjectHeap::MIN_SHIFT + 1;
+
+  /// A freed object, which stores the next link of its free list
+  struct free_t {
+    free_t *next;
+  };
+
+  minivector<void *> mallocs; // the transaction's not-yet-committed allocations
+  minivector<void *> frees;   // the transaction's not-yet-committed reclaims
+  bool active = false;        // track if allocation management is active
+  void *lastAlloc = nullptr;  // address of last allocation
+  size_t lastSize = 0;        // size of last allocation
+
+  free_t *freelist[NUM_CLASSES] = {}; // Freed objects, by size class
+  char *bump[NUM_CLASSES] = {};       // Next unused object in current chunk
+  char *bump_end[NUM_CLASSES] = {};   // End of current chunk
+  bool no_chunk[NUM_CLASSES] = {};    // Size classes that ran out of chunks
+
+  uintptr_t cached_chunk = 1; // The chunk of the last orecKey() lookup
+  int cached_shift = 0;       // The size class of cached_chunk (0 == none)
+
+public:
+  /// Indicate that logging should begin.  Since a chunk can be registered at
+  /// an address that was previously outside of the heap, the lookup cache is
+  /// flushed at transaction boundaries.
+  void onBegin() {
+    active = true;
+    cached_chunk = 1;
+  }
+
+  /// When a transaction commits, finalize its mallocs and frees.  Note that
+  /// this should be called *after* privatization is ensured.
+  void onCommit() {
+    mallocs.clear();
+    for (auto a : frees) {
+      release(a);
+    }
+    frees.clear();
+    active = false;
+    lastAlloc = nullptr;
+    lastSize = 0;
+  }
+
+  /// When a transaction aborts, drop its frees and reclaim its mallocs
+  void onAbort() {
+    frees.clear();
+    for (auto p : mallocs) {
+      release(p);
+    }
+    mallocs.clear();
+    active = false;
+    lastAlloc = nullptr;
+    lastSize = 0;
+  }
+
+  /// To allocate memory, we must also log it, so we can reclaim it if the
+  /// transaction aborts
+  void *alloc(size_t size) { return alignAlloc(1, size); }
+
+  /// Allocate memory that is aligned on a byte boundary as specified by A.
+  /// Objects in the heap are aligned to their size, so we just pick a size
+  /// class that is at least A.
+  void *alignAlloc(size_t A, size_t size) {
+    size_t need = size > A ? size : A;
+    int shift = ObjectHeap::MIN_SHIFT;
+    while ((1UL << shift) < need)
+      ++shift;
+    void *res = nullptr;
+    if (shift <= ObjectHeap::MAX_SHIFT)
+      res = take(shift - ObjectHeap::MIN_SHIFT);
+    if (res == nullptr)
+      res = (A > 1) ? aligned_alloc(A, size) : malloc(size);
+    if (active) {
+      mallocs.push_back(res);
+      lastAlloc = res;
+      lastSize = size;
+    }
+    return res;
+  }
+
+  /// To free memory, we simply wait until the transaction has committed, and
+  /// then we free.
+  void reclaim(void *addr) {
+    if (active) {
+      frees.push_back(addr);
+    } else {
+      release(addr);
+    }
+  }
+
+  /// Return true if the given address is within the range returned by the most
+  /// recent allocation
+  bool checkCaptured(void *addr) {
+    uintptr_t lstart = (uintptr_t)lastAlloc;
+    uintptr_t lend = lstart + lastSize;
+    uintptr_t a = (uintptr_t)addr;
+    return a >= lstart && a < lend;
+  }
+
+  /// Map an address to the key from which its orec is chosen.  Addresses in
+  /// the heap map to the start of their object, and all others are mapped by
+  /// stripes.  Both kinds of keys are in units of 2^OREC_COVERAGE bytes.
+  uintptr_t orecKey(void *addr) {
+    uintptr_t a = reinterpret_cast<uintptr_t>(addr);
+    uintptr_t chunk = a & ~(ObjectHeap::CHUNK_SIZE - 1);
+    if (chunk != cached_chunk) {
+      cached_chunk = chunk;
+      cached_shift = ObjectHeap::shiftOf(a);
+    }
+    if (cached_shift == 0)
+      return a >> OREC_COVERAGE;
+    return (a >> cached_shift) << (cached_shift - OREC_COVERAGE);
+  }
+
+private:
+  /// Get an object from the free list or current chunk of a size class.  Once
+  /// a size class fails to get a chunk, it stops trying, so that its later
+  /// allocations go straight to malloc.
+  ///
+  /// @return The object, or nullptr if no chunk could be created
+  void *take(int cls) {
+    if (freelist[cls] != nullptr) {
+      free_t *f = freelist[cls];
+      freelist[cls] = f->next;
+      return f;
+    }
+    size_t size = 1UL << (cls + ObjectHeap::MIN_SHIFT);
+    if (bump[cls] == bump_end[cls]) {
+      if (no_chunk[cls])
+        return nullptr;
+      char *chunk = ObjectHeap::newChunk(cls + ObjectHeap::MIN_SHIFT);
+      if (chunk == nullptr) {
+        no_chunk[cls] = true;
+        return nullptr;
+      }
+      bump[cls] = chunk;
+      bump_end[cls] = chunk + ObjectHeap::CHUNK_SIZE;
+    }
+    void *res = bump[cls];
+    bump[cls] += size;
+    return res;
+  }
+
+  /// Return an object to the free list of its size class, or to the C
+  /// library if it is not in the heap
+  void release(void *addr) {
+    int shift = ObjectHeap::shiftOf(reinterpret_cast<uintptr_t>(addr));
+    if (shift == 0) {
+      free(addr);
+      return;
+    }
+    free_t *f = static_cast<free_t *>(addr);
+    f->next = freelist[shift - ObjectHeap::MIN_SHIFT];
+    freelist[shift - ObjectHeap::MIN_SHIFT] = f;
+  }
+};
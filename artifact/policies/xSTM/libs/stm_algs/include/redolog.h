@@ -22,6 +22,10 @@
 ///     when it is 8, a scalar variable cannot cross an 8-byte boundary, or we
 ///     will not be able to log it correctly.  On SPARC, we'd get a bus error
 ///     anyway.  But on x86, such mis-alignment is possible.
+///
+/// NB: Until the log holds more than LINEAR_LIMIT chunks, lookups scan the
+///     vector, and the index is not touched.  Most transactions never grow
+///     past that, so they never hash, and reset() need not bump the version.
 template <int CHUNKSIZE> class redolog_t {
 
   /// MASK is used to isolate/clear the low bits of an address. It is dependent
@@ -61,6 +65,10 @@ template <int CHUNKSIZE> class redolog_t {
   /// number of static probes before we resize the list
   static const int SPILL_FACTOR = 3;
 
+  /// The largest number of chunks that are found by scanning the vector
+  /// instead of through the index.  Must be less than the initial capacity.
+  static const size_t LINEAR_LIMIT = 8;
+
   /// The "hashtable" of the Redo Log
   index_t *index;
 
@@ -82,6 +90,9 @@ template <int CHUNKSIZE> class redolog_t {
   /// Current # elements in vector
   size_t vector_size;
 
+  /// True once the vector has outgrown LINEAR_LIMIT, and the index covers it
+  bool indexed = false;
+
   /// This hash function is straight from CLRS (that's where the magic constant
   /// comes from).
   size_t hash(uintptr_t const key) const {
@@ -108,8 +119,11 @@ template <int CHUNKSIZE> class redolog_t {
     // double the index size
     delete[] index;
     index = new index_t[doubleIndexLength()];
+    reindex();
+  }
 
-    // rehash the elements
+  /// Add every vector element to the index, which must have no valid entries
+  void reindex() {
     for (size_t i = 0; i < vector_size; ++i) {
       size_t h = hash(redo_vector[i].key);
 
@@ -139,6 +153,15 @@ template <int CHUNKSIZE> class redolog_t {
     version = 1;
   }
 
+  /// Scan the vector for the chunk containing key, or return -1 on failure.
+  /// This is only correct while the log is not indexed.
+  int scan(uintptr_t key) const {
+    for (size_t i = 0; i < vector_size; ++i)
+      if (redo_vector[i].key == key)
+        return i;
+    return -1;
+  }
+
 public:
   /// Construct a RedoLog by providing an initial capacity (default 64)
   redolog_t(const size_t initial_capacity = 64)
@@ -161,6 +184,8 @@ public:
 
   /// Find the vector index of the chunk containing key, or -1 on failure
   int lookup(uintptr_t key) {
+    if (!indexed)
+      return scan(key);
     size_t h = hash(key);
     while (index[h].version == version) {
       if (index[h].address != key) {
@@ -181,6 +206,21 @@ public:
   ///
   /// NB: we expect key's low bits to be masked to zero
   int reserve(uintptr_t key) {
+    // Small logs are searched linearly.  If this is a new chunk that pushes
+    // the log past LINEAR_LIMIT, index everything and continue with the index.
+    if (!indexed) {
+      int idx = scan(key);
+      if (idx != -1)
+        return idx;
+      if (__builtin_expect(vector_size < LINEAR_LIMIT, true)) {
+        redo_vector[vector_size].key = key;
+        redo_vector[vector_size].mask = 0LL;
+        return vector_size++;
+      }
+      reindex();
+      indexed = true;
+    }
+
     //  Find the slot that this address should hash to. If it is valid,
     //  return the index. If we find an unused slot then it's a new
     //  insertion.
@@ -221,6 +261,10 @@ public:
   /// fast-clear the hash by bumping the version number
   void reset() {
     vector_size = 0;
+    // If the index was never built, it has no valid entries to clear
+    if (!indexed)
+      return;
+    indexed = false;
     version += 1;
     // check overflow
     if (version != 0)
@@ -21,7 +21,10 @@
 /// @param ORECTABLE a table of orecs, and a clock
 /// @param EPOCH     an epoch type, for quiescence and irrevocability
 /// @param CM        a contention manager, invoked only at begin/commit/abort
-template <class ORECTABLE, class EPOCH, class CM> class OrecEagerC2 {
+/// @param ALLOC     an allocation manager, which also maps addresses to orecs
+template <class ORECTABLE, class EPOCH, class CM,
+          class ALLOC = BasicAllocationManager>
+class OrecEagerC2 {
   /// All of the global variables used by this STM algorithm
   struct Globals {
     ORECTABLE orecs;               // Orecs and a clock
@@ -39,7 +42,7 @@ template <class ORECTABLE, class EPOCH, class CM> class OrecEagerC2 {
   minivector<orec_t *> readset;     // Orecs to validate
   minivector<orec_t *> lockset;     // Locks that are held
   undolog_t undolog;                // An undo log, for undoing writes on abort
-  BasicAllocationManager allocator; // Manage malloc/free/aligned alloc
+  ALLOC allocator;                  // Manage malloc/free/aligned alloc
   DeferredActionHandler defers;     // Functions to run after commit/abort
 
 public:
@@ -144,6 +147,11 @@ public:
   /// then we free.
   void txFree(void *addr) { allocator.reclaim(addr); }
 
+  /// Find the orec for an address, using the allocator's orec key
+  orec_t *get_orec(void *addr) {
+    return globals.orecs.get_by_key(allocator.orecKey(addr));
+  }
+
   /// Transactional read
   template <typename T> T read(T *addr) {
     // No instrumentation if on stack or we're irrevocable
@@ -151,7 +159,7 @@ public:
       return *addr;
 
     // get the orec address, then start a loop to read a consistent value
-    orec_t *o = globals.orecs.get(addr);
+    orec_t *o = get_orec(addr);
     while (true) {
       // read the orec, then location
       local_orec_t pre, post;
@@ -189,7 +197,7 @@ public:
     }
 
     // get the orec address, then start a loop to ensure a consistent value
-    orec_t *o = globals.orecs.get(addr);
+    orec_t *o = get_orec(addr);
     while (true) {
       // If I have it or can get it, that's the easy case
       local_orec_t pre;
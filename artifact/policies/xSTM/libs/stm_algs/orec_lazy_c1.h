@@ -22,7 +22,10 @@
 /// @param ORECTABLE a table of orecs, and a clock
 /// @param EPOCH     an epoch type, for quiescence and irrevocability
 /// @param CM        a contention manager, invoked only at begin/commit/abort
-template <class ORECTABLE, class EPOCH, class CM> class OrecLazyC1 {
+/// @param ALLOC     an allocation manager, which also maps addresses to orecs
+template <class ORECTABLE, class EPOCH, class CM,
+          class ALLOC = BasicAllocationManager>
+class OrecLazyC1 {
   /// The type of the redo log
   using REDOLOG = redolog_t<1 << OREC_COVERAGE>;
 
@@ -43,7 +46,7 @@ template <class ORECTABLE, class EPOCH, class CM> class OrecLazyC1 {
   minivector<orec_t *> readset;     // Orecs to validate
   minivector<orec_t *> lockset;     // Locks that are held
   REDOLOG redolog;                  // A redo log, for redoing writes at commit
-  BasicAllocationManager allocator; // Manage malloc/free/aligned alloc
+  ALLOC allocator;                  // Manage malloc/free/aligned alloc
   DeferredActionHandler defers;     // Functions to run after commit/abort
 
 public:
@@ -147,6 +150,11 @@ public:
   /// then we free.
   void txFree(void *addr) { allocator.reclaim(addr); }
 
+  /// Find the orec for an address, using the allocator's orec key
+  orec_t *get_orec(void *addr) {
+    return globals.orecs.get_by_key(allocator.orecKey(addr));
+  }
+
   /// Transactional read
   template <typename T> T read(T *addr) {
     // No instrumentation if on stack or we're irrevocable
@@ -163,7 +171,7 @@ public:
       return ret;
 
     // get the orec address, then start a loop to read a consistent value
-    orec_t *o = globals.orecs.get(addr);
+    orec_t *o = get_orec(addr);
     T from_mem;
     while (true) {
       // read the location, then orec
@@ -294,7 +302,7 @@ private:
   void acquireLocks() {
     size_t entries = redolog.size();
     for (size_t i = 0; i < entries; ++i) {
-      orec_t *o = globals.orecs.get(redolog.get_address(i));
+      orec_t *o = get_orec(redolog.get_address(i));
       local_orec_t pre;
       pre.all = o->curr;
 
@@ -20,8 +20,9 @@
 
 typedef ExoEagerC2<true, ExpBackoffCM<BACKOFF_MIN, BACKOFF_MAX>> TxThread;
 
-template <bool Q, class C>
-typename ExoEagerC2<Q, C>::Globals ExoEagerC2<Q, C>::globals;
+template <bool Q, class C, class A, class W>
+typename ExoEagerC2<Q, C, A, W>::Globals
+    ExoEagerC2<Q, C, A, W>::globals;
 
 API_TM_DESCRIPTOR;
 API_TM_MALLOC_FREE;
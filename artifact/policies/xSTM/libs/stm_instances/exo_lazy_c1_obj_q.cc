@@ -0,0 +1,38 @@
+/// An xSTM algorithm instantiation with the following features:
+/// - exotm_ps check-once orecs
+/// - one orec per TM_MALLOCed object, stripes for other memory
+/// - rdtscp clock
+/// - redo logging
+/// - quiescence and irrevocability
+/// - exponential backoff for contention management
+
+#include "../stm_algs/exo_lazy_c1.h"
+
+#include "include/clone.h"
+#include "include/execute.h"
+#include "include/frame.h"
+#include "include/loadstore.h"
+#include "include/mem.h"
+#include "include/stats.h"
+
+#include "../include/cm.h"
+#include "../include/constants.h"
+#include "../include/epochs.h"
+
+typedef ExoLazyC1<true, ExpBackoffCM<BACKOFF_MIN, BACKOFF_MAX>,
+                  ObjectAllocationManager>
+    TxThread;
+
+template <bool Q, class C, class A, class W>
+typename ExoLazyC1<Q, C, A, W>::Globals
+    ExoLazyC1<Q, C, A, W>::globals;
+
+API_TM_DESCRIPTOR;
+API_TM_MALLOC_FREE;
+API_TM_MEMFUNCS_GENERIC;
+API_TM_LOADFUNCS;
+API_TM_STOREFUNCS;
+API_TM_STATS_NOP;
+API_TM_EXECUTE_NOEXCEPT;
+API_TM_CLONES_THREAD_UNSAFE;
+API_TM_STACKFRAME_OPT;
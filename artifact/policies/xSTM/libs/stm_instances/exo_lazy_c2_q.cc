@@ -20,8 +20,9 @@
 
 typedef ExoLazyC2<true, ExpBackoffCM<BACKOFF_MIN, BACKOFF_MAX>> TxThread;
 
-template <bool Q, class C>
-typename ExoLazyC2<Q, C>::Globals ExoLazyC2<Q, C>::globals;
+template <bool Q, class C, class A, class W>
+typename ExoLazyC2<Q, C, A, W>::Globals
+    ExoLazyC2<Q, C, A, W>::globals;
 
 API_TM_DESCRIPTOR;
 API_TM_MALLOC_FREE;
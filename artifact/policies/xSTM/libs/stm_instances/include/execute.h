@@ -4,18 +4,68 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <setjmp.h>
+#include <vector>
 
 #include "../../../common/tm_defines.h"
 
+/// DescriptorPool holds the TxThread descriptors of threads that have exited,
+/// so that new threads can re-use them.  Descriptors are never deleted, because
+/// some epoch managers keep them in lists that other threads traverse without
+/// synchronization.  Re-using them keeps those lists (and the epoch table's
+/// range of IDs) bounded by the peak number of concurrent threads, instead of
+/// growing with every thread that is ever created.
+///
+/// NB: The pool is only touched when a thread creates or destroys its
+///     descriptor, so a lock is sufficient.
+template <class T> class DescriptorPool {
+  std::mutex lock;       // Protects `free`
+  std::vector<T *> free; // Descriptors of exited threads
+
+public:
+  /// Get a descriptor, either from the pool or by creating a new one
+  T *get() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (!free.empty()) {
+        T *t = free.back();
+        free.pop_back();
+        return t;
+      }
+    }
+    return new T();
+  }
+
+  /// Return the descriptor of an exiting thread to the pool.  It must not be in
+  /// a transaction.
+  void put(T *t) {
+    std::lock_guard<std::mutex> guard(lock);
+    free.push_back(t);
+  }
+};
+
 /// Create helper methods that create a thread-local pointer to the TxThread,
-/// and help a caller to get/construct one
+/// and help a caller to get/construct one.  When the thread exits, its TxThread
+/// is returned to a pool for re-use by later threads.
+///
+/// NB: The exit hook is a separate thread_local, constructed only on the slow
+///     path, so that the fast path remains a plain TLS load.
 #define API_TM_DESCRIPTOR                                                      \
   namespace {                                                                  \
   thread_local TxThread *self = nullptr;                                       \
+  DescriptorPool<TxThread> pool;                                               \
+  struct SelfReaper {                                                          \
+    ~SelfReaper() {                                                            \
+      pool.put(self);                                                          \
+      self = nullptr;                                                          \
+    }                                                                          \
+  };                                                                           \
   static TxThread *get_self() {                                                \
     if (__builtin_expect(self == nullptr, false)) {                            \
-      self = new TxThread();                                                   \
+      static thread_local SelfReaper reaper;                                   \
+      (void)reaper;                                                            \
+      self = pool.get();                                                       \
     }                                                                          \
     return self;                                                               \
   }                                                                            \
@@ -25,8 +25,8 @@ typedef OrecEagerC2<OrecTable<NUM_STRIPES, OREC_COVERAGE, CounterTimesource>,
                     ExpBackoffCM<BACKOFF_MIN, BACKOFF_MAX>>
     TxThread;
 
-template <class O, class E, class C>
-typename OrecEagerC2<O, E, C>::Globals OrecEagerC2<O, E, C>::globals;
+template <class O, class E, class C, class A>
+typename OrecEagerC2<O, E, C, A>::Globals OrecEagerC2<O, E, C, A>::globals;
 
 API_TM_DESCRIPTOR;
 API_TM_MALLOC_FREE;
@@ -25,8 +25,8 @@ typedef OrecLazyC2<OrecTable<NUM_STRIPES, OREC_COVERAGE, RdtscpTimesource>,
                    ExpBackoffCM<BACKOFF_MIN, BACKOFF_MAX>>
     TxThread;
 
-template <class O, class E, class C>
-typename OrecLazyC2<O, E, C>::Globals OrecLazyC2<O, E, C>::globals;
+template <class O, class E, class C, class A>
+typename OrecLazyC2<O, E, C, A>::Globals OrecLazyC2<O, E, C, A>::globals;
 
 API_TM_DESCRIPTOR;
 API_TM_MALLOC_FREE;
@@ -5,6 +5,8 @@ STM_NAMES = orec_gv1_eager_c1_q orec_gv1_eager_c2_q \
             orec_gv1_lazy_c1_q  orec_gv1_lazy_c2_q  \
             orec_tsc_lazy_c1_q  orec_tsc_lazy_c2_q  \
             exo_eager_c1_q      exo_eager_c2_q      \
-            exo_lazy_c1_q       exo_lazy_c2_q
+            exo_lazy_c1_q       exo_lazy_c2_q       \
+            orec_gv1_eager_c1_obj_q                 \
+            exo_eager_c1_obj_q  exo_lazy_c1_obj_q
 
 TM_LIB_NAMES = $(STM_NAMES)
@@ -33,18 +33,28 @@ exeNames = {
     # xSTM (NB: there are many more that we don't currently test)
     "xstm_ibst": ExeCfg("xSTM/obj64/ibst_omap.exo_eager_c1_q.exe", "xstm_ibst_ee1q"),
     "xstm_ibst_tiny": ExeCfg("xSTM/obj64/ibst_omap.orec_gv1_eager_c2_q.exe", "xstm_ibst_o1e2"),
+    "xstm_ibst_obj": ExeCfg("xSTM/obj64/ibst_omap.exo_eager_c1_obj_q.exe", "xstm_ibst_ee1oq"),
 
     # handSTM (NB: there are many more that we don't currently test)
     "handstm_ibst": ExeCfg("handSTM/obj64/ibst_omap.eager_c1_po.exe", "handstm_ibst_ee1o"),
     "handstm_slist": ExeCfg("handSTM/obj64/slist_omap.eager_c1_po.exe", "handstm_slist_ee1o"),
     "handstm_caumap": ExeCfg("handSTM/obj64/dlist_caumap.eager_c1_po.exe", "handstm_dcaumap_ee1o"),
     "handstm_carumap": ExeCfg("handSTM/obj64/dlist_carumap.eager_c1_po.exe", "handstm_dcarumap_ee1o"),
+    "handstm_cuckoo": ExeCfg("handSTM/obj64/cuckoo_umap.eager_c1_po.exe", "handstm_cuckoo_ee1o"),
     "handstm_skiplist": ExeCfg("handSTM/obj64/skiplist_omap_bigtx.eager_c1_po.exe", "handstm_skiplist_bigtx_ee1o"),
     "handstm_irbtree": ExeCfg("handSTM/obj64/rbtree_omap.eager_c1_po.exe", "handstm_rbtree_ee1o"),
+    "handstm_irbtree_romap": ExeCfg("handSTM/obj64/rbtree_romap.eager_c1_po.exe", "handstm_rbtree_romap_ee1o"),
+    "handstm_irbtree_churn": ExeCfg("handSTM/obj64/rbtree_omap_churn.eager_c1_po.exe", "handstm_rbtree_churn_ee1o"),
+    "handstm_irbtree_bloom": ExeCfg("handSTM/obj64/rbtree_omap_bloom.eager_c1_po.exe", "handstm_rbtree_bloom_ee1o"),
+    "handstm_irbtree_ost": ExeCfg("handSTM/obj64/rbtree_ost_omap.eager_c1_po.exe", "handstm_rbtree_ost_ee1o"),
 
     # Hybrid
     "hybrid_irbtree": ExeCfg("hybrid/obj64/rbtree_omap_drop.lazy_po.exe", "hybrid_rbtree_lzpo"),
     "hybrid_carumap": ExeCfg("hybrid/obj64/dlist_carumap.lazy_po.exe", "hybrid_carumap_lzpo"),
+    "hybrid_cuckoo": ExeCfg("hybrid/obj64/cuckoo_umap.lazy_po.exe", "hybrid_cuckoo_lzpo"),
+    "hybrid_irbtree_romap": ExeCfg("hybrid/obj64/rbtree_drop_romap.lazy_po.exe", "hybrid_rbtree_romap_lzpo"),
+    "hybrid_irbtree_hc": ExeCfg("hybrid/obj64/rbtree_drop_hc_omap.lazy_po.exe", "hybrid_rbtree_hc_lzpo"),
+    "hybrid_irbtree_ost": ExeCfg("hybrid/obj64/rbtree_ost_omap_drop.lazy_po.exe", "hybrid_rbtree_ost_lzpo"),
 
     # STMCAS (NB: there are many more that we don't currently test)
     "stmcas_ibst": ExeCfg("STMCAS/obj64/ibst_omap.stmcas_po.exe", "stmcas_ibst"),
@@ -58,8 +68,21 @@ exeNames = {
     "stmcas_caumap_noopt": ExeCfg("STMCAS/obj64/dlist_caumap.stmcas_po.exe", "stmcas_dcaumap_noopt"),
     "stmcas_caumap_slist": ExeCfg("STMCAS/obj64/slist_opt_caumap.stmcas_po.exe", "stmcas_dcaumap_noopt"),
     "stmcas_carumap": ExeCfg("STMCAS/obj64/dlist_carumap.stmcas_po.exe", "stmcas_dcarumap"),
+    "stmcas_carumap_fc": ExeCfg("STMCAS/obj64/dlist_carumap_fc.stmcas_po.exe", "stmcas_dcarumap_fc"),
     "stmcas_skiplist_cached": ExeCfg("STMCAS/obj64/skiplist_cached_opt_omap.stmcas_po.exe", "stmcas_skiplist_cached"),
+    "stmcas_skiplist_cached_fc": ExeCfg("STMCAS/obj64/skiplist_cached_opt_omap_fc.stmcas_po.exe", "stmcas_skiplist_cached_fc"),
+    "stmcas_skiplist_cached_hotcache": ExeCfg("STMCAS/obj64/skiplist_cached_opt_omap_hotcache.stmcas_po.exe", "stmcas_skiplist_cached_hotcache"),
+    "stmcas_skiplist_cached_bloom": ExeCfg("STMCAS/obj64/skiplist_cached_opt_omap_bloom.stmcas_po.exe", "stmcas_skiplist_cached_bloom"),
     "stmcas_irbtree_po":ExeCfg("STMCAS/obj64/rbtree_omap.stmcas_po.exe", "stmcas_irbtree_po"),
+    "stmcas_irbtree_hotcache": ExeCfg("STMCAS/obj64/rbtree_omap_hotcache.stmcas_po.exe", "stmcas_irbtree_hotcache"),
+    "stmcas_irbtree_bloom": ExeCfg("STMCAS/obj64/rbtree_omap_bloom.stmcas_po.exe", "stmcas_irbtree_bloom"),
+    "stmcas_irbtree_romap": ExeCfg("STMCAS/obj64/rbtree_romap.stmcas_po.exe", "stmcas_irbtree_romap"),
+    "stmcas_ibst_romap": ExeCfg("STMCAS/obj64/ibst_romap.stmcas_po.exe", "stmcas_ibst_romap"),
+    "stmcas_irbtree_hc": ExeCfg("STMCAS/obj64/rbtree_hc_omap.stmcas_po.exe", "stmcas_irbtree_hc"),
+    "stmcas_ibst_hc": ExeCfg("STMCAS/obj64/ibst_hc_omap.stmcas_po.exe", "stmcas_ibst_hc"),
+    "stmcas_irbtree_churn": ExeCfg("STMCAS/obj64/rbtree_omap_churn.stmcas_po.exe", "stmcas_irbtree_churn"),
+    "stmcas_bplustree": ExeCfg("STMCAS/obj64/bplustree_omap.stmcas_po.exe", "stmcas_bplustree"),
+    "stmcas_art": ExeCfg("STMCAS/obj64/art_omap.stmcas_po.exe", "stmcas_art"),
 }
 
 # Rules for running the trials of an experiment.  We start with a few constants:
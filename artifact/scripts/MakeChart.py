@@ -34,6 +34,8 @@ def makeChart(chart: Types.ChartCfg, dataFolder: str, chartFolder: str, errbar:
     chart_conf['sl_1M'] = [FuncFormatter(formatnum_n[8]), (3,0.5), 4]
     chart_conf['umap_1M_wo'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 3]
     chart_conf['umap_1M'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 3]
+    chart_conf['rumap_1M_wo'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 3]
+    chart_conf['rumap_1M'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 3]
     chart_conf['bst_64K_wo'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 4]
     chart_conf['bst_64K'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 4]
     chart_conf['bst_1M_wo'] = [FuncFormatter(formatnum_n[8]), (4.5,0.5), 4]
@@ -105,6 +105,26 @@ umap_1M = Chart(
 umap_1M_wo = Chart(
     umap_curves, ExpCfg.expConfigs["size1M_r0"], "Threads", "Operations/Second", "umap_1M_wo")
 
+# Curves for the resizable unordered map charts (chaining vs. cuckoo)
+rumap_curves = [
+    Curve(exeNames["stmcas_carumap"], dsRules["umap_default"],
+          lineStyles["yellow"], "STMCAS (resizable)"),
+    Curve(exeNames["hybrid_carumap"], dsRules["umap_default"],
+          lineStyles["cyan"], "hybrid (resizable)"),
+    Curve(exeNames["handstm_carumap"], dsRules["umap_default"],
+          lineStyles["gray"], "handSTM (resizable)"),
+    Curve(exeNames["hybrid_cuckoo"], dsRules["umap_default"],
+          lineStyles["blue"], "hybrid (cuckoo)"),
+    Curve(exeNames["handstm_cuckoo"], dsRules["umap_default"],
+          lineStyles["green"], "handSTM (cuckoo)"),
+]
+
+# The two resizable umap charts (two lookup ratios, one key range)
+rumap_1M = Chart(
+    rumap_curves, ExpCfg.expConfigs["size1M_r80"], "Threads", "Operations/Second", "rumap_1M")
+rumap_1M_wo = Chart(
+    rumap_curves, ExpCfg.expConfigs["size1M_r0"], "Threads", "Operations/Second", "rumap_1M_wo")
+
 # Curves for all bst charts
 bst_curves = [
     Curve(exeNames["base_ebst"], dsRules["bst_default"],
@@ -143,6 +163,14 @@ bbst_curves = [
           lineStyles["yellow"], "hybrid"),
     Curve(exeNames["stmcas_irbtree_po"], dsRules["bst_default"],
           lineStyles["blue"], "STMCAS"),
+    Curve(exeNames["stmcas_irbtree_romap"], dsRules["bst_default"],
+          lineStyles["black"], "STMCAS (sharded)"),
+    Curve(exeNames["stmcas_bplustree"], dsRules["bst_default"],
+          lineStyles["magenta"], "STMCAS (B+-tree)"),
+    Curve(exeNames["stmcas_art"], dsRules["bst_default"],
+          lineStyles["cyan"], "STMCAS (ART)"),
+    Curve(exeNames["hybrid_irbtree_ost"], dsRules["bst_default"],
+          lineStyles["gray"], "hybrid (order-statistic)"),
 ]
 
 # the four bbsts charts (two key ranges, two lookup ratios)
@@ -160,7 +188,7 @@ bbst_1M_wo = Chart(
 all_targets = [
     list_64,  list_64_wo, list_1K, list_1K_wo,
     sl_64K, sl_64K_wo, sl_1M, sl_1M_wo,
-    umap_1M, umap_1M_wo,
+    umap_1M, umap_1M_wo, rumap_1M, rumap_1M_wo,
     bst_64K, bst_64K_wo, bst_1M, bst_1M_wo,
     bbst_64K, bbst_64K_wo, bbst_1M, bbst_1M_wo
 ]
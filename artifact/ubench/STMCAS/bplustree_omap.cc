@@ -0,0 +1,10 @@
+#include "../../ds/STMCAS/bplustree_omap.h"
+#include "../include/experiment.h"
+
+using descriptor = STMCAS_ALG<STMCAS_OREC>; // defined by Makefile
+using map = bplustree_omap<int, int, descriptor, 32>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+STMCAS_GLOBALS_INITIALIZER;
@@ -1,22 +1,36 @@
 # Data structures for the STMCAS work
 DS = dlist_omap                     dlist_opt_omap                   \
      dlist_caumap                   dlist_opt_caumap                 \
-     slist_omap                                                      \
+     slist_omap                     slist_hc_omap                    \
+     dlist_hc_omap                                                   \
      slist_opt_caumap                                                \
-     dlist_carumap                                                   \
-     ibst_omap                                                       \
-     rbtree_omap                                                     \
-     skiplist_cached_opt_omap         
+     dlist_carumap                  dlist_carumap_fc                 \
+     ibst_omap                      ibst_hc_omap                     \
+     rbtree_omap                    rbtree_romap                     \
+     rbtree_hc_omap                 rbtree_omap_churn                \
+     rbtree_omap_hotcache           rbtree_omap_bloom                \
+     ibst_romap                                                      \
+     skiplist_cached_opt_omap       skiplist_cached_opt_omap_fc      \
+     skiplist_cached_opt_omap_hotcache                               \
+     skiplist_cached_opt_omap_bloom                                  \
+     slist_shm_umap                                                  \
+     skiplist_cached_opt_omap_ycsb  rbtree_romap_ycsb                \
+     bplustree_omap                 art_omap
                                     
 
 # STMCAS libraries to evaluate: algorithm and orec policy
 STMCAS_ALG = stmcas
 STMCAS_OREC = po ps
 
+# Data structures to also build with the *_wait_t variant of each algorithm,
+# which waits for lock holders that are committing instead of aborting at once
+WAIT_DS = rbtree_omap
+
 # Get the default build config
 include ../config.mk
 
 # NB: The intention is to build a binary for each combination of $(DS),
 # $(STMCAS_ALG), and $(STMCAS_OREC).
 EXEFILES = $(foreach a, $(STMCAS_ALG), $(foreach o, $(STMCAS_OREC), $(foreach d, $(DS), $(ODIR)/$d.${a}_$o.exe)))
+EXEFILES += $(foreach a, $(STMCAS_ALG), $(foreach o, $(STMCAS_OREC), $(foreach d, $(WAIT_DS), $(ODIR)/$d.${a}_wait_$o.exe)))
 DFILES   = $(patsubst %.exe, %.d, $(EXEFILES))
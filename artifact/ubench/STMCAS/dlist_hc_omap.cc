@@ -0,0 +1,10 @@
+#include "../../ds/STMCAS/dlist_omap.h"
+#include "../include/experiment.h"
+
+using descriptor = STMCAS_ALG<STMCAS_OREC>; // defined by Makefile
+using map = dlist_omap<int, int, descriptor, false, true>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+STMCAS_GLOBALS_INITIALIZER;
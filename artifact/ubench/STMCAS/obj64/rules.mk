@@ -0,0 +1,174 @@
+./obj64/dlist_omap.stmcas_po.exe: dlist_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_omap.stmcas_ps.exe: dlist_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_opt_omap.stmcas_po.exe: dlist_opt_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_opt_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_opt_omap.stmcas_ps.exe: dlist_opt_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_opt_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_caumap.stmcas_po.exe: dlist_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_caumap.stmcas_ps.exe: dlist_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_opt_caumap.stmcas_po.exe: dlist_opt_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_opt_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_opt_caumap.stmcas_ps.exe: dlist_opt_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_opt_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_omap.stmcas_po.exe: slist_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_omap.stmcas_ps.exe: slist_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_hc_omap.stmcas_po.exe: slist_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_hc_omap.stmcas_ps.exe: slist_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_hc_omap.stmcas_po.exe: dlist_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_hc_omap.stmcas_ps.exe: dlist_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_opt_caumap.stmcas_po.exe: slist_opt_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_opt_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_opt_caumap.stmcas_ps.exe: slist_opt_caumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_opt_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_carumap.stmcas_po.exe: dlist_carumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_carumap.stmcas_ps.exe: dlist_carumap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_carumap_fc.stmcas_po.exe: dlist_carumap_fc.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_carumap_fc.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/dlist_carumap_fc.stmcas_ps.exe: dlist_carumap_fc.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" dlist_carumap_fc.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_omap.stmcas_po.exe: ibst_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_omap.stmcas_ps.exe: ibst_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_hc_omap.stmcas_po.exe: ibst_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_hc_omap.stmcas_ps.exe: ibst_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap.stmcas_po.exe: rbtree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap.stmcas_ps.exe: rbtree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_romap.stmcas_po.exe: rbtree_romap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_romap.stmcas_ps.exe: rbtree_romap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_hc_omap.stmcas_po.exe: rbtree_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_hc_omap.stmcas_ps.exe: rbtree_hc_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.stmcas_po.exe: rbtree_omap_churn.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.stmcas_ps.exe: rbtree_omap_churn.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_hotcache.stmcas_po.exe: rbtree_omap_hotcache.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_hotcache.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_hotcache.stmcas_ps.exe: rbtree_omap_hotcache.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_hotcache.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.stmcas_po.exe: rbtree_omap_bloom.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.stmcas_ps.exe: rbtree_omap_bloom.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_romap.stmcas_po.exe: ibst_romap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/ibst_romap.stmcas_ps.exe: ibst_romap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" ibst_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap.stmcas_po.exe: skiplist_cached_opt_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap.stmcas_ps.exe: skiplist_cached_opt_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_fc.stmcas_po.exe: skiplist_cached_opt_omap_fc.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_fc.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_fc.stmcas_ps.exe: skiplist_cached_opt_omap_fc.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_fc.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_hotcache.stmcas_po.exe: skiplist_cached_opt_omap_hotcache.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_hotcache.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_hotcache.stmcas_ps.exe: skiplist_cached_opt_omap_hotcache.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_hotcache.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_bloom.stmcas_po.exe: skiplist_cached_opt_omap_bloom.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_bloom.stmcas_ps.exe: skiplist_cached_opt_omap_bloom.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_shm_umap.stmcas_po.exe: slist_shm_umap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_shm_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/slist_shm_umap.stmcas_ps.exe: slist_shm_umap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" slist_shm_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_ycsb.stmcas_po.exe: skiplist_cached_opt_omap_ycsb.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/skiplist_cached_opt_omap_ycsb.stmcas_ps.exe: skiplist_cached_opt_omap_ycsb.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" skiplist_cached_opt_omap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.stmcas_po.exe: rbtree_romap_ycsb.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.stmcas_ps.exe: rbtree_romap_ycsb.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/bplustree_omap.stmcas_po.exe: bplustree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" bplustree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/bplustree_omap.stmcas_ps.exe: bplustree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" bplustree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/art_omap.stmcas_po.exe: art_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" art_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/art_omap.stmcas_ps.exe: art_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" art_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap.stmcas_wait_po.exe: rbtree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_wait_t -DSTMCAS_OREC=orec_po_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
+./obj64/rbtree_omap.stmcas_wait_ps.exe: rbtree_omap.cc ../../policies/STMCAS/stmcas.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DSTMCAS_ALG=stmcas_wait_t -DSTMCAS_OREC=orec_ps_t -include ../../policies/STMCAS/stmcas.h $(LDFLAGS)
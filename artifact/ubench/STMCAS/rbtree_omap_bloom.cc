@@ -0,0 +1,12 @@
+#include "../../ds/STMCAS/rbtree_omap.h"
+#include "../../ds/include/bloom_front_adapter.h"
+#include "../include/experiment.h"
+
+using descriptor = STMCAS_ALG<STMCAS_OREC>; // defined by Makefile
+using map = bloom_front_adapter_t<int, int, descriptor,
+                                  rbtree_omap<int, int, descriptor>>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+STMCAS_GLOBALS_INITIALIZER;
@@ -0,0 +1,12 @@
+#include "../../ds/STMCAS/rbtree_omap.h"
+#include "../../ds/include/range_omap_adapter.h"
+#include "../include/experiment_ycsb.h"
+
+using descriptor = STMCAS_ALG<STMCAS_OREC>; // defined by Makefile
+using map = range_omap_adapter_t<int, int, descriptor,
+                                 rbtree_omap<int, int, descriptor>>;
+using K2VAL = I2I;
+
+#include "../include/launch_ycsb.h"
+
+STMCAS_GLOBALS_INITIALIZER;
@@ -0,0 +1,10 @@
+#include "../../ds/STMCAS/skiplist_cached_opt_omap.h"
+#include "../include/experiment_ycsb.h"
+
+using descriptor = STMCAS_ALG<STMCAS_OREC>; // defined by Makefile
+using map = skiplist_cached_opt_omap<int, int, descriptor, -1, -1>;
+using K2VAL = I2I;
+
+#include "../include/launch_ycsb.h"
+
+STMCAS_GLOBALS_INITIALIZER;
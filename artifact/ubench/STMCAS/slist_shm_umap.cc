@@ -0,0 +1,11 @@
+#include "../../ds/STMCAS/slist_shm_umap.h"
+#include "../../policies/STMCAS/shm_stmcas.h"
+#include "../include/experiment.h"
+
+// NB: shm_stmcas_t always embeds orecs in objects, so this benchmark ignores
+//     the STMCAS_ALG and STMCAS_OREC settings from the Makefile
+using descriptor = shm_stmcas_t;
+using map = slist_shm_umap<int, int, descriptor>;
+using K2VAL = I2I;
+
+#include "../include/launch_shm.h"
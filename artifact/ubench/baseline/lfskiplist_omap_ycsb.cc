@@ -0,0 +1,11 @@
+#include "../../ds/baseline/lfskiplist_omap.h"
+#include "../../policies/baseline/thread.h"
+#include "../include/experiment_ycsb.h"
+
+using descriptor = thread_t;
+using map = fraser_skiplist<unsigned long, void *, descriptor>;
+using K2VAL = I2V;
+
+#include "../include/launch_ycsb.h"
+
+THREAD_T_GLOBALS_INITIALIZER;
@@ -1,15 +1,22 @@
 # Data structures that we want to test
 DS = slist_omap skiplist_omap_bigtx       \
-     ibst_omap	rbtree_omap dlist_caumap dlist_carumap
+     ibst_omap	rbtree_omap dlist_caumap dlist_carumap rbtree_romap \
+     rbtree_omap_churn rbtree_omap_bloom rbtree_romap_ycsb vacation \
+     cuckoo_umap rbtree_ost_omap
 
 # handSTM libraries to evaluate: algorithm and orec policy
 HANDSTM_ALG  = eager_c1 eager_c2 lazy wb_c1 wb_c2
 HANDSTM_OREC = po ps
 
+# Data structures to also build with the *_wait_t variant of each algorithm,
+# which waits for lock holders that are committing instead of aborting at once
+WAIT_DS = rbtree_omap
+
 # Get the default build config
 include ../config.mk
 
 # NB: The intention is to build a binary for each combination of $(DS),
 #     $(HANDSTM_ALG), and $(HANDSTM_OREC)
 EXEFILES = $(foreach a, $(HANDSTM_ALG), $(foreach o, $(HANDSTM_OREC), $(foreach d, $(DS), $(ODIR)/$d.${a}_$o.exe)))
+EXEFILES += $(foreach a, $(HANDSTM_ALG), $(foreach o, $(HANDSTM_OREC), $(foreach d, $(WAIT_DS), $(ODIR)/$d.${a}_wait_$o.exe)))
 DFILES   = $(patsubst %.exe, %.d, $(EXEFILES))
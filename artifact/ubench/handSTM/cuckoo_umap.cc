@@ -0,0 +1,10 @@
+#include "../../ds/handSTM/cuckoo_umap.h"
+#include "../include/experiment.h"
+
+using descriptor = HANDSTM_ALG<HANDSTM_OREC>; // defined by Makefile
+using map = cuckoo_umap<int, int, descriptor>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+HANDSTM_GLOBALS_INITIALIZER;
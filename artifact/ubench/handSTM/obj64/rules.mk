@@ -0,0 +1,420 @@
+./obj64/slist_omap.eager_c1_po.exe: slist_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/slist_omap.eager_c1_ps.exe: slist_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/slist_omap.eager_c2_po.exe: slist_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/slist_omap.eager_c2_ps.exe: slist_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/slist_omap.lazy_po.exe: slist_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/slist_omap.lazy_ps.exe: slist_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/slist_omap.wb_c1_po.exe: slist_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/slist_omap.wb_c1_ps.exe: slist_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/slist_omap.wb_c2_po.exe: slist_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/slist_omap.wb_c2_ps.exe: slist_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" slist_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.eager_c1_po.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.eager_c1_ps.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.eager_c2_po.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.eager_c2_ps.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.lazy_po.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.lazy_ps.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.wb_c1_po.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.wb_c1_ps.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.wb_c2_po.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/skiplist_omap_bigtx.wb_c2_ps.exe: skiplist_omap_bigtx.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" skiplist_omap_bigtx.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/ibst_omap.eager_c1_po.exe: ibst_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/ibst_omap.eager_c1_ps.exe: ibst_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/ibst_omap.eager_c2_po.exe: ibst_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/ibst_omap.eager_c2_ps.exe: ibst_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/ibst_omap.lazy_po.exe: ibst_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/ibst_omap.lazy_ps.exe: ibst_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/ibst_omap.wb_c1_po.exe: ibst_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/ibst_omap.wb_c1_ps.exe: ibst_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/ibst_omap.wb_c2_po.exe: ibst_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/ibst_omap.wb_c2_ps.exe: ibst_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" ibst_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c1_po.exe: rbtree_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c1_ps.exe: rbtree_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c2_po.exe: rbtree_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c2_ps.exe: rbtree_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.lazy_po.exe: rbtree_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap.lazy_ps.exe: rbtree_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c1_po.exe: rbtree_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c1_ps.exe: rbtree_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c2_po.exe: rbtree_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c2_ps.exe: rbtree_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/dlist_caumap.eager_c1_po.exe: dlist_caumap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/dlist_caumap.eager_c1_ps.exe: dlist_caumap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/dlist_caumap.eager_c2_po.exe: dlist_caumap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/dlist_caumap.eager_c2_ps.exe: dlist_caumap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/dlist_caumap.lazy_po.exe: dlist_caumap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/dlist_caumap.lazy_ps.exe: dlist_caumap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/dlist_caumap.wb_c1_po.exe: dlist_caumap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/dlist_caumap.wb_c1_ps.exe: dlist_caumap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/dlist_caumap.wb_c2_po.exe: dlist_caumap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/dlist_caumap.wb_c2_ps.exe: dlist_caumap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" dlist_caumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.eager_c1_po.exe: dlist_carumap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.eager_c1_ps.exe: dlist_carumap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.eager_c2_po.exe: dlist_carumap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.eager_c2_ps.exe: dlist_carumap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.lazy_po.exe: dlist_carumap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/dlist_carumap.lazy_ps.exe: dlist_carumap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c1_po.exe: dlist_carumap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c1_ps.exe: dlist_carumap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c2_po.exe: dlist_carumap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c2_ps.exe: dlist_carumap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_romap.eager_c1_po.exe: rbtree_romap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_romap.eager_c1_ps.exe: rbtree_romap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_romap.eager_c2_po.exe: rbtree_romap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_romap.eager_c2_ps.exe: rbtree_romap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_romap.lazy_po.exe: rbtree_romap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_romap.lazy_ps.exe: rbtree_romap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_romap.wb_c1_po.exe: rbtree_romap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_romap.wb_c1_ps.exe: rbtree_romap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_romap.wb_c2_po.exe: rbtree_romap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_romap.wb_c2_ps.exe: rbtree_romap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.eager_c1_po.exe: rbtree_omap_churn.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.eager_c1_ps.exe: rbtree_omap_churn.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.eager_c2_po.exe: rbtree_omap_churn.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.eager_c2_ps.exe: rbtree_omap_churn.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.lazy_po.exe: rbtree_omap_churn.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.lazy_ps.exe: rbtree_omap_churn.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.wb_c1_po.exe: rbtree_omap_churn.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.wb_c1_ps.exe: rbtree_omap_churn.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.wb_c2_po.exe: rbtree_omap_churn.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_churn.wb_c2_ps.exe: rbtree_omap_churn.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap_churn.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.eager_c1_po.exe: rbtree_omap_bloom.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.eager_c1_ps.exe: rbtree_omap_bloom.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.eager_c2_po.exe: rbtree_omap_bloom.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.eager_c2_ps.exe: rbtree_omap_bloom.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.lazy_po.exe: rbtree_omap_bloom.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.lazy_ps.exe: rbtree_omap_bloom.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.wb_c1_po.exe: rbtree_omap_bloom.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.wb_c1_ps.exe: rbtree_omap_bloom.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.wb_c2_po.exe: rbtree_omap_bloom.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_bloom.wb_c2_ps.exe: rbtree_omap_bloom.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap_bloom.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.eager_c1_po.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.eager_c1_ps.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.eager_c2_po.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.eager_c2_ps.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.lazy_po.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.lazy_ps.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.wb_c1_po.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.wb_c1_ps.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.wb_c2_po.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_romap_ycsb.wb_c2_ps.exe: rbtree_romap_ycsb.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/vacation.eager_c1_po.exe: vacation.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/vacation.eager_c1_ps.exe: vacation.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/vacation.eager_c2_po.exe: vacation.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/vacation.eager_c2_ps.exe: vacation.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/vacation.lazy_po.exe: vacation.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/vacation.lazy_ps.exe: vacation.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/vacation.wb_c1_po.exe: vacation.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/vacation.wb_c1_ps.exe: vacation.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/vacation.wb_c2_po.exe: vacation.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/vacation.wb_c2_ps.exe: vacation.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" vacation.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.eager_c1_po.exe: cuckoo_umap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.eager_c1_ps.exe: cuckoo_umap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.eager_c2_po.exe: cuckoo_umap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.eager_c2_ps.exe: cuckoo_umap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.lazy_po.exe: cuckoo_umap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/cuckoo_umap.lazy_ps.exe: cuckoo_umap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c1_po.exe: cuckoo_umap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c1_ps.exe: cuckoo_umap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c2_po.exe: cuckoo_umap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c2_ps.exe: cuckoo_umap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.eager_c1_po.exe: rbtree_ost_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.eager_c1_ps.exe: rbtree_ost_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.eager_c2_po.exe: rbtree_ost_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.eager_c2_ps.exe: rbtree_ost_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.lazy_po.exe: rbtree_ost_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.lazy_ps.exe: rbtree_ost_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.wb_c1_po.exe: rbtree_ost_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.wb_c1_ps.exe: rbtree_ost_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.wb_c2_po.exe: rbtree_ost_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap.wb_c2_ps.exe: rbtree_ost_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_ost_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c1_wait_po.exe: rbtree_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_wait_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c1_wait_ps.exe: rbtree_omap.cc ../../policies/handSTM/eager_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c1_wait_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c2_wait_po.exe: rbtree_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_wait_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.eager_c2_wait_ps.exe: rbtree_omap.cc ../../policies/handSTM/eager_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=eager_c2_wait_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/eager_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.lazy_wait_po.exe: rbtree_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_wait_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap.lazy_wait_ps.exe: rbtree_omap.cc ../../policies/handSTM/lazy.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=lazy_wait_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c1_wait_po.exe: rbtree_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_wait_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c1_wait_ps.exe: rbtree_omap.cc ../../policies/handSTM/wb_c1.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c1_wait_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c2_wait_po.exe: rbtree_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_wait_t -DHANDSTM_OREC=orec_po_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap.wb_c2_wait_ps.exe: rbtree_omap.cc ../../policies/handSTM/wb_c2.h
+	@echo "[CXX]" rbtree_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHANDSTM_ALG=wb_c2_wait_t -DHANDSTM_OREC=orec_ps_t -include ../../policies/handSTM/wb_c2.h $(LDFLAGS)
@@ -0,0 +1,12 @@
+#include "../../ds/handSTM/rbtree_omap.h"
+#include "../../ds/include/bloom_front_adapter.h"
+#include "../include/experiment.h"
+
+using descriptor = HANDSTM_ALG<HANDSTM_OREC>; // defined by Makefile
+using map = bloom_front_adapter_t<int, int, descriptor,
+                                  rbtree_omap<int, int, descriptor, -1, -1>>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+HANDSTM_GLOBALS_INITIALIZER;
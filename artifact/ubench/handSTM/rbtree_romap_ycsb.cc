@@ -0,0 +1,12 @@
+#include "../../ds/handSTM/rbtree_omap.h"
+#include "../../ds/include/range_omap_adapter.h"
+#include "../include/experiment_ycsb.h"
+
+using descriptor = HANDSTM_ALG<HANDSTM_OREC>; // defined by Makefile
+using map = range_omap_adapter_t<int, int, descriptor,
+                                 rbtree_omap<int, int, descriptor, -1, -1>>;
+using K2VAL = I2I;
+
+#include "../include/launch_ycsb.h"
+
+HANDSTM_GLOBALS_INITIALIZER;
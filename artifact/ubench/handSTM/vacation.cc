@@ -0,0 +1,9 @@
+#include "../../ds/handSTM/vacation.h"
+#include "../include/experiment_vacation.h"
+
+using descriptor = HANDSTM_ALG<HANDSTM_OREC>; // defined by Makefile
+using app = vacation_t<descriptor>;
+
+#include "../include/launch_vacation.h"
+
+HANDSTM_GLOBALS_INITIALIZER;
@@ -1,14 +1,20 @@
 # Data structures that we want to test
-DS = rbtree_omap_drop dlist_carumap
+DS = rbtree_omap_drop dlist_carumap rbtree_drop_romap rbtree_drop_hc_omap \
+     rbtree_drop_romap_ycsb cuckoo_umap rbtree_ost_omap_drop
 
 # HYBRID libraries to evaluate: algorithm and orec policy
 HYBRID_ALG  = lazy wb_c1 wb_c2
 HYBRID_OREC = po ps
 
+# Data structures to also build with the *_wait_t variant of each algorithm,
+# which waits for lock holders that are committing instead of aborting at once
+WAIT_DS = rbtree_omap_drop
+
 # Get the default build config
 include ../config.mk
 
 # NB: The intention is to build a binary for each combination of $(DS),
 # $(HYBRID_ALG), and $(HYBRID_OREC)
 EXEFILES = $(foreach a, $(HYBRID_ALG), $(foreach o, $(HYBRID_OREC), $(foreach d, $(DS), $(ODIR)/$d.${a}_$o.exe)))
+EXEFILES += $(foreach a, $(HYBRID_ALG), $(foreach o, $(HYBRID_OREC), $(foreach d, $(WAIT_DS), $(ODIR)/$d.${a}_wait_$o.exe)))
 DFILES   = $(patsubst %.exe, %.d, $(EXEFILES))
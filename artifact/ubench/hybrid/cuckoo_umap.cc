@@ -0,0 +1,10 @@
+#include "../../ds/hybrid/cuckoo_umap.h"
+#include "../include/experiment.h"
+
+using descriptor = HYBRID_ALG<HYBRID_OREC>; // defined by Makefile
+using map = cuckoo_umap<int, int, descriptor>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+HYBRID_GLOBALS_INITIALIZER;
@@ -0,0 +1,144 @@
+./obj64/rbtree_omap_drop.lazy_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.lazy_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c1_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c1_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c2_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c2_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.lazy_po.exe: dlist_carumap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/dlist_carumap.lazy_ps.exe: dlist_carumap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c1_po.exe: dlist_carumap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c1_ps.exe: dlist_carumap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c2_po.exe: dlist_carumap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/dlist_carumap.wb_c2_ps.exe: dlist_carumap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" dlist_carumap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.lazy_po.exe: rbtree_drop_romap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.lazy_ps.exe: rbtree_drop_romap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.wb_c1_po.exe: rbtree_drop_romap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.wb_c1_ps.exe: rbtree_drop_romap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.wb_c2_po.exe: rbtree_drop_romap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_romap.wb_c2_ps.exe: rbtree_drop_romap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_romap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.lazy_po.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.lazy_ps.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.wb_c1_po.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.wb_c1_ps.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.wb_c2_po.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_hc_omap.wb_c2_ps.exe: rbtree_drop_hc_omap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_hc_omap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.lazy_po.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.lazy_ps.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.wb_c1_po.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.wb_c1_ps.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.wb_c2_po.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_drop_romap_ycsb.wb_c2_ps.exe: rbtree_drop_romap_ycsb.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_drop_romap_ycsb.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.lazy_po.exe: cuckoo_umap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/cuckoo_umap.lazy_ps.exe: cuckoo_umap.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c1_po.exe: cuckoo_umap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c1_ps.exe: cuckoo_umap.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c2_po.exe: cuckoo_umap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/cuckoo_umap.wb_c2_ps.exe: cuckoo_umap.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" cuckoo_umap.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.lazy_po.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.lazy_ps.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.wb_c1_po.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.wb_c1_ps.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.wb_c2_po.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_ost_omap_drop.wb_c2_ps.exe: rbtree_ost_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_ost_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.lazy_wait_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_wait_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.lazy_wait_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/lazy.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=lazy_wait_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/lazy.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c1_wait_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_wait_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c1_wait_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c1.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c1_wait_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c1.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c2_wait_po.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_wait_t -DHYBRID_OREC=orec_po_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
+./obj64/rbtree_omap_drop.wb_c2_wait_ps.exe: rbtree_omap_drop.cc ../../policies/hybrid/wb_c2.h
+	@echo "[CXX]" rbtree_omap_drop.cc --\> $@
+	@$(CXX) $< -o $@ $(CXXFLAGS) -DHYBRID_ALG=wb_c2_wait_t -DHYBRID_OREC=orec_ps_t -include ../../policies/hybrid/wb_c2.h $(LDFLAGS)
@@ -0,0 +1,13 @@
+#include "../../ds/hybrid/rbtree_omap_drop.h"
+#include "../../ds/include/range_omap_adapter.h"
+#include "../include/experiment.h"
+
+using descriptor = HYBRID_ALG<HYBRID_OREC>; // defined by Makefile
+using map =
+    range_omap_adapter_t<int, int, descriptor,
+                         rbtree_omap_drop<int, int, descriptor, -1, -1>>;
+using K2VAL = I2I;
+
+#include "../include/launch.h"
+
+HYBRID_GLOBALS_INITIALIZER;
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <random>
 
 /// bench_thread_context_t has per-thread counters for the six intset benchmark
-/// events.  It also has a per-thread pseudorandom number generator.
+/// events.  It also has a per-thread pseudorandom number generator, and the
+/// thread's id.
 class bench_thread_context_t {
   /// A large prime.  Use to seed Mersenne Twister because similar seeds lead to
   /// similar sequences
@@ -22,11 +24,20 @@ public:
     RNG_T,
     RNG_F,
     TX_T,
+    ABORT,
     NUM
-  };                            // event types
-  std::mt19937 mt;              // Per-thread PRNG
-  int stats[EVENTS::NUM] = {0}; // Event counters
+  };                                 // event types
+  std::mt19937 mt;                   // Per-thread PRNG
+  uint64_t stats[EVENTS::NUM] = {0}; // Event counters
+  uint64_t longest = 0;              // Cycles taken by the slowest operation
+  const int id;                      // The thread's id
 
   /// Construct a thread's context by creating its PRNG
-  bench_thread_context_t(int _id) : mt(_id * LARGE_PRIME) {}
+  bench_thread_context_t(int _id) : mt(_id * LARGE_PRIME), id(_id) {}
+
+  /// Get a count of the number of operations this thread completed
+  uint64_t count_operations() const {
+    return stats[GET_T] + stats[GET_F] + stats[INS_T] + stats[INS_F] +
+           stats[RMV_T] + stats[RMV_F] + stats[MOD_T] + stats[MOD_F];
+  }
 };
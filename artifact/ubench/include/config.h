@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cctype>
 #include <iostream>
 #include <libgen.h>
 #include <unistd.h>
 
+#include "../../ds/include/multi_key.h"
+
 /// config_t encapsulates all of the configuration behaviors that we require of
 /// our benchmarks.  It standardizes the format of command-line arguments,
 /// parsing of command-line arguments, and reporting of command-line arguments.
@@ -32,13 +35,26 @@ struct config_t {
   bool quiet = false;        // Skip all output except the throughput?
   size_t bulk = 1;           // maxium number of opeartions in one transaction
   size_t orec_size = 65536;
+  size_t shards = 16;        // # shards for range-partitioned ordered maps
+  size_t lifetime = 1024;    // # ops per thread, for thread churn benchmarks
+  bool fairness = false;     // Report per-thread (fairness) statistics?
+  bool huge_pages = false;   // Back hash table bucket arrays with huge pages?
+  bool disjoint = false;     // Give each thread its own partition of keys?
+  size_t cross = 0;          // % of disjoint-mode ops that use any partition
+  size_t multi_keys = 0;     // # keys per multi-key update (0 to disable)
+  char workload = 'A';       // YCSB core workload (A-F), for YCSB benchmarks
+  size_t field_count = 10;   // # fields per YCSB record
+  size_t field_length = 100; // # bytes per YCSB field
+  size_t scan_length = 100;  // Max # records per YCSB scan
+  size_t order_stats = 0;    // % of lookups that are order-statistic queries
   /// Initialize the program's configuration by setting the strings that are not
   /// dependent on the command-line
   config_t() {}
   config_t(int argc, char **argv) : program_name(basename(argv[0])) {
     long opt;
-    while ((opt = getopt(argc, argv, "b:c:hi:l:k:or:s:t:vxB:QT:m:I:K:")) !=
-           -1) {
+    while ((opt = getopt(argc, argv,
+                         "b:c:hi:l:k:or:s:t:vxB:QT:m:I:K:S:L:FHDX:M:"
+                         "W:f:z:N:R:")) != -1) {
       switch (opt) {
       case 'b':
         buckets = atoi(optarg);
@@ -94,6 +110,44 @@ struct config_t {
       case 'K':
         bulk = atoi(optarg);
         break;
+      case 'S':
+        shards = atoi(optarg);
+        break;
+      case 'L':
+        lifetime = atoi(optarg);
+        break;
+      case 'F':
+        fairness = !fairness;
+        break;
+      case 'H':
+        huge_pages = !huge_pages;
+        break;
+      case 'D':
+        disjoint = !disjoint;
+        break;
+      case 'X':
+        cross = atoi(optarg);
+        break;
+      case 'M':
+        multi_keys = atoi(optarg);
+        if (multi_keys > MK_MAX_KEYS)
+          throw "-M must be at most " + std::to_string(MK_MAX_KEYS);
+        break;
+      case 'W':
+        workload = toupper(optarg[0]);
+        break;
+      case 'f':
+        field_count = atoi(optarg);
+        break;
+      case 'z':
+        field_length = atoi(optarg);
+        break;
+      case 'N':
+        scan_length = atoi(optarg);
+        break;
+      case 'R':
+        order_stats = atoi(optarg);
+        break;
       default:
         throw "Invalid configuration flag " + std::to_string(opt);
       }
@@ -121,18 +175,35 @@ struct config_t {
         << "  -Q: quiet mode                      (default false)\n"
         << "  -T: #warm-up threads                (default 1)\n"
         << "  -I: (index) chunk size              (default 8)\n"
-        << "  -K: number of #ops per transaction  (default 1)\n";
+        << "  -K: number of #ops per transaction  (default 1)\n"
+        << "  -S: # shards                        (default 16)\n"
+        << "  -L: # ops per thread, for churn     (default 1024)\n"
+        << "  -F: toggle per-thread statistics    (default false)\n"
+        << "  -H: toggle huge-page bucket arrays  (default false)\n"
+        << "  -D: toggle disjoint key partitions  (default false)\n"
+        << "  -X: % cross-partition ops, with -D  (default 0)\n"
+        << "  -M: # keys per multi-key update     (default 0 <off>)\n"
+        << "  -W: YCSB workload (A-F)             (default A)\n"
+        << "  -f: # fields per YCSB record        (default 10)\n"
+        << "  -z: bytes per YCSB field            (default 100)\n"
+        << "  -N: max records per YCSB scan       (default 100)\n"
+        << "  -R: % order-statistic lookups       (default 0)\n";
   }
 
   /// Report the current values of the configuration object as a CSV line
   void report() {
     if (quiet)
       return;
-    std::cout << program_name << ", (bcikrtxBoslmTIK), " << buckets << ", "
-              << chunksize << ", " << interval << ", " << key_range << ", "
-              << lookup << ", " << nthreads << ", " << timed_mode << ", "
-              << resize_threshold << ", " << prefill_rand << ", "
+    std::cout << program_name << ", (bcikrtxBoslmTIKSLFHDXMWfzNR), " << buckets
+              << ", " << chunksize << ", " << interval << ", " << key_range
+              << ", " << lookup << ", " << nthreads << ", " << timed_mode
+              << ", " << resize_threshold << ", " << prefill_rand << ", "
               << snapshot_freq << ", " << max_levels << ", " << merge_threshold
-              << ", " << wthreads << ", " << iChunksize << ", " << bulk << ", ";
+              << ", " << wthreads << ", " << iChunksize << ", " << bulk << ", "
+              << shards << ", " << lifetime << ", " << fairness << ", "
+              << huge_pages << ", " << disjoint << ", " << cross << ", "
+              << multi_keys << ", " << workload << ", " << field_count << ", "
+              << field_length << ", " << scan_length << ", " << order_stats
+              << ", ";
   }
 };
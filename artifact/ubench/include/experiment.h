@@ -2,10 +2,15 @@
 
 #include <algorithm> // For std::shuffle
 #include <iostream>
+#include <new>
 #include <random> // For std::mt19937
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
+#include <x86intrin.h>
 
+#include "../../ds/include/multi_key.h"
 #include "bench_thread_context.h"
 #include "config.h"
 #include "manager.h"
@@ -79,6 +84,179 @@ void fill_even(SET *set, config_t *cfg) {
     threads[i].join();
   }
 }
+/// Perform one multi-key update on a map, as if it were a set.  The first half of
+/// the keys are removed and the rest are inserted, so that the update resembles
+/// moving elements from one place to another.  `key` is the first key, and the
+/// others are chosen uniformly from the whole key range.
+///
+/// @param SET            The type of the set to operate on
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int keys to whatever value SET uses
+///
+/// @param set  The set on which to operate
+/// @param me   The operation descriptor of the calling thread
+/// @param self The benchmark context of the calling thread
+/// @param cfg  The configuration object
+/// @param key  The first key of the update
+///
+/// @return True if the update was applied, false if some precondition failed
+template <class SET, class THREAD_CONTEXT, typename K2V>
+bool intmap_multi_op(SET *set, THREAD_CONTEXT *me, bench_thread_context_t &self,
+                     config_t *cfg, int key) {
+  using mk_t = mk_op_t<int, decltype(K2V::convert(key))>;
+  if constexpr (requires(mk_t *ops) { set->multi_update(me, ops, 1); }) {
+    std::uniform_int_distribution<size_t> key_dist(0, cfg->key_range - 1);
+    int num = std::min(cfg->multi_keys, cfg->key_range);
+    mk_t ops[MK_MAX_KEYS]; // NB: config_t checks that num <= MK_MAX_KEYS
+    for (int i = 0; i < num; ++i) {
+      // The keys must be distinct
+      for (int j = 0; j < i; ++j) {
+        if (ops[j].key == key) {
+          key = key_dist(self.mt);
+          j = -1;
+        }
+      }
+      ops[i].kind = i < num / 2 ? mk_t::REMOVE : mk_t::INSERT;
+      ops[i].key = key;
+      ops[i].val = K2V::convert(key);
+      key = key_dist(self.mt);
+    }
+    return set->multi_update(me, ops, num);
+  } else {
+    std::cerr << "Error: -M requires a map with multi_update()\n";
+    exit(-1);
+  }
+}
+
+/// Perform one order-statistic query on a map, as if it were a set.  The query
+/// is chosen uniformly from `rank(key)`, `select(key / 2)` (since the map is
+/// prefilled with every other key), and `count()` over the `cfg->scan_length`
+/// keys starting at `key`.
+///
+/// @param SET            The type of the set to operate on
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int keys to whatever value SET uses
+///
+/// @param set  The set on which to operate
+/// @param me   The operation descriptor of the calling thread
+/// @param self The benchmark context of the calling thread
+/// @param cfg  The configuration object
+/// @param key  The key of the query
+///
+/// @return True if the query found at least one key, false otherwise
+template <class SET, class THREAD_CONTEXT, typename K2V>
+bool intmap_order_op(SET *set, THREAD_CONTEXT *me,
+                     bench_thread_context_t &self, config_t *cfg, int key) {
+  if constexpr (requires(uint64_t i, int k, decltype(K2V::convert(0)) v) {
+                  set->rank(me, k);
+                  set->select(me, i, k, v);
+                  set->count(me, k, k);
+                }) {
+    switch (self.mt() % 3) {
+    case 0:
+      return set->rank(me, key) > 0;
+    case 1: {
+      int k;
+      auto v = K2V::convert(key);
+      return set->select(me, key / 2, k, v);
+    }
+    default:
+      return set->count(me, key, key + (int)cfg->scan_length - 1) > 0;
+    }
+  } else {
+    std::cerr << "Error: -R requires a map with rank(), select() and count()\n";
+    exit(-1);
+  }
+}
+
+/// Perform one random get, insert, or remove on a map, as if it were a set, and
+/// count the outcome in the calling thread's stats.
+///
+/// In disjoint mode, the key range is split into one contiguous partition per
+/// thread, and each thread only uses keys from its own partition, except for
+/// `cfg->cross` percent of operations, which use keys from the whole range.
+/// With no cross-partition operations, threads never conflict on data, so any
+/// loss of scalability is due to false conflicts and shared metadata.
+///
+/// `cfg->order_stats` percent of lookups are order-statistic queries instead,
+/// which are counted as lookups.
+///
+/// @param SET            The type of the set to operate on
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int keys to whatever value SET uses
+///
+/// @param set  The set on which to operate
+/// @param me   The operation descriptor of the calling thread
+/// @param self The benchmark context of the calling thread
+/// @param cfg  The configuration object
+template <class SET, class THREAD_CONTEXT, typename K2V>
+void intmap_op(SET *set, THREAD_CONTEXT *me, bench_thread_context_t &self,
+               config_t *cfg) {
+  using event_types = bench_thread_context_t::EVENTS;
+  using std::uniform_int_distribution;
+  uniform_int_distribution<size_t> key_dist(0, cfg->key_range - 1);
+  uniform_int_distribution<size_t> action_dist(0, 100);
+
+  // Generate a random key and action for the transaction
+  int key;
+  size_t action;
+  key = key_dist(self.mt) % cfg->key_range;
+  action = action_dist(self.mt);
+  if (cfg->disjoint && action_dist(self.mt) % 100 >= cfg->cross) {
+    size_t part = std::max<size_t>(1, cfg->key_range / cfg->nthreads);
+    key = self.id * part + key % part;
+  }
+
+  // Split non-lookups evenly between insert and remove
+  size_t insert = (100 - cfg->lookup) / 2;
+
+  // Each operation is protected by safe reclamation
+  me->op_begin();
+  if (action > cfg->lookup && cfg->multi_keys > 0) {
+    if (intmap_multi_op<SET, THREAD_CONTEXT, K2V>(set, me, self, cfg, key))
+      ++self.stats[event_types::MOD_T];
+    else
+      ++self.stats[event_types::MOD_F];
+  } else if (action <= cfg->lookup && cfg->order_stats > 0 &&
+             action_dist(self.mt) % 100 < cfg->order_stats) {
+    if (intmap_order_op<SET, THREAD_CONTEXT, K2V>(set, me, self, cfg, key))
+      ++self.stats[event_types::GET_T];
+    else
+      ++self.stats[event_types::GET_F];
+  } else if (action <= cfg->lookup) {
+    auto val = K2V::convert(key);
+    if (set->get(me, key, val))
+      ++self.stats[event_types::GET_T];
+    else
+      ++self.stats[event_types::GET_F];
+  } else if (action < cfg->lookup + insert) {
+    auto val = K2V::convert(key);
+    if (set->insert(me, key, val))
+      ++self.stats[event_types::INS_T];
+    else
+      ++self.stats[event_types::INS_F];
+  } else {
+    if (set->remove(me, key))
+      ++self.stats[event_types::RMV_T];
+    else
+      ++self.stats[event_types::RMV_F];
+  }
+  me->op_end();
+}
+
+/// Report how many times a thread's descriptor has aborted, if its policy
+/// counts aborts
+///
+/// @param me The operation descriptor of the calling thread
+///
+/// @return The number of aborts, or 0 if the policy does not count them
+template <class THREAD_CONTEXT> uint64_t count_aborts(THREAD_CONTEXT *me) {
+  if constexpr (requires { me->get_aborts(); })
+    return me->get_aborts();
+  else
+    return 0;
+}
+
 /// Run integer set tests on map data structures as if they were sets.  This
 /// requires set_t to have insert, lookup, and remove operations.
 ///
@@ -92,7 +270,6 @@ template <class SET, class THREAD_CONTEXT, typename K2V>
 void intmap_test(SET *set, config_t *cfg) {
   using namespace std;
   using namespace std::chrono;
-  using event_types = bench_thread_context_t::EVENTS;
 
   // A manager for coordinating threads and collecting stats
   experiment_manager_t exp;
@@ -103,65 +280,28 @@ void intmap_test(SET *set, config_t *cfg) {
     bench_thread_context_t self(id);
     auto me = new THREAD_CONTEXT();
 
-    // set up a PRNG for the thread
-    using std::uniform_int_distribution;
-    uniform_int_distribution<size_t> key_dist(0, cfg->key_range - 1);
-    uniform_int_distribution<size_t> action_dist(0, 100);
-
     // A lambda that does one random operation
     auto tx = [&]() {
-      // Generate a random key and action for the transaction
-      int key;
-      size_t action;
-      key = key_dist(self.mt) % cfg->key_range;
-      action = action_dist(self.mt);
-
-      // Split non-lookups evenly between insert and remove
-      size_t insert = (100 - cfg->lookup) / 2;
-
-      // Each operation is protected by safe reclamation
-      me->op_begin();
-      if (action <= cfg->lookup) {
-        auto val = K2V::convert(key);
-        if (set->get(me, key, val))
-          ++self.stats[event_types::GET_T];
-        else
-          ++self.stats[event_types::GET_F];
-      } else if (action < cfg->lookup + insert) {
-        auto val = K2V::convert(key);
-        if (set->insert(me, key, val))
-          ++self.stats[event_types::INS_T];
-        else
-          ++self.stats[event_types::INS_F];
-      } else {
-        if (set->remove(me, key))
-          ++self.stats[event_types::RMV_T];
-        else
-          ++self.stats[event_types::RMV_F];
-      }
-      me->op_end();
+      intmap_op<SET, THREAD_CONTEXT, K2V>(set, me, self, cfg);
     };
 
     // Synchronize threads and get time
     exp.sync_before_launch(id, cfg);
 
     // Run the experiment
-    if (cfg->timed_mode)
-      while (exp.running.load())
-        tx();
-    else
-      for (size_t i = 0; i < cfg->interval; ++i)
-        tx();
+    exp.run_ops(cfg, self, tx);
+    self.stats[bench_thread_context_t::ABORT] = count_aborts(me);
+    exp.merge_phases();
 
     // arrive at the last barrier, then get the timer again
     exp.sync_after_launch(id, cfg);
 
     // merge stats into global
-    for (size_t i = 0; i < event_types::NUM; ++i)
-      exp.stats[i].fetch_add(self.stats[i]);
+    exp.merge_stats(id, self);
   };
 
   // Launch the threads... this thread won't run the tests
+  exp.track_threads(cfg->nthreads);
   vector<thread> threads;
   for (size_t i = 0; i < cfg->nthreads; i++)
     threads.emplace_back(task, i);
@@ -171,3 +311,185 @@ void intmap_test(SET *set, config_t *cfg) {
   // Report statistics from the experiment
   exp.report(cfg);
 }
+
+/// Run integer set tests while continuously creating and destroying threads.
+/// There are `cfg->nthreads` worker slots.  Each slot runs a sequence of
+/// short-lived threads, one at a time, each of which constructs a fresh
+/// THREAD_CONTEXT, performs `cfg->lifetime` random operations, destroys its
+/// context, and exits.  This exposes any per-thread state that a
+/// synchronization policy fails to release when a thread goes away.
+///
+/// In addition to throughput, this reports the number of threads created, and
+/// the mean latency (in cycles) of operations run by the first and by the last
+/// thread of each slot.  If per-thread state leaks, the latter will be larger.
+///
+/// @param SET            The type of the set to populate
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int keys to whatever value SET uses
+///
+/// @param set The set into which the inserts should happen
+/// @param cfg The configuration object
+template <class SET, class THREAD_CONTEXT, typename K2V>
+void churn_test(SET *set, config_t *cfg) {
+  using namespace std;
+
+  // A manager for coordinating threads and collecting stats
+  experiment_manager_t exp;
+
+  // Churn statistics: threads created, and cycles/ops of the first and last
+  // generation of threads in each slot
+  atomic<uint64_t> spawned(0);
+  atomic<uint64_t> first_cycles(0), first_ops(0), last_cycles(0), last_ops(0);
+
+  // This is the task that each slot will perform
+  auto task = [&](int id) {
+    // The benchmark context outlives the workers, so that stats and the PRNG
+    // carry over from one worker to the next
+    bench_thread_context_t self(id);
+    size_t done = 0;     // Operations completed by this slot
+    uint64_t cycles = 0; // Cycles spent by the most recent worker
+    uint64_t ops = 0;    // Operations run by the most recent worker
+    size_t lifetime = cfg->lifetime > 0 ? cfg->lifetime : 1;
+
+    // Each worker runs on its own thread, with its own descriptor
+    auto worker = [&]() {
+      auto me = new THREAD_CONTEXT();
+      ops = 0;
+      uint64_t start = __rdtsc();
+      while (ops < lifetime &&
+             (cfg->timed_mode ? exp.running.load() : done < cfg->interval)) {
+        uint64_t op_start = cfg->fairness ? __rdtsc() : 0;
+        intmap_op<SET, THREAD_CONTEXT, K2V>(set, me, self, cfg);
+        if (cfg->fairness)
+          self.longest = max<uint64_t>(self.longest, __rdtsc() - op_start);
+        ++ops;
+        ++done;
+      }
+      cycles = __rdtsc() - start;
+      delete me;
+      exp.merge_phases();
+    };
+
+    // Synchronize threads and get time
+    exp.sync_before_launch(id, cfg);
+
+    // Run the experiment, one worker at a time
+    bool first = true;
+    uint64_t my_last_cycles = 0, my_last_ops = 0;
+    while (cfg->timed_mode ? exp.running.load() : done < cfg->interval) {
+      thread(worker).join();
+      ++spawned;
+      if (ops == 0)
+        continue;
+      if (first) {
+        first_cycles += cycles;
+        first_ops += ops;
+        first = false;
+      }
+      my_last_cycles = cycles;
+      my_last_ops = ops;
+    }
+    last_cycles += my_last_cycles;
+    last_ops += my_last_ops;
+
+    // arrive at the last barrier, then get the timer again
+    exp.sync_after_launch(id, cfg);
+
+    // merge stats into global
+    exp.merge_stats(id, self);
+  };
+
+  // Launch the slots... this thread won't run the tests
+  exp.track_threads(cfg->nthreads);
+  vector<thread> threads;
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads.emplace_back(task, i);
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads[i].join();
+
+  // Report statistics from the experiment
+  if (cfg->quiet) {
+    exp.report_tput_only();
+    return;
+  }
+  exp.report_csv();
+  std::cout << "(threads, first_lat, last_lat), " << spawned << ", "
+            << (first_ops ? (double)first_cycles / first_ops : 0) << ", "
+            << (last_ops ? (double)last_cycles / last_ops : 0) << ", \n";
+  if (cfg->fairness)
+    exp.report_fairness();
+  if (cfg->verbose)
+    exp.report_verbose();
+}
+
+/// Run integer set tests with processes instead of threads.  The set must live
+/// in memory that is shared among processes.  Each of `cfg->nthreads` worker
+/// processes is forked from this one, calls `attach` to get its own handle to
+/// the shared set, and then runs the same random operations as intmap_test.
+///
+/// The experiment manager lives in an anonymous shared mapping, so that the
+/// workers can use its barriers and its stop flag.  Each worker copies its
+/// benchmark context to a shared array before exiting, and this process merges
+/// them once every worker has finished.
+///
+/// @param SET            The type of the set to test
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int keys to whatever value SET uses
+///
+/// @param cfg    The configuration object
+/// @param attach A function that returns a worker process's handle to the set
+template <class SET, class THREAD_CONTEXT, typename K2V, class F>
+void intmap_proc_test(config_t *cfg, F attach) {
+  // Put the manager and the workers' benchmark contexts in shared memory
+  size_t exp_bytes = (sizeof(experiment_manager_t) + 63) & ~63UL;
+  size_t bytes = exp_bytes + cfg->nthreads * sizeof(bench_thread_context_t);
+  void *mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED)
+    throw "Unable to map memory for worker processes";
+  auto exp = new (mem) experiment_manager_t();
+  auto selves = reinterpret_cast<bench_thread_context_t *>(
+      static_cast<char *>(mem) + exp_bytes);
+
+  // Launch the workers... this process won't run the tests
+  std::vector<pid_t> workers;
+  for (size_t id = 0; id < cfg->nthreads; ++id) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      // Create benchmark and ds-specific contexts for this process
+      SET *set = attach();
+      bench_thread_context_t self(id);
+      auto me = new THREAD_CONTEXT();
+      auto tx = [&]() {
+        intmap_op<SET, THREAD_CONTEXT, K2V>(set, me, self, cfg);
+      };
+
+      // Run the experiment, just like a thread of intmap_test
+      exp->sync_before_launch(id, cfg);
+      exp->run_ops(cfg, self, tx);
+      self.stats[bench_thread_context_t::ABORT] = count_aborts(me);
+      exp->merge_phases();
+      exp->sync_after_launch(id, cfg);
+
+      // Release the descriptor (and its SMR state), then publish stats
+      delete me;
+      new (&selves[id]) bench_thread_context_t(self);
+      _exit(0);
+    }
+    if (pid < 0)
+      throw "Unable to fork worker process";
+    workers.push_back(pid);
+  }
+  for (auto pid : workers) {
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0)
+      throw "A worker process failed";
+  }
+
+  // Merge the workers' statistics, then report them
+  exp->track_threads(cfg->nthreads);
+  for (size_t id = 0; id < cfg->nthreads; ++id)
+    exp->merge_stats(id, selves[id]);
+  exp->report(cfg);
+}
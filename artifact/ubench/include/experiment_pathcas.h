@@ -146,22 +146,17 @@ void intmap_test(SET *set, config_t *cfg) {
     exp.sync_before_launch(id, cfg);
 
     // Run the experiment
-    if (cfg->timed_mode)
-      while (exp.running.load())
-        tx();
-    else
-      for (size_t i = 0; i < cfg->interval; ++i)
-        tx();
+    exp.run_ops(cfg, self, tx);
 
     // arrive at the last barrier, then get the timer again
     exp.sync_after_launch(id, cfg);
 
     // merge stats into global
-    for (size_t i = 0; i < event_types::NUM; ++i)
-      exp.stats[i].fetch_add(self.stats[i]);
+    exp.merge_stats(id, self);
   };
 
   // Launch the threads... this thread won't run the tests
+  exp.track_threads(cfg->nthreads);
   vector<thread> threads;
   for (size_t i = 0; i < cfg->nthreads; i++)
     threads.emplace_back(task, i);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../../ds/include/vacation_query.h"
+#include "experiment.h"
+
+/// Perform one random client request on a travel reservation application, and
+/// count its outcome in the calling thread's stats.  Like the client in STAMP's
+/// vacation, a request is a batch of `cfg->bulk` random queries that runs as
+/// one transaction.  `cfg->lookup` percent of requests make reservations
+/// (counted as lookups), and the rest are split evenly between cancelling a
+/// customer's reservations (counted as removes) and adding or removing item
+/// capacity (counted as modifies).  Customer and item ids are drawn uniformly
+/// from `cfg->key_range`.
+///
+/// @param APP            The type of the application
+/// @param THREAD_CONTEXT The per-thread context used by APP
+///
+/// @param app  The application
+/// @param me   The operation descriptor of the calling thread
+/// @param self The benchmark context of the calling thread
+/// @param cfg  The configuration object
+template <class APP, class THREAD_CONTEXT>
+void vacation_op(APP *app, THREAD_CONTEXT *me, bench_thread_context_t &self,
+                 config_t *cfg) {
+  using event_types = bench_thread_context_t::EVENTS;
+
+  // Generate the request outside of the transaction.  The buffer is reused
+  // by each of the thread's requests, since -K has no upper bound.
+  int num = std::max<size_t>(cfg->bulk, 1);
+  static thread_local std::vector<vacation_query_t> buf;
+  buf.resize(num);
+  vacation_query_t *queries = buf.data();
+  for (int i = 0; i < num; ++i) {
+    queries[i].kind = (vacation_kind_t)(self.mt() % NUM_KINDS);
+    queries[i].id = self.mt() % cfg->key_range;
+    queries[i].add = self.mt() % 2;
+    queries[i].price = (self.mt() % 5) * 10 + 50;
+  }
+  int customer = self.mt() % cfg->key_range;
+  size_t action = self.mt() % 100;
+  size_t cancel = (100 - cfg->lookup) / 2;
+
+  me->op_begin();
+  if (action < cfg->lookup) {
+    if (app->reserve(me, customer, queries, num))
+      ++self.stats[event_types::GET_T];
+    else
+      ++self.stats[event_types::GET_F];
+  } else if (action < cfg->lookup + cancel) {
+    if (app->cancel(me, customer))
+      ++self.stats[event_types::RMV_T];
+    else
+      ++self.stats[event_types::RMV_F];
+  } else {
+    if (app->update(me, queries, num))
+      ++self.stats[event_types::MOD_T];
+    else
+      ++self.stats[event_types::MOD_F];
+  }
+  me->op_end();
+}
+
+/// Run the travel reservation application benchmark
+///
+/// @param APP            The type of the application
+/// @param THREAD_CONTEXT The per-thread context used by APP
+///
+/// @param app The application, already populated
+/// @param cfg The configuration object
+template <class APP, class THREAD_CONTEXT>
+void vacation_test(APP *app, config_t *cfg) {
+  using namespace std;
+
+  // A manager for coordinating threads and collecting stats
+  experiment_manager_t exp;
+
+  // This is the benchmark task that each thread will perform
+  auto task = [&](int id) {
+    // Create thread benchmark and app-specific contexts
+    bench_thread_context_t self(id);
+    auto me = new THREAD_CONTEXT();
+
+    // A lambda that does one client request
+    auto tx = [&]() { vacation_op<APP, THREAD_CONTEXT>(app, me, self, cfg); };
+
+    // Synchronize threads and get time
+    exp.sync_before_launch(id, cfg);
+
+    // Run the experiment
+    exp.run_ops(cfg, self, tx);
+    self.stats[bench_thread_context_t::ABORT] = count_aborts(me);
+    exp.merge_phases();
+
+    // arrive at the last barrier, then get the timer again
+    exp.sync_after_launch(id, cfg);
+
+    // merge stats into global
+    exp.merge_stats(id, self);
+  };
+
+  // Launch the threads... this thread won't run the tests
+  exp.track_threads(cfg->nthreads);
+  vector<thread> threads;
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads.emplace_back(task, i);
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads[i].join();
+
+  // Report statistics from the experiment
+  exp.report(cfg);
+}
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "experiment.h"
+
+/// The operation mix and request distribution of one of the YCSB core
+/// workloads.  The percentages of the five kinds of operation add up to 100.
+struct ycsb_workload_t {
+  /// The ways of choosing the record that an operation uses
+  enum dist_t {
+    UNIFORM, // Every record is equally likely
+    ZIPFIAN, // A few records are popular, and they are scattered across keys
+    LATEST,  // The most recently inserted records are the most popular
+  };
+
+  size_t read;   // % reads of a whole record
+  size_t update; // % writes of one field of a record
+  size_t insert; // % inserts of a new record
+  size_t scan;   // % scans of a short range of records
+  size_t rmw;    // % reads of a whole record, followed by a write of one field
+  dist_t dist;   // How records are chosen
+
+  /// Get the operation mix of one of the core workloads
+  ///
+  /// @param name The workload's letter (A-F)
+  ///
+  /// @return The workload's operation mix and request distribution
+  static ycsb_workload_t get(char name) {
+    switch (name) {
+    case 'A': // Update heavy
+      return {50, 50, 0, 0, 0, ZIPFIAN};
+    case 'B': // Read mostly
+      return {95, 5, 0, 0, 0, ZIPFIAN};
+    case 'C': // Read only
+      return {100, 0, 0, 0, 0, ZIPFIAN};
+    case 'D': // Read latest
+      return {95, 0, 5, 0, 0, LATEST};
+    case 'E': // Short ranges
+      return {0, 0, 5, 95, 0, ZIPFIAN};
+    case 'F': // Read-modify-write
+      return {50, 0, 0, 0, 50, ZIPFIAN};
+    default:
+      throw "Invalid YCSB workload " + std::string(1, name);
+    }
+  }
+};
+
+/// A generator of Zipfian-distributed item numbers in [0, items), using the
+/// method of Gray et al. ("Quickly Generating Billion-Record Synthetic
+/// Databases", SIGMOD 1994), like YCSB does.  Item 0 is the most popular.
+///
+/// NB: Construction computes zeta(items), which takes O(items) time, so a
+///     generator should be constructed once and shared by all threads.
+class zipfian_t {
+  const uint64_t items; // The number of items
+  const double theta;   // The skew.  Larger values make popular items hotter.
+  double zetan;         // zeta(items, theta)
+  double alpha;         // 1 / (1 - theta)
+  double eta;           // A constant of the method, derived from zeta(2)
+
+  /// Compute the sum of 1/i^theta for i in [1, n]
+  static double zeta(uint64_t n, double theta) {
+    double sum = 0;
+    for (uint64_t i = 1; i <= n; ++i)
+      sum += 1 / std::pow((double)i, theta);
+    return sum;
+  }
+
+public:
+  /// Construct a generator
+  ///
+  /// @param items The number of items (at least 2)
+  /// @param theta The skew (YCSB's default is 0.99)
+  zipfian_t(uint64_t items, double theta = 0.99)
+      : items(std::max<uint64_t>(items, 2)), theta(theta) {
+    zetan = zeta(this->items, theta);
+    alpha = 1 / (1 - theta);
+    eta = (1 - std::pow(2.0 / this->items, 1 - theta)) /
+          (1 - zeta(2, theta) / zetan);
+  }
+
+  /// Map a uniform random number to an item
+  ///
+  /// @param u A uniform random number in [0, 1)
+  ///
+  /// @return An item number in [0, items)
+  uint64_t next(double u) const {
+    double uz = u * zetan;
+    if (uz < 1)
+      return 0;
+    if (uz < 1 + std::pow(0.5, theta))
+      return 1;
+    return std::min<uint64_t>(items - 1,
+                              items * std::pow(eta * u - eta + 1, alpha));
+  }
+};
+
+/// ycsb_driver_t runs a YCSB-style workload on any of our maps.  There is a
+/// load phase, which inserts `cfg->key_range` records with keys [0, records),
+/// and a run phase, which performs the configured core workload
+/// (`cfg->workload`) for the configured time or number of operations.  Inserts
+/// during the run phase use new keys, in increasing order.
+///
+/// Our maps store word-sized values, not records, so each record is
+/// represented by a digest of its contents.  Reading a record regenerates its
+/// `cfg->field_count` x `cfg->field_length` bytes from the digest, and writing
+/// a field generates new random bytes for it and folds them into the digest.
+/// This charges operations for (de)serializing records, like a key-value store
+/// would, without requiring the maps to manage variable-sized values.
+///
+/// Updates replace a record's digest with a single-key CAS if the map has
+/// multi_update() (see mk_op_t), and otherwise with a remove() followed by an
+/// insert(), which is not atomic.  Scans use the map's range() if it has one,
+/// and otherwise probe each key in the range.
+///
+/// @param SET            The type of the map
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int to whatever value SET uses
+template <class SET, class THREAD_CONTEXT, class K2V> class ycsb_driver_t {
+  using V = decltype(K2V::convert(0)); // The map's value type
+  using mk_t = mk_op_t<int, V>;        // A single-key CAS, for updates
+  using event_types = bench_thread_context_t::EVENTS;
+
+  SET *set;                   // The map
+  config_t *cfg;              // The configuration object
+  const ycsb_workload_t mix;  // The operation mix
+  const zipfian_t zipf;       // Popularity of records, for ZIPFIAN and LATEST
+  std::atomic<int> records;   // The number of records (and the next key)
+  std::atomic<uint64_t> sink; // Checksums of records read, so reads happen
+
+  /// A 64-bit FNV-1a hash, which YCSB uses to scatter popular items
+  static uint64_t fnv(uint64_t val) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < 8; ++i) {
+      hash ^= val & 0xFF;
+      hash *= 1099511628211ULL;
+      val >>= 8;
+    }
+    return hash;
+  }
+
+  /// Extract the digest of a record from a map value
+  static int digest_of(V val) {
+    if constexpr (std::is_pointer_v<V>)
+      return (int)(uintptr_t)val;
+    else
+      return (int)val;
+  }
+
+  /// Read every field of a record, by regenerating its bytes from its digest
+  ///
+  /// @param digest The record's digest
+  /// @param buf    A buffer with room for a whole record
+  ///
+  /// @return A checksum of the record's bytes
+  uint64_t read_record(int digest, char *buf) {
+    size_t bytes = cfg->field_count * cfg->field_length;
+    uint64_t x = fnv((uint32_t)digest) | 1, sum = 0;
+    for (size_t i = 0; i < bytes; i += sizeof(x)) {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      memcpy(buf + i, &x, std::min(sizeof(x), bytes - i));
+    }
+    for (size_t i = 0; i < bytes; ++i)
+      sum += (unsigned char)buf[i];
+    return sum;
+  }
+
+  /// Write one field of a record with new random bytes
+  ///
+  /// @param digest The record's digest
+  /// @param field  The field to write
+  /// @param buf    A buffer with room for a whole record
+  /// @param mt     The calling thread's PRNG
+  ///
+  /// @return The record's new digest
+  int write_field(int digest, size_t field, char *buf, std::mt19937 &mt) {
+    char *f = buf + field * cfg->field_length;
+    uint64_t hash = fnv(digest ^ field);
+    for (size_t i = 0; i < cfg->field_length; ++i) {
+      f[i] = 'a' + mt() % 26;
+      hash = (hash ^ (unsigned char)f[i]) * 1099511628211ULL;
+    }
+    return (int)(hash ^ (hash >> 32));
+  }
+
+  /// Generate a whole new record
+  ///
+  /// @param buf A buffer with room for a whole record
+  /// @param mt  The calling thread's PRNG
+  ///
+  /// @return The new record's digest
+  int new_record(char *buf, std::mt19937 &mt) {
+    int digest = 0;
+    for (size_t f = 0; f < cfg->field_count; ++f)
+      digest = write_field(digest, f, buf, mt);
+    return digest;
+  }
+
+  /// Choose the key of an existing record, according to the workload's
+  /// request distribution
+  ///
+  /// @param self The benchmark context of the calling thread
+  int choose_key(bench_thread_context_t &self) {
+    int count = records.load(std::memory_order_relaxed);
+    double u = std::uniform_real_distribution<double>(0, 1)(self.mt);
+    switch (mix.dist) {
+    case ycsb_workload_t::UNIFORM:
+      return std::uniform_int_distribution<int>(0, count - 1)(self.mt);
+    case ycsb_workload_t::ZIPFIAN:
+      return fnv(zipf.next(u)) % count;
+    default: // LATEST
+      return std::max<int64_t>(0, count - 1 - (int64_t)zipf.next(u));
+    }
+  }
+
+  /// Overwrite one field of a record, optionally reading the whole record
+  /// first.  The new value replaces the old one atomically, with a single-key
+  /// CAS through multi_update(), or else with the map's update().
+  ///
+  /// NB: A map with neither cannot run YCSB, since a remove followed by an
+  ///     insert would make the record briefly disappear.
+  ///
+  /// @param me         The operation descriptor of the calling thread
+  /// @param self       The benchmark context of the calling thread
+  /// @param key        The record's key
+  /// @param buf        A buffer with room for a whole record
+  /// @param read_first True to read the record before writing it
+  ///
+  /// @return True if the record was found and updated
+  bool update(THREAD_CONTEXT *me, bench_thread_context_t &self, int key,
+              char *buf, bool read_first) {
+    size_t field = self.mt() % cfg->field_count;
+    while (true) {
+      V val;
+      if (!set->get(me, key, val))
+        return false;
+      if (read_first)
+        sink.fetch_add(read_record(digest_of(val), buf),
+                       std::memory_order_relaxed);
+      int digest = write_field(digest_of(val), field, buf, self.mt);
+      V new_val = K2V::convert(digest);
+      if constexpr (requires(mk_t *ops) { set->multi_update(me, ops, 1); }) {
+        mk_t op{mk_t::CAS, key, new_val, val};
+        if (set->multi_update(me, &op, 1))
+          return true;
+        // Someone else changed or removed the record, so try again
+      } else {
+        static_assert(requires { set->update(me, key, new_val); },
+                      "YCSB requires a map with multi_update() or update()");
+        return set->update(me, key, new_val);
+      }
+    }
+  }
+
+  /// Read every record in a range of keys
+  ///
+  /// @param me  The operation descriptor of the calling thread
+  /// @param lo  The smallest key in the range
+  /// @param hi  The largest key in the range
+  /// @param buf A buffer with room for a whole record
+  ///
+  /// @return The number of records found
+  size_t scan(THREAD_CONTEXT *me, int lo, int hi, char *buf) {
+    uint64_t sum = 0;
+    size_t found = 0;
+    auto visit = [&](auto &, auto &val) {
+      sum += read_record(digest_of(val), buf);
+    };
+    if constexpr (requires { set->range(me, lo, hi, visit); }) {
+      found = set->range(me, lo, hi, visit);
+    } else {
+      for (int k = lo; k <= hi; ++k) {
+        V val;
+        if (set->get(me, k, val)) {
+          visit(k, val);
+          ++found;
+        }
+      }
+    }
+    sink.fetch_add(sum, std::memory_order_relaxed);
+    return found;
+  }
+
+public:
+  /// Construct a driver for the configured workload
+  ///
+  /// @param set The map, which should be empty
+  /// @param cfg The configuration object
+  ycsb_driver_t(SET *set, config_t *cfg)
+      : set(set), cfg(cfg), mix(ycsb_workload_t::get(cfg->workload)),
+        zipf(cfg->key_range), records(cfg->key_range), sink(0) {}
+
+  /// Load phase: insert records [0, cfg->key_range), using `cfg->wthreads`
+  /// threads.  Like fill_even, each thread inserts its share of the keys in
+  /// decreasing order, or in random order if `cfg->prefill_rand` is set.
+  ///
+  /// @return The time the load took, in seconds
+  double load() {
+    using namespace std::chrono;
+    auto task = [&](int tid, int lo, int hi) {
+      auto me = new THREAD_CONTEXT();
+      std::mt19937 mt(tid);
+      std::vector<char> buf(cfg->field_count * cfg->field_length);
+      std::vector<int> keys;
+      for (int k = hi - 1; k >= lo; --k)
+        keys.push_back(k);
+      if (cfg->prefill_rand)
+        std::shuffle(keys.begin(), keys.end(), mt);
+      for (auto k : keys) {
+        me->op_begin();
+        auto val = K2V::convert(new_record(buf.data(), mt));
+        set->insert(me, k, val);
+        me->op_end();
+      }
+    };
+    auto start = high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    int share = cfg->key_range / cfg->wthreads;
+    for (size_t i = 0; i < cfg->wthreads; ++i) {
+      int hi = i == cfg->wthreads - 1 ? cfg->key_range : (i + 1) * share;
+      threads.emplace_back(task, i, i * share, hi);
+    }
+    for (auto &t : threads)
+      t.join();
+    return duration<double>(high_resolution_clock::now() - start).count();
+  }
+
+  /// Perform one operation of the workload, and count its outcome in the
+  /// calling thread's stats.  Reads count as lookups, updates and
+  /// read-modify-writes as modifies, inserts as inserts, and scans as ranges.
+  ///
+  /// @param me   The operation descriptor of the calling thread
+  /// @param self The benchmark context of the calling thread
+  /// @param buf  A buffer with room for a whole record
+  void op(THREAD_CONTEXT *me, bench_thread_context_t &self, char *buf) {
+    size_t action = self.mt() % 100;
+    me->op_begin();
+    if (action < mix.read) {
+      V val;
+      if (set->get(me, choose_key(self), val)) {
+        sink.fetch_add(read_record(digest_of(val), buf),
+                       std::memory_order_relaxed);
+        ++self.stats[event_types::GET_T];
+      } else {
+        ++self.stats[event_types::GET_F];
+      }
+    } else if (action < mix.read + mix.update) {
+      if (update(me, self, choose_key(self), buf, false))
+        ++self.stats[event_types::MOD_T];
+      else
+        ++self.stats[event_types::MOD_F];
+    } else if (action < mix.read + mix.update + mix.insert) {
+      int key = records.fetch_add(1, std::memory_order_relaxed);
+      auto val = K2V::convert(new_record(buf, self.mt));
+      if (set->insert(me, key, val))
+        ++self.stats[event_types::INS_T];
+      else
+        ++self.stats[event_types::INS_F];
+    } else if (action < mix.read + mix.update + mix.insert + mix.scan) {
+      int lo = choose_key(self);
+      int len = 1 + self.mt() % std::max<size_t>(cfg->scan_length, 1);
+      if (scan(me, lo, lo + len - 1, buf) > 0)
+        ++self.stats[event_types::RNG_T];
+      else
+        ++self.stats[event_types::RNG_F];
+    } else {
+      if (update(me, self, choose_key(self), buf, true))
+        ++self.stats[event_types::MOD_T];
+      else
+        ++self.stats[event_types::MOD_F];
+    }
+    me->op_end();
+  }
+};
+
+/// Run a YCSB-style benchmark on a map: load it, then run the configured core
+/// workload with `cfg->nthreads` threads.  The load time is reported as part
+/// of the CSV line, before the run phase's statistics.
+///
+/// @param SET            The type of the map
+/// @param THREAD_CONTEXT The per-thread context used by SET
+/// @param K2V            A converter from int to whatever value SET uses
+///
+/// @param set The map, which should be empty
+/// @param cfg The configuration object
+template <class SET, class THREAD_CONTEXT, typename K2V>
+void ycsb_test(SET *set, config_t *cfg) {
+  using namespace std;
+
+  // Load phase
+  ycsb_driver_t<SET, THREAD_CONTEXT, K2V> ycsb(set, cfg);
+  double load_time = ycsb.load();
+
+  // A manager for coordinating threads and collecting stats
+  experiment_manager_t exp;
+
+  // This is the benchmark task that each thread will perform
+  auto task = [&](int id) {
+    // Create thread benchmark and ds-specific contexts
+    bench_thread_context_t self(id);
+    auto me = new THREAD_CONTEXT();
+    vector<char> buf(cfg->field_count * cfg->field_length);
+
+    // A lambda that does one operation of the workload
+    auto tx = [&]() { ycsb.op(me, self, buf.data()); };
+
+    // Synchronize threads and get time
+    exp.sync_before_launch(id, cfg);
+
+    // Run the experiment
+    exp.run_ops(cfg, self, tx);
+    self.stats[bench_thread_context_t::ABORT] = count_aborts(me);
+    exp.merge_phases();
+
+    // arrive at the last barrier, then get the timer again
+    exp.sync_after_launch(id, cfg);
+
+    // merge stats into global
+    exp.merge_stats(id, self);
+  };
+
+  // Launch the threads... this thread won't run the tests
+  exp.track_threads(cfg->nthreads);
+  vector<thread> threads;
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads.emplace_back(task, i);
+  for (size_t i = 0; i < cfg->nthreads; i++)
+    threads[i].join();
+
+  // Report statistics from the experiment
+  if (!cfg->quiet)
+    cout << "(load_time), " << load_time << ", ";
+  exp.report(cfg);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+/// A standardized main() function for use with our thread churn benchmarks.  It
+/// is the same as launch.h, except that the test continuously creates and
+/// destroys threads.
+int main(int argc, char **argv) {
+  // Parse and print the command-line options.  If it throws, terminate
+  config_t *cfg = new config_t(argc, argv);
+  cfg->report();
+
+  // Create a map and fill it
+  auto me = new descriptor();
+  auto ds = new map(me, cfg);
+  fill_even<map, descriptor, K2VAL>(ds, cfg);
+
+  // Launch the test
+  churn_test<map, descriptor, K2VAL>(ds, cfg);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+/// A main() function for integer map benchmarks that run in worker processes
+/// instead of threads.  The map is created and filled in a shared memory
+/// region, and then each worker attaches the region (at its own address) and
+/// runs the test against the same map.
+int main(int argc, char **argv) {
+  // Parse and print the command-line options.  If it throws, terminate
+  config_t *cfg = new config_t(argc, argv);
+  cfg->report();
+
+  // Create a region that is big enough for the buckets, the prefill, and the
+  // nodes that are awaiting reclamation.  Memory is committed lazily, so it's
+  // fine to be generous.
+  std::string name = "/exotm_ubench." + std::to_string(getpid());
+  shm_region_t::create(name, (cfg->buckets + cfg->key_range * 4) * 64 +
+                                 cfg->nthreads * (1 << 24) + (1 << 26));
+
+  // Create the map and fill it
+  {
+    auto me = new descriptor();
+    auto ds = new map(me, cfg);
+    fill_even<map, descriptor, K2VAL>(ds, cfg);
+    delete me;
+  }
+
+  // Launch the test.  Each worker re-maps the region, to show that the map
+  // doesn't depend on where the region is mapped.
+  intmap_proc_test<map, descriptor, K2VAL>(cfg, [&]() {
+    shm_region_t::attach(name);
+    auto me = new descriptor();
+    auto ds = new map(me, cfg);
+    delete me;
+    return ds;
+  });
+  shm_region_t::unlink(name);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+/// A standardized main() function for use with our travel reservation
+/// application benchmarks.  It is the same as launch.h, except that it runs an
+/// application instead of a map, and the application populates itself.
+int main(int argc, char **argv) {
+  // Parse and print the command-line options.  If it throws, terminate
+  config_t *cfg = new config_t(argc, argv);
+  cfg->report();
+
+  // Create and populate the application
+  auto me = new descriptor();
+  auto ds = new app(me, cfg);
+
+  // Launch the test
+  vacation_test<app, descriptor>(ds, cfg);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/// A standardized main() function for use with our YCSB benchmarks.  It is the
+/// same as launch.h, except that the map starts empty, and ycsb_test loads it.
+int main(int argc, char **argv) {
+  // Parse and print the command-line options.  If it throws, terminate
+  config_t *cfg = new config_t(argc, argv);
+  cfg->report();
+
+  // Create an empty map
+  auto me = new descriptor();
+  auto ds = new map(me, cfg);
+
+  // Load it and launch the test
+  ycsb_test<map, descriptor, K2VAL>(ds, cfg);
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <signal.h>
+#include <vector>
+#include <x86intrin.h>
 
+#include "../../policies/include/phases.h"
 #include "bench_thread_context.h"
 
 /// experiment_manager keeps track of all data that we measure during an
@@ -18,6 +23,17 @@ struct experiment_manager_t {
   std::atomic<uint64_t> stats[event_types::NUM]; // global stat counters
   std::atomic<bool> running; // flag for stopping timed experiments
 
+  /// Cycles spent in each phase of the operations, summed over all threads
+  /// (only measured when built with -DEXOTM_PHASES)
+  std::atomic<uint64_t> phases[phase_timer_t::NUM_PHASES];
+
+  /// Operations completed by each thread, for measuring fairness
+  std::vector<uint64_t> thread_ops;
+
+  /// Cycles taken by each thread's slowest operation (only measured when
+  /// config_t::fairness is set)
+  std::vector<uint64_t> thread_longest;
+
   /// Static reference to singleton instance of this struct... we need this for
   /// the experiment timer
   static experiment_manager_t *instance;
@@ -30,6 +46,78 @@ struct experiment_manager_t {
       barriers[i] = 0;
     for (int i = 0; i < event_types::NUM; ++i)
       stats[i] = 0;
+    for (int i = 0; i < phase_timer_t::NUM_PHASES; ++i)
+      phases[i] = 0;
+  }
+
+  /// Prepare to collect per-thread statistics for `n` threads.  This must be
+  /// called before any thread calls merge_stats().
+  void track_threads(size_t n) {
+    thread_ops.assign(n, 0);
+    thread_longest.assign(n, 0);
+  }
+
+  /// Run a thread's share of the experiment, by calling `op` until time runs
+  /// out, or until the thread has done `cfg->interval` operations.  If
+  /// `cfg->fairness` is set, each operation is also timed, so that the slowest
+  /// one can be reported.  Otherwise, we avoid the cost of reading the clock.
+  ///
+  /// @param cfg  The configuration object
+  /// @param self The benchmark context of the calling thread
+  /// @param op   A function that performs one operation
+  template <class F>
+  void run_ops(config_t *cfg, bench_thread_context_t &self, F op) {
+    auto timed_op = [&]() {
+      uint64_t start = __rdtsc();
+      op();
+      self.longest = std::max<uint64_t>(self.longest, __rdtsc() - start);
+    };
+    auto loop = [&](auto f) {
+      if (cfg->timed_mode)
+        while (running.load())
+          f();
+      else
+        for (size_t i = 0; i < cfg->interval; ++i)
+          f();
+    };
+    if (cfg->fairness)
+      loop(timed_op);
+    else
+      loop(op);
+  }
+
+  /// Merge a thread's counters into the global counters, and record its
+  /// per-thread statistics
+  ///
+  /// @param id   The thread's id
+  /// @param self The benchmark context of the thread
+  void merge_stats(size_t id, const bench_thread_context_t &self) {
+    for (size_t i = 0; i < event_types::NUM; ++i)
+      stats[i].fetch_add(self.stats[i]);
+    if (id < thread_ops.size()) {
+      thread_ops[id] += self.count_operations();
+      thread_longest[id] = std::max(thread_longest[id], self.longest);
+    }
+  }
+
+  /// Merge the calling thread's phase cycle counts into the global counts.
+  /// This must be called by the thread itself, since the counts are
+  /// thread-local.
+  void merge_phases() {
+    for (size_t i = 0; i < phase_timer_t::NUM_PHASES; ++i)
+      phases[i].fetch_add(phase_timer_t::cycles[i]);
+  }
+
+  /// Compute Jain's fairness index over the per-thread operation counts.  It
+  /// is 1 when every thread completed the same number of operations, and 1/n
+  /// when a single thread did all of the work.
+  double jain_index() {
+    double sum = 0, sum_sq = 0;
+    for (auto o : thread_ops) {
+      sum += o;
+      sum_sq += (double)o * o;
+    }
+    return sum_sq == 0 ? 1 : (sum * sum) / (thread_ops.size() * sum_sq);
   }
 
   /// Report the most essential configuration settings and statistics that we
@@ -37,11 +125,52 @@ struct experiment_manager_t {
   void report_csv() {
     using namespace std::chrono;
 
-    // Report throughput, execution time, and operations completed
+    // Report throughput, execution time, operations completed, fairness, and
+    // aborts
     uint64_t ops = count_operations();
     auto dur = duration_cast<duration<double>>(end_time - start_time).count();
-    std::cout << "(tput, time, ops), " << ops / dur << ", " << dur << ", "
-              << ops << ", ";
+    std::cout << "(tput, time, ops, jain, aborts), " << ops / dur << ", " << dur
+              << ", " << ops << ", " << jain_index() << ", "
+              << stats[event_types::ABORT] << ", ";
+  }
+
+  /// Report each thread's operation count and slowest operation, and the
+  /// spread of operation counts across threads, in a human-readable form
+  void report_fairness() {
+    if (thread_ops.empty())
+      return;
+    uint64_t lo = *std::min_element(thread_ops.begin(), thread_ops.end());
+    uint64_t hi = *std::max_element(thread_ops.begin(), thread_ops.end());
+    double mean = 0, var = 0;
+    for (auto o : thread_ops)
+      mean += o;
+    mean /= thread_ops.size();
+    for (auto o : thread_ops)
+      var += (o - mean) * (o - mean);
+    var /= thread_ops.size();
+    std::cout << "Per-thread operations (min, max, mean, stddev): " << lo
+              << ", " << hi << ", " << mean << ", " << std::sqrt(var) << "\n"
+              << "Jain fairness index: " << jain_index() << "\n";
+    for (size_t i = 0; i < thread_ops.size(); ++i)
+      std::cout << "  thread " << i << " : " << thread_ops[i]
+                << " ops, longest op " << thread_longest[i] << " cycles\n";
+  }
+
+  /// Report the average cycles per operation spent in each phase.  "other" is
+  /// the part of an operation that no phase accounts for (e.g., code between
+  /// steps, or code in policies that are not instrumented).
+  void report_phases() {
+    uint64_t ops = count_operations();
+    if (!phase_timer_t::enabled() || ops == 0)
+      return;
+    uint64_t other = phases[phase_timer_t::OP];
+    std::cout << "Cycles per operation by phase:";
+    for (size_t i = 0; i < phase_timer_t::NUM_PHASES; ++i) {
+      std::cout << " " << phase_timer_t::NAMES[i] << " " << phases[i] / ops;
+      if (i != phase_timer_t::OP)
+        other -= std::min<uint64_t>(other, phases[i]);
+    }
+    std::cout << " other " << other / ops << "\n";
   }
 
   /// Only report throughput, nothing else
@@ -68,7 +197,7 @@ struct experiment_manager_t {
     std::string titles[] = {"lookup hit",  "lookup miss", "insert hit",
                             "insert miss", "remove hit",  "remove miss",
                             "modify hit",  "modify miss", "range hit",
-                            "range miss",  "transactions"};
+                            "range miss",  "transactions", "aborts"};
     for (size_t i = 0; i < event_types::NUM; ++i)
       std::cout << "  " << titles[i] << " : " << stats[i] << "\n";
   }
@@ -81,6 +210,10 @@ struct experiment_manager_t {
     }
     report_csv();
     std::cout << "\n";
+    if (cfg->fairness) {
+      report_fairness();
+    }
+    report_phases();
     if (cfg->verbose) {
       report_verbose();
     }
@@ -135,7 +268,8 @@ struct experiment_manager_t {
   uint64_t count_operations() {
     return stats[event_types::GET_T] + stats[event_types::GET_F] +
            stats[event_types::INS_T] + stats[event_types::INS_F] +
-           stats[event_types::RMV_T] + stats[event_types::RMV_F];
+           stats[event_types::RMV_T] + stats[event_types::RMV_F] +
+           stats[event_types::MOD_T] + stats[event_types::MOD_F];
   }
 };
 
@@ -0,0 +1,309 @@
+/// A microbenchmark for the exoTM mechanism and timestamp_smr_t.  It times
+/// each primitive in isolation (ro_begin/ro_end, check_orec,
+/// acquire_consistent, acquire_aggressive, wo_end and unwind with N held
+/// orecs, and SMR enter/exit), so that changes to the mechanism can be
+/// evaluated without the noise of a data structure.
+///
+/// Each primitive runs at 1, 2, 4, ... threads, up to the maximum, with every
+/// thread running the same primitive in a loop.  Primitives that touch orecs
+/// are run with three placements of each thread's orecs:
+/// - same-orec: all threads use the same orecs
+/// - same-line: each thread uses its own orecs, but they share cache lines
+///   with other threads' orecs (up to 4 threads per line; beyond that, threads
+///   share orecs as well)
+/// - disjoint:  each thread's orecs are on lines of their own
+///
+/// Only the primitive itself is timed, with fenced rdtsc reads around it, and
+/// the cost of an empty timed region is subtracted.  The result is the average
+/// cycles per call.  `fail_pct` is the percent of attempts where the
+/// primitive (or, for wo_end and unwind, acquiring the orecs to release)
+/// failed because of another thread.  In "check_orec+writer", odd threads
+/// repeatedly acquire and release the orecs that even threads check, and only
+/// the even threads are timed.
+///
+/// Usage: exotm.exe [calls per thread] [max threads]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <x86intrin.h>
+
+#include "../../policies/exoTM/exotm.h"
+#include "../../policies/include/timestamp_smr.h"
+
+using orec_t = exotm_t::orec_t;
+
+/// The most threads that can be run
+static const int MAX_THREADS = 64;
+
+/// The most orecs that one call to wo_end() or unwind() releases
+static const int MAX_LOCKS = 64;
+
+/// The number of orecs that fit in a cache line
+static const int PER_LINE = 64 / sizeof(orec_t);
+
+/// Ways of placing each thread's orecs relative to other threads' orecs
+enum placement_t { SAME_OREC, SAME_LINE, DISJOINT, NUM_PLACEMENTS };
+
+/// The names of the placements, for reporting
+static const char *PLACEMENT_NAMES[] = {"same-orec", "same-line", "disjoint"};
+
+/// A cache line of orecs
+struct alignas(64) line_t {
+  orec_t orecs[PER_LINE];
+};
+
+/// The orecs used by all experiments
+static line_t lines[MAX_THREADS * MAX_LOCKS];
+
+/// The global state for timestamp_smr_t
+static timestamp_smr_t::global_t smr_globals;
+
+/// Find the orec that a thread uses for its ith lock
+///
+/// @param p   The placement
+/// @param tid The thread's id
+/// @param i   Which of the thread's orecs to find
+///
+/// @return The orec
+static orec_t *get_orec(placement_t p, int tid, int i) {
+  switch (p) {
+  case SAME_OREC:
+    return &lines[i].orecs[0];
+  case SAME_LINE:
+    return &lines[i].orecs[tid % PER_LINE];
+  default:
+    return &lines[tid * MAX_LOCKS + i].orecs[0];
+  }
+}
+
+/// Read the cycle counter, without letting anything move across the read
+static inline uint64_t tick() {
+  _mm_lfence();
+  uint64_t t = __rdtsc();
+  _mm_lfence();
+  return t;
+}
+
+/// A thread's state while it runs a primitive
+struct context_t {
+  exotm_t exo;              // The thread's exoTM context
+  timestamp_smr_t smr;      // The thread's SMR context
+  orec_t *orecs[MAX_LOCKS]; // The thread's orecs
+  uint64_t cycles = 0;      // Cycles spent in timed calls
+  uint64_t samples = 0;     // Number of timed calls
+  uint64_t fails = 0;       // Number of attempts that failed
+  uint64_t sink = 0;        // Keeps results from being optimized away
+
+  /// Construct a thread's contexts
+  context_t() : smr(smr_globals) {}
+
+  /// Time one call to a primitive
+  ///
+  /// @param f The call to time
+  ///
+  /// @return f's result
+  template <class F> auto timed(F f) {
+    uint64_t start = tick();
+    auto res = f();
+    cycles += tick() - start;
+    ++samples;
+    return res;
+  }
+
+  /// Acquire the first `n` orecs, in preparation for releasing them
+  ///
+  /// @param n The number of orecs to acquire
+  ///
+  /// @return true if all were acquired.  On failure, the fail is counted and
+  ///         the transaction is already over.
+  bool acquire_n(int n) {
+    exo.wo_begin();
+    for (int i = 0; i < n; ++i) {
+      if (!exo.acquire_aggressive(orecs[i])) {
+        exo.unwind();
+        exo.wo_end();
+        ++fails;
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/// A primitive to measure
+struct bench_t {
+  std::string name;                   // The primitive's name
+  int locks;                          // The number of orecs each thread uses
+  bool uses_orecs;                    // Does placement matter?
+  bool writers;                       // Are odd threads untimed writers?
+  std::function<void(context_t &)> f; // One timed attempt
+};
+
+/// The primitives to measure
+static std::vector<bench_t> benches() {
+  // check_orec is timed both alone and with concurrent writers
+  auto check = [](context_t &c) {
+    c.exo.ro_begin();
+    auto v = c.timed([&] { return c.exo.check_orec(c.orecs[0]); });
+    c.exo.ro_end();
+    c.fails += v == exotm_t::END_OF_TIME;
+    c.sink += v;
+  };
+  std::vector<bench_t> res = {
+      {"ro_begin+ro_end", 0, false, false,
+       [](context_t &c) {
+         c.timed([&] {
+           c.exo.ro_begin();
+           c.exo.ro_end();
+           return 0;
+         });
+       }},
+      {"check_orec", 1, true, false, check},
+      {"check_orec+writer", 1, true, true, check},
+      {"acquire_consistent", 1, true, false,
+       [](context_t &c) {
+         c.exo.wo_begin();
+         bool ok =
+             c.timed([&] { return c.exo.acquire_consistent(c.orecs[0]); });
+         c.exo.wo_end();
+         c.fails += !ok;
+       }},
+      {"acquire_aggressive", 1, true, false,
+       [](context_t &c) {
+         c.exo.wo_begin();
+         bool ok =
+             c.timed([&] { return c.exo.acquire_aggressive(c.orecs[0]); });
+         c.exo.wo_end();
+         c.fails += !ok;
+       }},
+      {"smr enter+exit", 0, false, false,
+       [](context_t &c) {
+         c.timed([&] {
+           c.smr.enter();
+           c.smr.exit(smr_globals);
+           return 0;
+         });
+       }},
+  };
+  for (int n : {1, 8, 64}) {
+    res.push_back({"wo_end/" + std::to_string(n), n, true, false,
+                   [n](context_t &c) {
+                     if (c.acquire_n(n))
+                       c.timed([&] {
+                         c.exo.wo_end();
+                         return 0;
+                       });
+                   }});
+    res.push_back({"unwind/" + std::to_string(n), n, true, false,
+                   [n](context_t &c) {
+                     if (!c.acquire_n(n))
+                       return;
+                     c.timed([&] {
+                       c.exo.unwind();
+                       return 0;
+                     });
+                     c.exo.wo_end();
+                   }});
+  }
+  return res;
+}
+
+/// The totals of one experiment
+struct result_t {
+  uint64_t cycles = 0;   // Cycles spent in timed calls
+  uint64_t samples = 0;  // Number of timed calls
+  uint64_t attempts = 0; // Number of attempts by timed threads
+  uint64_t fails = 0;    // Number of failed attempts
+};
+
+/// Run one primitive on `threads` threads
+///
+/// @param b       The primitive
+/// @param p       The placement of the threads' orecs
+/// @param threads The number of threads
+/// @param calls   The number of attempts per thread
+///
+/// @return The totals over all timed threads
+static result_t run(const bench_t &b, placement_t p, int threads,
+                    uint64_t calls) {
+  std::atomic<int> ready(0);
+  std::atomic<uint64_t> cycles(0), samples(0), attempts(0), fails(0);
+  std::vector<std::thread> pool;
+  for (int id = 0; id < threads; ++id) {
+    pool.emplace_back([&, id]() {
+      context_t c;
+      for (int i = 0; i < b.locks; ++i)
+        c.orecs[i] = get_orec(p, id, i);
+      bool writer = b.writers && id % 2 == 1;
+      // Start together, so that the threads contend
+      ready.fetch_add(1);
+      while (ready.load() < threads)
+        std::this_thread::yield();
+      for (uint64_t i = 0; i < calls; ++i) {
+        if (writer) {
+          c.exo.wo_begin();
+          c.exo.acquire_aggressive(c.orecs[0]);
+          c.exo.wo_end();
+        } else {
+          b.f(c);
+        }
+      }
+      if (!writer) {
+        cycles += c.cycles;
+        samples += c.samples;
+        attempts += calls;
+        fails += c.fails;
+      }
+      if (c.sink == 1)
+        printf(" ");
+    });
+  }
+  for (auto &t : pool)
+    t.join();
+  return {cycles, samples, attempts, fails};
+}
+
+int main(int argc, char **argv) {
+  uint64_t calls = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2])
+                             : (int)std::thread::hardware_concurrency();
+  max_threads = std::max(1, std::min(max_threads, MAX_THREADS));
+
+  // Measure the cost of an empty timed region, so it can be subtracted
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < calls; ++i) {
+    uint64_t t = tick();
+    sum += tick() - t;
+  }
+  double overhead = (double)sum / calls;
+  printf("# timer overhead: %.1f cycles (subtracted)\n", overhead);
+
+  std::vector<int> counts;
+  for (int t = 1; t < max_threads; t *= 2)
+    counts.push_back(t);
+  counts.push_back(max_threads);
+
+  printf("primitive, placement, threads, cycles, fail_pct\n");
+  for (auto &b : benches()) {
+    for (int p = 0; p < NUM_PLACEMENTS; ++p) {
+      if (!b.uses_orecs && p != DISJOINT)
+        continue;
+      for (int t : counts) {
+        if (b.writers && t < 2)
+          continue;
+        auto r = run(b, (placement_t)p, t, calls);
+        double cyc = r.samples ? (double)r.cycles / r.samples - overhead : 0;
+        printf("%s, %s, %d, %.1f, %.2f\n", b.name.c_str(),
+               b.uses_orecs ? PLACEMENT_NAMES[p] : "-", t, std::max(0.0, cyc),
+               100.0 * r.fails / r.attempts);
+        fflush(stdout);
+      }
+    }
+  }
+}
@@ -0,0 +1,59 @@
+/// A microbenchmark for redolog_nocast_t.  For each write-set size, it runs
+/// many "transactions" that each write that many distinct chunks, read them all
+/// back, and clear the log, and it reports the average time per transaction.
+/// Each size is measured with the default small-log fast path, and with a log
+/// that always uses its hash index, so the benefit (and the crossover point)
+/// is visible.
+///
+/// Usage: redolog.exe [transactions per size]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../policies/include/redolog_nocast.h"
+
+/// Run `txns` transactions of `size` writes each against `log`, and return the
+/// average nanoseconds per transaction
+///
+/// @param log  The redo log to use
+/// @param data The memory that the transactions "write"
+/// @param size The number of chunks each transaction writes
+/// @param txns The number of transactions to run
+///
+/// @return The average time per transaction, in nanoseconds
+template <class LOG>
+double run(LOG &log, uint64_t *data, int size, uint64_t txns) {
+  // Each write goes to a different 32-byte chunk
+  const int STRIDE = 4;
+  uint64_t sum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (uint64_t t = 0; t < txns; ++t) {
+    for (int i = 0; i < size; ++i)
+      log.insert(&data[i * STRIDE], t + i);
+    for (int i = 0; i < size; ++i) {
+      uint64_t v = 0;
+      log.get(&data[i * STRIDE], v);
+      sum += v;
+    }
+    log.clear();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  // Keep the reads from being optimized away
+  if (sum == 1)
+    printf(" ");
+  return std::chrono::duration<double, std::nano>(end - start).count() / txns;
+}
+
+int main(int argc, char **argv) {
+  uint64_t txns = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+  static uint64_t data[64 * 4] __attribute__((aligned(32)));
+  redolog_nocast_t<32> fast;
+  redolog_nocast_t<32, 0> hashed;
+  printf("writes, fast_ns, hashed_ns\n");
+  for (int size : {1, 2, 4, 8, 12, 16, 32, 64}) {
+    double f = run(fast, data, size, txns);
+    double h = run(hashed, data, size, txns);
+    printf("%d, %.1f, %.1f\n", size, f, h);
+  }
+}
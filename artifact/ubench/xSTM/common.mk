@@ -1,5 +1,5 @@
 # Data structures that we want to test
-DS = ibst_omap
+DS = ibst_omap ibst_omap_churn vacation
 
 # Path to the xSTM plugin and STM libraries
 TM_ROOT = ../../policies/xSTM
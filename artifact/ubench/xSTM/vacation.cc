@@ -0,0 +1,10 @@
+#include "../../ds/xSTM/vacation.h"
+#include "../../policies/baseline/thread.h"
+#include "../include/experiment_vacation.h"
+
+using descriptor = thread_t;
+using app = vacation_t<descriptor>;
+
+#include "../include/launch_vacation.h"
+
+THREAD_T_GLOBALS_INITIALIZER;